@@ -225,12 +225,12 @@ bool Analysis::hasSPC() const{
     return false;
 }
 
-bool Analysis::validate() const {
+bool Analysis::validate(ostream& diagnostics) const {
     bool result = true;
     for (auto &constraintSetReference : this->constraintSet_references) {
         if (model.find(*constraintSetReference) == nullptr) {
             if (model.configuration.logLevel >= LogLevel::INFO) {
-                cout << "Missing constraintset reference:" << *constraintSetReference << endl;
+                diagnostics << "Missing constraintset reference:" << *constraintSetReference << endl;
             }
             result = false;
         }
@@ -238,7 +238,7 @@ bool Analysis::validate() const {
     for (auto &loadSetReference : this->loadSet_references) {
         if (model.find(*loadSetReference) == nullptr) {
             if (model.configuration.logLevel >= LogLevel::INFO) {
-                cout << "Missing loadset reference:" << *loadSetReference << endl;
+                diagnostics << "Missing loadset reference:" << *loadSetReference << endl;
             }
             result = false;
         }
@@ -304,6 +304,10 @@ void Analysis::addBoundaryDOFS(int nodePosition, const DOFS dofs) {
     boundaryDOFSByNodePosition[nodePosition] = DOFS(boundaryDOFSByNodePosition[nodePosition]) + dofs;
 }
 
+void Analysis::clearBoundaryDOFS() {
+    boundaryDOFSByNodePosition.clear();
+}
+
 const DOFS Analysis::findBoundaryDOFS(int nodePosition) const {
     const auto& entry = boundaryDOFSByNodePosition.find(nodePosition);
     if (entry == boundaryDOFSByNodePosition.end()) {
@@ -344,8 +348,8 @@ shared_ptr<Analysis> NonLinearMecaStat::clone() const {
     return make_shared<NonLinearMecaStat>(*this);
 }
 
-bool NonLinearMecaStat::validate() const {
-    return Analysis::validate();
+bool NonLinearMecaStat::validate(ostream& diagnostics) const {
+    return Analysis::validate(diagnostics);
 }
 
 LinearModal::LinearModal(Model& model, const int frequency_band_original_id,
@@ -362,11 +366,11 @@ shared_ptr<Analysis> LinearModal::clone() const {
     return make_shared<LinearModal>(*this);
 }
 
-bool LinearModal::validate() const {
-    bool isValid = Analysis::validate();
+bool LinearModal::validate(ostream& diagnostics) const {
+    bool isValid = Analysis::validate(diagnostics);
     if (!getFrequencySearch()) {
         if (model.configuration.logLevel >= LogLevel::INFO) {
-            cout << "Modal analysis is not valid: cannot find frenquency search:" << frequencySearchRef << endl;
+            diagnostics << "Modal analysis is not valid: cannot find frenquency search:" << frequencySearchRef << endl;
         }
         isValid = false;
     }
@@ -394,11 +398,11 @@ shared_ptr<Analysis> LinearDynaModalFreq::clone() const {
     return make_shared<LinearDynaModalFreq>(*this);
 }
 
-bool LinearDynaModalFreq::validate() const {
-    bool isValid = Analysis::validate();
+bool LinearDynaModalFreq::validate(ostream& diagnostics) const {
+    bool isValid = Analysis::validate(diagnostics);
     if (getExcitationFrequencies() == nullptr) {
         if (model.configuration.logLevel >= LogLevel::INFO) {
-            cout << "Modal analysis is not valid: cannot find frenquency excitation:" << frequencyExcitationRef << endl;
+            diagnostics << "Modal analysis is not valid: cannot find frenquency excitation:" << frequencyExcitationRef << endl;
         }
         isValid = false;
     }
@@ -421,11 +425,11 @@ shared_ptr<Analysis> LinearDynaDirectFreq::clone() const {
     return make_shared<LinearDynaDirectFreq>(*this);
 }
 
-bool LinearDynaDirectFreq::validate() const {
-    bool isValid = Analysis::validate();
+bool LinearDynaDirectFreq::validate(ostream& diagnostics) const {
+    bool isValid = Analysis::validate(diagnostics);
     if (getExcitationFrequencies() == nullptr) {
         if (model.configuration.logLevel >= LogLevel::INFO) {
-            cout << "Direct analysis is not valid: cannot find frenquency excitation:" << frequencyExcitationRef << endl;
+            diagnostics << "Direct analysis is not valid: cannot find frenquency excitation:" << frequencyExcitationRef << endl;
         }
         isValid = false;
     }
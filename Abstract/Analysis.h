@@ -111,14 +111,21 @@ public:
 
     void removeSPCNodeDofs(SinglePointConstraint& spc, int nodePosition, const DOFS dofs);
     void addBoundaryDOFS(int nodePosition, const DOFS dofs);
+    void clearBoundaryDOFS();
     const DOFS findBoundaryDOFS(int nodePosition) const;
     const std::set<int> boundaryNodePositions() const;
+    /**
+     * DOFS used by the boundary conditions, by node position.
+     */
+    const std::map<int, char>& getBoundaryDOFSByNodePosition() const {
+        return boundaryDOFSByNodePosition;
+    }
 
     virtual std::shared_ptr<Analysis> clone() const =0;
     virtual bool isStatic() const {
         return false;
     }
-    bool validate() const override;
+    bool validate(std::ostream& diagnostics) const override;
     std::map<std::string, std::string> to_map() const;
 
     virtual ~Analysis();
@@ -145,7 +152,7 @@ public:
         return true;
     }
     std::shared_ptr<Analysis> clone() const;
-    bool validate() const override;
+    bool validate(std::ostream& diagnostics) const override;
 };
 
 class LinearModal: public Analysis {
@@ -159,7 +166,7 @@ public:
     std::shared_ptr<FrequencyTarget> getFrequencySearch() const;
     std::shared_ptr<Analysis> clone() const;
     bool use_power_iteration = false;
-    bool validate() const override;
+    bool validate(std::ostream& diagnostics) const override;
 };
 
 /**
@@ -182,7 +189,7 @@ public:
     std::shared_ptr<ModalDamping> getModalDamping() const;
     std::shared_ptr<FrequencyTarget> getExcitationFrequencies() const;
     std::shared_ptr<Analysis> clone() const;
-    bool validate() const override;
+    bool validate(std::ostream& diagnostics) const override;
 };
 
 /**
@@ -198,7 +205,7 @@ public:
             const std::string original_label = "", const int original_id = NO_ORIGINAL_ID);
     std::shared_ptr<FrequencyTarget> getExcitationFrequencies() const;
     std::shared_ptr<Analysis> clone() const;
-    bool validate() const override;
+    bool validate(std::ostream& diagnostics) const override;
 };
 
 } /* namespace vega */
@@ -25,7 +25,9 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
         string solverServer, string solverCommand,
         string systusRBE2TranslationMode, double systusRBE2Rigidity, double systusRBELagrangian,
         string systusOptionAnalysis, string systusOutputProduct, vector<vector<int> > systusSubcases,
-        string systusOutputMatrix, int systusSizeMatrix, string systusDynamicMethod) :
+        string systusOutputMatrix, int systusSizeMatrix, string systusDynamicMethod, string systusSplitMatrix,
+        bool profile, string nastranOutputFormat, bool incremental, bool linkInputFiles,
+        size_t asterMaxInlineListSize, bool prescan, bool meshOnly) :
                 inputFile(inputFile), outputSolver(outputSolver), solverVersion(solverVersion), outputFile(
                 outputFile), outputPath(outputPath), logLevel(logLevel), translationMode(
                 translationMode), resultFile(resultFile), testTolerance(tolerance), runSolver(
@@ -33,7 +35,11 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
                 systusRBE2TranslationMode(systusRBE2TranslationMode), systusRBE2Rigidity(systusRBE2Rigidity),
                 systusRBELagrangian(systusRBELagrangian), systusOptionAnalysis(systusOptionAnalysis),
                 systusOutputProduct(systusOutputProduct), systusSubcases(systusSubcases),
-                systusOutputMatrix(systusOutputMatrix), systusSizeMatrix(systusSizeMatrix), systusDynamicMethod(systusDynamicMethod)
+                systusOutputMatrix(systusOutputMatrix), systusSizeMatrix(systusSizeMatrix), systusDynamicMethod(systusDynamicMethod),
+                systusSplitMatrix(systusSplitMatrix),
+                profile(profile), nastranOutputFormat(nastranOutputFormat), incremental(incremental),
+                linkInputFiles(linkInputFiles), asterMaxInlineListSize(asterMaxInlineListSize),
+                prescan(prescan), meshOnly(meshOnly)
 {
 
 }
@@ -41,6 +47,7 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
 const ModelConfiguration ConfigurationParameters::getModelConfiguration() const {
     ModelConfiguration configuration;
     configuration.logLevel = this->logLevel;
+    configuration.profile = this->profile;
     if (this->outputSolver.getSolverName() == SolverName::CODE_ASTER) {
         configuration.virtualDiscrets = true;
         configuration.createSkin = true;
@@ -62,6 +69,7 @@ const ModelConfiguration ConfigurationParameters::getModelConfiguration() const
         configuration.removeRedundantSpcs = true;
         configuration.splitDirectMatrices = true;
         configuration.sizeDirectMatrices = this->systusSizeMatrix;
+        configuration.partitionDirectMatrices = this->systusSplitMatrix == "coupling";
         configuration.makeCellsFromDirectMatrices = true;
         configuration.makeCellsFromLMPC = true;
         configuration.makeCellsFromRBE = true;
@@ -103,6 +103,11 @@ public:
      */
     bool splitDirectMatrices = false;
     int sizeDirectMatrices = 999;
+    /**
+     *  Split the Direct Matrices following the coupling between their nodes, instead of the node order,
+     *  in order to get fewer terms between the split matrices, hence fewer matrices.
+     */
+    bool partitionDirectMatrices = false;
     /**
      *  ElementSets of Direct Matrices (DISCRETE_0D, DISCRETE_1D, STIFFNESS_MATRIX, MASS_MATRIX, DAMPING_MATRIX)
      *  generally don't have associated cells/cellgroup. This may causes problems in generic element writer,
@@ -143,6 +148,10 @@ public:
      * Select automatically the analysis (when missing) based on features in the model
      */
     bool autoDetectAnalysis = false;
+    /**
+     * Print the time spent in each pass of Model::finish()
+     */
+    bool profile = false;
 
 };
 // TODO: THe Configuration Parameters should be much more generalized. With this,
@@ -165,7 +174,10 @@ public:
             std::string systusOptionAnalysis="auto", std::string systusOutputProduct="systus",
             std::vector< std::vector<int> > systusSubcases = {},
             std::string systusOutputMatrix="table", int systusSizeMatrix=9,
-            std::string systusDynamicMethod="direct");
+            std::string systusDynamicMethod="direct", std::string systusSplitMatrix="order",
+            bool profile = false, std::string nastranOutputFormat = "short", bool incremental = false,
+            bool linkInputFiles = false, size_t asterMaxInlineListSize = 1000, bool prescan = false,
+            bool meshOnly = false);
     const ModelConfiguration getModelConfiguration() const;
     virtual ~ConfigurationParameters();
 
@@ -201,6 +213,43 @@ public:
      * Choice of Dynamic method : either a direct or a modal one
      */
     const std::string systusDynamicMethod;
+    /**
+     * Splitting of oversized Matrix Elements: by node 'order' (default) or by node 'coupling'.
+     */
+    const std::string systusSplitMatrix;
+    /**
+     * Measure and print the time spent in each step of the translation.
+     */
+    const bool profile;
+    /**
+     * Fields of the Nastran bulk cards: 'short' (default), 'large' or 'free'.
+     */
+    const std::string nastranOutputFormat;
+    /**
+     * Skip the writing of the output files whose data did not change since the previous translation,
+     * as recorded in the manifest of the output directory.
+     */
+    const bool incremental;
+    /**
+     * Hard link the input files into the output directory instead of copying them. The links share
+     * their content with the inputs: editing one of them edits the other.
+     */
+    const bool linkInputFiles;
+    /**
+     * Node and cell lists of the Code_Aster command file longer than this are written as groups of the mesh.
+     */
+    const size_t asterMaxInlineListSize;
+    /**
+     * Scan the input once before parsing it, to reserve the mesh storage. This reads the input twice,
+     * which pays off only on large meshes.
+     */
+    const bool prescan;
+    /**
+     * Translate only the mesh: the input cards which are not needed by the mesh are skipped
+     * without being decoded. Towards Code_Aster, the mesh is streamed to the MED file when
+     * the parser supports it (see Parser::streamMesh).
+     */
+    const bool meshOnly;
 };
 
 }
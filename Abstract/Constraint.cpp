@@ -82,11 +82,11 @@ const set<shared_ptr<Constraint> > ConstraintSet::getConstraints() const {
 
 const set<shared_ptr<Constraint> > ConstraintSet::getConstraintsByType(
         Constraint::Type type) const {
-    set<shared_ptr<Constraint> > result;
-    for (shared_ptr<Constraint> constraint : getConstraints()) {
-        if (constraint->type == type) {
-            result.insert(constraint);
-        }
+    set<shared_ptr<Constraint>> result = model.getConstraintsByConstraintSet(this->getReference(), type);
+    for (auto constraintSetReference : constraintSetReferences) {
+        set<shared_ptr<Constraint>> setToInsert = model.getConstraintsByConstraintSet(
+                constraintSetReference, type);
+        result.insert(setToInsert.begin(), setToInsert.end());
     }
     return result;
 }
@@ -324,6 +324,19 @@ void SinglePointConstraint::addNodeId(int nodeId) {
     }
 }
 
+void SinglePointConstraint::addNodeIds(const IntervalList& nodeIds) {
+    if (group == nullptr) {
+        _nodeIdIntervals.append(nodeIds);
+    } else {
+        if (group->type == Group::Type::NODEGROUP) {
+            shared_ptr<NodeGroup> const ngroup = dynamic_pointer_cast<NodeGroup>(group);
+            ngroup->addNodeIds(nodeIds);
+        } else {
+            throw logic_error("SPC:: addNodeIds on unknown group type");
+        }
+    }
+}
+
 shared_ptr<Constraint> SinglePointConstraint::clone()
 const {
     return make_shared<SinglePointConstraint>(*this);
@@ -332,10 +345,13 @@ const {
 set<int> SinglePointConstraint::nodePositions() const {
     set<int> result;
     result.insert(_nodePositions.begin(), _nodePositions.end());
+    for (int nodeId : _nodeIdIntervals) {
+        result.insert(model.mesh->findNodePosition(nodeId));
+    }
     if (group != nullptr) {
         if (this->group->type == Group::Type::NODEGROUP) {
             shared_ptr<NodeGroup> const ngroup = dynamic_pointer_cast<NodeGroup>(group);
-            set<int> nodePositions = ngroup->nodePositions();
+            const set<int>& nodePositions = ngroup->nodePositions();
             result.insert(nodePositions.begin(), nodePositions.end());
         } else {
             throw logic_error("SPC:: getAllNodes on unknown group type");
@@ -345,6 +361,10 @@ set<int> SinglePointConstraint::nodePositions() const {
 }
 
 void SinglePointConstraint::removeNode(int nodePosition) {
+    for (int nodeId : _nodeIdIntervals) {
+        _nodePositions.insert(model.mesh->findNodePosition(nodeId));
+    }
+    _nodeIdIntervals = IntervalList();
     if (_nodePositions.find(nodePosition) != _nodePositions.end()) {
         _nodePositions.erase(nodePosition);
     }
@@ -21,6 +21,7 @@
 #include "Target.h"
 #include <map>
 #include <list>
+#include <functional>
 
 namespace vega {
 
@@ -81,6 +82,11 @@ public:
 	void add(const Reference<ConstraintSet>&);
 	const std::set<std::shared_ptr<Constraint> > getConstraints() const;
 	const std::set<std::shared_ptr<Constraint> > getConstraintsByType(Constraint::Type) const;
+	/**
+	 * Constraints of type TYPE, in the same order as getConstraintsByType(TYPE), as references to their class.
+	 */
+	template<Constraint::Type TYPE>
+	const std::vector<std::reference_wrapper<const typename ClassOfType<Constraint, TYPE>::type>> getConstraintsByType() const;
 	int size() const;
 	std::shared_ptr<ConstraintSet> clone() const;
 	bool hasFunctions() const;
@@ -153,6 +159,8 @@ public:
 
 class SinglePointConstraint: public Constraint {
 	std::set<int> _nodePositions;
+	// Node ids added in bulk, resolved to positions only when the positions are requested
+	IntervalList _nodeIdIntervals;
 	std::array<ValueOrReference, 6> spcs;
 public:
 	//GC: static initialization order is undefined. A reference is needed here to
@@ -174,6 +182,11 @@ public:
 	std::shared_ptr<Group> group;
 
 	void addNodeId(int nodeId);
+	/**
+	 * Adds the nodes without expanding the intervals. The nodes must already be
+	 * known, or reserved, in the mesh.
+	 */
+	void addNodeIds(const IntervalList& nodeIds);
 	void setDOF(const DOF& dof, const ValueOrReference& value);
 	void setDOFS(const DOFS& dofs, const ValueOrReference& value);
 	double getDoubleForDOF(const DOF& dof) const;
@@ -329,6 +342,48 @@ public:
 	bool ineffective() const override;
 };
 
+// Classes of the constraints, by type (see ClassOfType)
+template<> struct ClassOfType<Constraint, Constraint::Type::QUASI_RIGID> {
+	typedef QuasiRigidConstraint type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::RIGID> {
+	typedef RigidConstraint type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::RBE3> {
+	typedef RBE3 type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::SPC> {
+	typedef SinglePointConstraint type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::LMPC> {
+	typedef LinearMultiplePointConstraint type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::GAP> {
+	typedef Gap type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::SLIDE> {
+	typedef SlideContact type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::SURFACE_CONTACT> {
+	typedef SurfaceContact type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::ZONE_CONTACT> {
+	typedef ZoneContact type;
+};
+template<> struct ClassOfType<Constraint, Constraint::Type::SURFACE_SLIDE_CONTACT> {
+	typedef SurfaceSlideContact type;
+};
+
+template<Constraint::Type TYPE>
+const std::vector<std::reference_wrapper<const typename ClassOfType<Constraint, TYPE>::type>> ConstraintSet::getConstraintsByType() const {
+	typedef typename ClassOfType<Constraint, TYPE>::type ConstraintClass;
+	std::vector<std::reference_wrapper<const ConstraintClass>> result;
+	for (const auto& constraint : getConstraintsByType(TYPE)) {
+		result.push_back(std::cref(static_cast<const ConstraintClass&>(*constraint)));
+	}
+	return result;
+}
+
 } /* namespace vega */
 
 #endif /* CONSTRAINT_H_ */
@@ -14,6 +14,8 @@
 #include <boost/assign.hpp>
 #include <ciso646>
 #include <math.h>
+#include <algorithm>
+#include <bitset>
 
 namespace vega {
 using namespace std;
@@ -349,6 +351,195 @@ bool DOFMatrix::isEmpty() const {
 	return componentByDofs.empty();
 }
 
+DOFBlock::DOFBlock(int rowNodePosition, int columnNodePosition) :
+		rowNodePosition(rowNodePosition), columnNodePosition(columnNodePosition) {
+	fill(begin(values), end(values), 0.0);
+}
+
+void DOFBlock::setComponent(const DOF& rowDof, const DOF& columnDof, double value) {
+	const int index = 6 * rowDof.position + columnDof.position;
+	values[index] = value;
+	definedComponents |= uint64_t(1) << index;
+}
+
+double DOFBlock::findComponent(const DOF& rowDof, const DOF& columnDof) const {
+	return values[6 * rowDof.position + columnDof.position];
+}
+
+bool DOFBlock::hasTranslations() const {
+	// components of rows or columns DX, DY, DZ
+	static const uint64_t translationComponents = 0x1C71FFFFF;
+	return (definedComponents & translationComponents) != 0;
+}
+
+bool DOFBlock::hasRotations() const {
+	// components of rows or columns RX, RY, RZ
+	static const uint64_t rotationComponents = 0xFFFFF8E38;
+	return (definedComponents & rotationComponents) != 0;
+}
+
+int DOFBlock::countComponents() const {
+	return static_cast<int>(bitset<36>(definedComponents).count());
+}
+
+DOFBlockMatrix::DOFBlockMatrix(bool symmetric) : symmetric(symmetric) {
+}
+
+void DOFBlockMatrix::addComponent(int rowNodePosition, const DOF& rowDof, int columnNodePosition,
+		const DOF& columnDof, double value) {
+	const DOF* myRowDof = &rowDof;
+	const DOF* myColumnDof = &columnDof;
+	if (symmetric && (rowNodePosition > columnNodePosition
+			|| (rowNodePosition == columnNodePosition && columnDof.position < rowDof.position))) {
+		swap(rowNodePosition, columnNodePosition);
+		swap(myRowDof, myColumnDof);
+	}
+	vector<DOFBlock>& row = blocksByRow[rowNodePosition];
+	auto it = lower_bound(row.begin(), row.end(), columnNodePosition,
+			[](const DOFBlock& block, int position) {return block.columnNodePosition < position;});
+	if (it == row.end() || it->columnNodePosition != columnNodePosition) {
+		it = row.insert(it, DOFBlock(rowNodePosition, columnNodePosition));
+		blockCount++;
+		vector<int>& column = rowsByColumn[columnNodePosition];
+		column.insert(lower_bound(column.begin(), column.end(), rowNodePosition), rowNodePosition);
+	}
+	it->setComponent(*myRowDof, *myColumnDof, value);
+}
+
+const DOFBlock* DOFBlockMatrix::findBlock(int rowNodePosition, int columnNodePosition) const {
+	auto rowIt = blocksByRow.find(rowNodePosition);
+	if (rowIt == blocksByRow.end()) {
+		return nullptr;
+	}
+	const vector<DOFBlock>& row = rowIt->second;
+	auto it = lower_bound(row.begin(), row.end(), columnNodePosition,
+			[](const DOFBlock& block, int position) {return block.columnNodePosition < position;});
+	if (it == row.end() || it->columnNodePosition != columnNodePosition) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+vector<int> DOFBlockMatrix::rowNodePositions() const {
+	vector<int> result;
+	result.reserve(blocksByRow.size());
+	for (const auto& row : blocksByRow) {
+		result.push_back(row.first);
+	}
+	return result;
+}
+
+vector<vector<int>> DOFBlockMatrix::partitionNodesByOrder(int partSize) const {
+	vector<vector<int>> parts;
+	set<int> partitionedNodes;
+	forEachBlock([&](const DOFBlock& block) {
+		for (int nodePosition : { block.rowNodePosition, block.columnNodePosition }) {
+			if (partitionedNodes.insert(nodePosition).second) {
+				if (parts.empty() or parts.back().size() == static_cast<size_t>(partSize)) {
+					parts.push_back(vector<int>());
+				}
+				parts.back().push_back(nodePosition);
+			}
+		}
+	});
+	return parts;
+}
+
+vector<vector<int>> DOFBlockMatrix::partitionNodesByCoupling(int partSize) const {
+	// Compact numbering of the nodes, and coupling graph weighted by the number of terms
+	map<int, int> indexByNode;
+	forEachBlock([&](const DOFBlock& block) {
+		indexByNode.insert(make_pair(block.rowNodePosition, 0));
+		indexByNode.insert(make_pair(block.columnNodePosition, 0));
+	});
+	vector<int> nodePositions;
+	nodePositions.reserve(indexByNode.size());
+	for (auto& indexAndNode : indexByNode) {
+		indexAndNode.second = static_cast<int>(nodePositions.size());
+		nodePositions.push_back(indexAndNode.first);
+	}
+	vector<map<int, int>> weightByNeighbour(nodePositions.size());
+	forEachBlock([&](const DOFBlock& block) {
+		if (block.rowNodePosition == block.columnNodePosition) {
+			return;
+		}
+		const int rowIndex = indexByNode[block.rowNodePosition];
+		const int columnIndex = indexByNode[block.columnNodePosition];
+		weightByNeighbour[rowIndex][columnIndex] += block.countComponents();
+		weightByNeighbour[columnIndex][rowIndex] += block.countComponents();
+	});
+
+	// Parts are grown one node at a time, always adding the node with the heaviest coupling
+	// to the current part. New parts start from the node with the fewest free neighbours,
+	// which is on the border of what remains of the graph.
+	vector<vector<int>> parts;
+	vector<bool> isPartitioned(nodePositions.size(), false);
+	vector<int> freeNeighbourCount(nodePositions.size());
+	set<pair<int, int>> seeds;
+	for (size_t index = 0; index < nodePositions.size(); index++) {
+		freeNeighbourCount[index] = static_cast<int>(weightByNeighbour[index].size());
+		seeds.insert(make_pair(freeNeighbourCount[index], static_cast<int>(index)));
+	}
+	vector<int> frontier; /**< free neighbours of the current part, in discovery order */
+	vector<int> gainByIndex(nodePositions.size(), 0);
+	while (!seeds.empty()) {
+		int index = seeds.begin()->second;
+		auto bestIt = frontier.end();
+		for (auto it = frontier.begin(); it != frontier.end(); ++it) {
+			if (bestIt == frontier.end() or gainByIndex[*it] > gainByIndex[*bestIt]
+					or (gainByIndex[*it] == gainByIndex[*bestIt] and freeNeighbourCount[*it] < freeNeighbourCount[*bestIt])) {
+				bestIt = it;
+			}
+		}
+		if (bestIt != frontier.end()) {
+			index = *bestIt;
+			frontier.erase(bestIt);
+		}
+		if (parts.empty() or parts.back().size() == static_cast<size_t>(partSize)) {
+			parts.push_back(vector<int>());
+		}
+		parts.back().push_back(nodePositions[index]);
+		isPartitioned[index] = true;
+		seeds.erase(make_pair(freeNeighbourCount[index], index));
+		for (const auto& neighbourAndWeight : weightByNeighbour[index]) {
+			const int neighbour = neighbourAndWeight.first;
+			if (isPartitioned[neighbour]) {
+				continue;
+			}
+			seeds.erase(make_pair(freeNeighbourCount[neighbour], neighbour));
+			freeNeighbourCount[neighbour]--;
+			seeds.insert(make_pair(freeNeighbourCount[neighbour], neighbour));
+			if (gainByIndex[neighbour] == 0) {
+				frontier.push_back(neighbour);
+			}
+			gainByIndex[neighbour] += neighbourAndWeight.second;
+		}
+		if (parts.back().size() == static_cast<size_t>(partSize)) {
+			for (int neighbour : frontier) {
+				gainByIndex[neighbour] = 0;
+			}
+			frontier.clear();
+		}
+	}
+
+	return parts;
+}
+
+const vector<DOFBlock>& DOFBlockMatrix::getRow(int rowNodePosition) const {
+	static const vector<DOFBlock> emptyRow;
+	auto rowIt = blocksByRow.find(rowNodePosition);
+	if (rowIt == blocksByRow.end()) {
+		return emptyRow;
+	}
+	return rowIt->second;
+}
+
+void DOFBlockMatrix::clear() {
+	blocksByRow.clear();
+	rowsByColumn.clear();
+	blockCount = 0;
+}
+
 bool DOFCoefs::operator< (const DOFCoefs& other) const{
     for (int i=0; i<6; i++){
         if (is_equal(this->coefs[i],other.coefs[i])) continue;
@@ -15,7 +15,10 @@
 #include "Value.h"
 #include <boost/bimap.hpp>
 #include <unordered_map>
+#include <map>
+#include <vector>
 #include <set>
+#include <cstdint>
 
 namespace vega {
 
@@ -167,6 +170,122 @@ public:
 		bool isEmpty() const;
 };
 
+/**
+ * Dense 6x6 block of components between the DOFs of two nodes, indexed by DOF position.
+ * Only the components which have been set are considered as defined.
+ */
+class DOFBlock final {
+private:
+	double values[36];
+	uint64_t definedComponents = 0;
+public:
+	DOFBlock(int rowNodePosition, int columnNodePosition);
+	int rowNodePosition;
+	int columnNodePosition;
+	void setComponent(const DOF& rowDof, const DOF& columnDof, double value);
+	bool hasComponent(int rowDofPosition, int columnDofPosition) const {
+		return (definedComponents >> (6 * rowDofPosition + columnDofPosition)) & 1;
+	}
+	/**
+	 * Returns the component, 0 if it has not been set.
+	 */
+	double findComponent(const DOF& rowDof, const DOF& columnDof) const;
+	bool hasTranslations() const;
+	bool hasRotations() const;
+	bool isEmpty() const {
+		return definedComponents == 0;
+	}
+	int countComponents() const;
+	/**
+	 * Call function(rowDof, columnDof, value) on every defined component, row by row.
+	 */
+	template<typename Function> void forEachComponent(Function function) const {
+		static const DOF* const dofByPosition[6] = { &DOF::DX, &DOF::DY, &DOF::DZ, &DOF::RX, &DOF::RY, &DOF::RZ };
+		for (int i = 0; i < 36; i++) {
+			if ((definedComponents >> i) & 1) {
+				function(*dofByPosition[i / 6], *dofByPosition[i % 6], values[i]);
+			}
+		}
+	}
+};
+
+/**
+ * Sparse matrix between the DOFs of a group of nodes, stored by blocks of 6x6 components
+ * (Block Sparse Row): rows are sorted by node position, and the blocks of a row by column
+ * node position. When symmetric only the upper part is kept: row node position <= column
+ * node position, and row DOF <= column DOF in the diagonal blocks.
+ */
+class DOFBlockMatrix final {
+private:
+	bool symmetric;
+	std::map<int, std::vector<DOFBlock>> blocksByRow;
+	std::map<int, std::vector<int>> rowsByColumn; /**< Column index: the rows having a block in each column, sorted */
+	size_t blockCount = 0;
+public:
+	DOFBlockMatrix(bool symmetric = false);
+	/**
+	 * Set a component, replacing the previous value if any.
+	 */
+	void addComponent(int rowNodePosition, const DOF& rowDof, int columnNodePosition,
+			const DOF& columnDof, double value);
+	/**
+	 * Returns nullptr if no component has been set between these nodes (as stored:
+	 * see class documentation in the symmetric case).
+	 */
+	const DOFBlock* findBlock(int rowNodePosition, int columnNodePosition) const;
+	/**
+	 * Call function(block) on every block, in row then column order.
+	 */
+	template<typename Function> void forEachBlock(Function function) const {
+		for (const auto& row : blocksByRow) {
+			for (const DOFBlock& block : row.second) {
+				function(block);
+			}
+		}
+	}
+	/**
+	 * Call function(block) on every block of a node, either in its row or in its column.
+	 */
+	template<typename Function> void forEachBlockOfNode(int nodePosition, Function function) const {
+		for (const DOFBlock& block : getRow(nodePosition)) {
+			function(block);
+		}
+		auto columnIt = rowsByColumn.find(nodePosition);
+		if (columnIt == rowsByColumn.end()) {
+			return;
+		}
+		for (int rowNodePosition : columnIt->second) {
+			if (rowNodePosition != nodePosition) {
+				function(*findBlock(rowNodePosition, nodePosition));
+			}
+		}
+	}
+	/**
+	 * Node positions of the rows, in increasing order.
+	 */
+	std::vector<int> rowNodePositions() const;
+	/**
+	 * Split the nodes in parts of at most partSize nodes, following the order in which they
+	 * appear in the blocks. Returns the node positions of each part.
+	 */
+	std::vector<std::vector<int>> partitionNodesByOrder(int partSize) const;
+	/**
+	 * Split the nodes in parts of at most partSize nodes, trying to keep coupled nodes together
+	 * (greedy graph growing on the node coupling graph, weighted by the number of terms),
+	 * so that few terms are left between parts. Returns the node positions of each part, in
+	 * the order they were added to it.
+	 */
+	std::vector<std::vector<int>> partitionNodesByCoupling(int partSize) const;
+	const std::vector<DOFBlock>& getRow(int rowNodePosition) const;
+	size_t size() const {
+		return blockCount;
+	}
+	bool isSymmetric() const {
+		return symmetric;
+	}
+	void clear();
+};
+
 
 /**
  * This class regroups one coefficient by DOF.
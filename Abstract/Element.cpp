@@ -76,16 +76,16 @@ const ModelType ElementSet::getModelType() const {
 	return this->model.modelType;
 }
 
-bool ElementSet::validate() const {
+bool ElementSet::validate(ostream& diagnostics) const {
 	bool validElement = true;
 
 	if (cellGroup == nullptr) {
-		cerr << *this << " has no cellGroup assigned." << endl;
+		diagnostics << *this << " has no cellGroup assigned." << endl;
 		validElement = false;
 	}
 
 	if (material == nullptr && model.configuration.partitionModel) {
-		cerr << *this << " has no material assigned, "
+		diagnostics << *this << " has no material assigned, "
 				<< "and config. param partitionModel is set to True." << endl;
 		validElement = false;
 	}
@@ -280,7 +280,7 @@ void Composite::addLayer(int materialId, double thickness, double orientation) {
     layers.push_back(CompositeLayer(materialId, thickness, orientation));
 }
 
-double Composite::getTotalThickness() {
+double Composite::getTotalThickness() const {
     double total = 0.0;
     for(auto& layer : layers) {
         total += layer.getThickness();
@@ -734,91 +734,59 @@ double ISectionBeam::getShearAreaFactorZ() const {
 }
 
 MatrixElement::MatrixElement(Model& model, Type type, bool symmetric, int original_id) :
-		ElementSet(model, type, modelType, original_id), symmetric(symmetric) {
+		ElementSet(model, type, modelType, original_id), blocks(symmetric) {
 }
 
 void MatrixElement::addComponent(const int nodeid1, const DOF dof1, const int nodeid2, const DOF dof2, const double value) {
 	int nodePosition1 = model.mesh->findOrReserveNode(nodeid1);
 	int nodePosition2 = model.mesh->findOrReserveNode(nodeid2);
-	DOF myDof1 = dof1;
-	DOF myDof2 = dof2;
-
-	if (nodePosition1 > nodePosition2) {
-		int swap = nodePosition2;
-		nodePosition2 = nodePosition1;
-		nodePosition1 = swap;
-		myDof1 = dof2;
-		myDof2 = dof1;
-	}
-	auto it = submatrixByNodes.find(make_pair(nodePosition1, nodePosition2));
-	shared_ptr<DOFMatrix> subMatrix = nullptr;
-	if (it != submatrixByNodes.end()) {
-		subMatrix = it->second;
-	} else {
-		subMatrix = make_shared<DOFMatrix>(DOFMatrix(symmetric && nodeid1 == nodeid2));
-		this->submatrixByNodes[make_pair(nodePosition1, nodePosition2)] = subMatrix;
+	blocks.addComponent(nodePosition1, dof1, nodePosition2, dof2, value);
+	_nodePositions.insert(nodePosition1);
+	_nodePositions.insert(nodePosition2);
+}
+
+void MatrixElement::addComponents(const int nodeid1, const DOF dof1, const vector<tuple<int, DOF, double>>& components) {
+	const int nodePosition1 = model.mesh->findOrReserveNode(nodeid1);
+	_nodePositions.insert(nodePosition1);
+	// Components of a node usually follow each other
+	int nodeid2 = Globals::UNAVAILABLE_INT;
+	int nodePosition2 = Globals::UNAVAILABLE_INT;
+	for (const auto& component : components) {
+		if (get<0>(component) != nodeid2) {
+			nodeid2 = get<0>(component);
+			nodePosition2 = model.mesh->findOrReserveNode(nodeid2);
+			_nodePositions.insert(nodePosition2);
+		}
+		blocks.addComponent(nodePosition1, dof1, nodePosition2, get<1>(component), get<2>(component));
 	}
-    subMatrix->addComponent(myDof1, myDof2, value);
 }
 
 void MatrixElement::clear() {
-    submatrixByNodes.clear();
-}
-
-
-const shared_ptr<DOFMatrix> MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
-	shared_ptr<DOFMatrix> result = make_shared<DOFMatrix>(DOFMatrix(symmetric));
-	auto it = submatrixByNodes.find(make_pair(nodePosition1, nodePosition2));
-	if (it != submatrixByNodes.end()) {
-		std::copy(it->second->componentByDofs.begin(), it->second->componentByDofs.end(),
-				std::inserter(result->componentByDofs, result->componentByDofs.end()));
-	}
-	return result;
-}
-
-const set<int> MatrixElement::nodePositions() const {
-	set<int> result;
-	for (auto& kv : submatrixByNodes) {
-		result.insert(kv.first.first);
-		result.insert(kv.first.second);
-	}
-	return result;
+	blocks.clear();
+	_nodePositions.clear();
 }
 
 const DOFS MatrixElement::getDOFSForNode(const int nodePosition) const {
 	DOFS dofs;
-	for (auto& kv : submatrixByNodes) {
-		if (kv.first.first == nodePosition or kv.first.second) {
-			if (kv.second->hasRotations()) {
-				dofs += DOFS::ROTATIONS;
-			}
-			if (kv.second->hasTranslations()) {
-				dofs += DOFS::TRANSLATIONS;
-			}
+	blocks.forEachBlockOfNode(nodePosition, [&dofs](const DOFBlock& block) {
+		if (block.hasRotations()) {
+			dofs += DOFS::ROTATIONS;
 		}
-	}
+		if (block.hasTranslations()) {
+			dofs += DOFS::TRANSLATIONS;
+		}
+	});
 	return dofs;
 }
 
-const set<pair<int, int>> MatrixElement::nodePairs() const {
-	set<pair<int, int>> result;
-	for (auto& kv : submatrixByNodes) {
-		result.insert(make_pair(kv.first.first, kv.first.second));
-	}
-	return result;
-}
-
-const std::set<std::pair<int, int>> MatrixElement::findInPairs(int nodePosition) const {
-	set<pair<int, int>> result;
-	for (auto& kv : submatrixByNodes) {
-		if (kv.first.first != nodePosition and kv.first.second != nodePosition) {
-			continue;
+map<int, int> MatrixElement::countOffDiagonalBlocksByNode() const {
+	map<int, int> result;
+	blocks.forEachBlock([&result](const DOFBlock& block) {
+		if (block.rowNodePosition != block.columnNodePosition) {
+			result[block.rowNodePosition]++;
+			result[block.columnNodePosition]++;
 		}
-		if (kv.first.first == kv.first.second) {
-			continue;
-		}
-		result.insert(make_pair(kv.first.first, kv.first.second));
-	}
+	});
 	return result;
 }
 
@@ -995,7 +963,7 @@ const vector<double> ScalarSpring::asStiffnessVector(bool addRotationsIfNotPrese
 	return result;
 }
 
-const vector<double> ScalarSpring::asDampingVector(bool addRotationsIfNotPresent) {
+const vector<double> ScalarSpring::asDampingVector(bool addRotationsIfNotPresent) const {
 	vector<double> result;
 	int ncomp = (addRotationsIfNotPresent || hasRotations()) ? 6 : 3;
 	int max_row_element_index = 0;
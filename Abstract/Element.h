@@ -16,6 +16,7 @@
 #include "Dof.h"
 
 #include <fstream>
+#include <tuple>
 #include <boost/lexical_cast.hpp>
 #include <boost/functional/hash.hpp>
 //win
@@ -87,9 +88,12 @@ public:
     }
     void assignCellGroup(std::shared_ptr<CellGroup>);
     const ModelType getModelType() const;
-    virtual bool validate() const override;
+    virtual bool validate(std::ostream& diagnostics) const override;
     virtual std::shared_ptr<ElementSet> clone() const = 0;
-    virtual const std::set<int> nodePositions() const {
+    /**
+     * Positions of the nodes of the element set, cached (see CellGroup::nodePositions()).
+     */
+    virtual const std::set<int>& nodePositions() const {
         assert(cellGroup != nullptr);
         return cellGroup->nodePositions();
     }
@@ -299,7 +303,7 @@ class Composite: public ElementSet {
 		return std::make_shared<Composite>(*this);
 	}
 	void addLayer(int materialId, double thickness, double orientation = 0);
-	double getTotalThickness();
+	double getTotalThickness() const;
 	inline const std::vector<CompositeLayer>& getLayers() const {
 	    return layers;
 	}
@@ -439,24 +443,39 @@ class NodalMass: public ElementSet {
 /* Matrix for a group nodes.*/
 class MatrixElement : public ElementSet {
 private:
-	std::map<std::pair<int, int>, std::shared_ptr<DOFMatrix>> submatrixByNodes;
-	bool symmetric = false;
+	DOFBlockMatrix blocks; /**< Blocks by pair of node positions */
+	std::set<int> _nodePositions; /**< Nodes of the blocks, kept along with them */
 public:
 	MatrixElement(Model&, Type type, bool symmetric = false, int original_id = NO_ORIGINAL_ID);
 	void addComponent(const int nodeid1, const DOF dof1, const int nodeid2, const DOF dof2, const double value);
+	/**
+	 * Add the components between one DOF of a node and DOFs of other nodes (node id, DOF, value),
+	 * e.g. a DMIG column. Faster than repeated addComponent calls.
+	 */
+	void addComponents(const int nodeid1, const DOF dof1, const std::vector<std::tuple<int, DOF, double>>& components);
 	/**
 	 * Clear all nodes and submatrices of the Matrix.
 	 */
 	void clear();
-	const std::shared_ptr<DOFMatrix> findSubmatrix(const int nodePosition1, const int nodePosition2) const;
-	const std::set<int> nodePositions() const override;
-	const std::set<std::pair<int, int>> nodePairs() const;
-	const std::set<std::pair<int, int>> findInPairs(int nodePosition) const;
+	/**
+	 * Components of the matrix, by blocks of node positions. When symmetric, only the
+	 * upper part is stored (see DOFBlockMatrix).
+	 */
+	const DOFBlockMatrix& getBlocks() const {
+		return blocks;
+	}
+	const std::set<int>& nodePositions() const override {
+		return _nodePositions;
+	}
+	/**
+	 * Number of blocks between each node and other nodes (diagonal blocks excluded).
+	 */
+	std::map<int, int> countOffDiagonalBlocksByNode() const;
 	const DOFS getDOFSForNode(const int nodePosition) const override final;
 	bool isMatrixElement() const override final {
 		return true;
 	}
-	virtual bool validate() const override {
+	virtual bool validate(std::ostream&) const override {
 		return true;
 	}
 	virtual ~MatrixElement() {
@@ -564,13 +583,69 @@ public:
      */
     void addSpring(int cellPosition, DOF dofNodeA, DOF dofNodeB);
     const std::vector<double> asStiffnessVector(bool addRotationsIfNotPresent = false) const override final;
-    const std::vector<double> asDampingVector(bool addRotationsIfNotPresent = false);
-    virtual bool validate() const {
+    const std::vector<double> asDampingVector(bool addRotationsIfNotPresent = false) const;
+    virtual bool validate(std::ostream&) const {
         return true;
     }
     std::shared_ptr<ElementSet> clone() const override;
     virtual ~ScalarSpring() {}
 };
 
+// Classes of the element sets, by type (see ClassOfType)
+template<> struct ClassOfType<ElementSet, ElementSet::Type::DISCRETE_0D> {
+    typedef DiscretePoint type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::DISCRETE_1D> {
+    typedef DiscreteSegment type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::NODAL_MASS> {
+    typedef NodalMass type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::CIRCULAR_SECTION_BEAM> {
+    typedef CircularSectionBeam type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::RECTANGULAR_SECTION_BEAM> {
+    typedef RectangularSectionBeam type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::I_SECTION_BEAM> {
+    typedef ISectionBeam type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::GENERIC_SECTION_BEAM> {
+    typedef GenericSectionBeam type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::STRUCTURAL_SEGMENT> {
+    typedef StructuralSegment type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::SHELL> {
+    typedef Shell type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::CONTINUUM> {
+    typedef Continuum type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::STIFFNESS_MATRIX> {
+    typedef StiffnessMatrix type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::MASS_MATRIX> {
+    typedef MassMatrix type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::DAMPING_MATRIX> {
+    typedef DampingMatrix type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::RBAR> {
+    typedef Rbar type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::RBE3> {
+    typedef Rbe3 type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::LMPC> {
+    typedef Lmpc type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::SCALAR_SPRING> {
+    typedef ScalarSpring type;
+};
+template<> struct ClassOfType<ElementSet, ElementSet::Type::COMPOSITE> {
+    typedef Composite type;
+};
+
 } /* namespace vega */
 #endif /* ELEMENT_H_ */
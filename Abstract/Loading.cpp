@@ -40,12 +40,12 @@ ostream &operator<<(ostream &out, const Loading& loading) {
 	return out;
 }
 
-bool Loading::validate() const {
+bool Loading::validate(ostream& diagnostics) const {
 	bool valid = true;
 	if (hasCoordinateSystem()) {
 		valid = model.mesh->getCoordinateSystem(coordinate_system_id) != nullptr;
 		if (!valid) {
-			cerr
+			diagnostics
 			<< string("Coordinate system id:")
 					+ to_string(coordinate_system_id)
 					+ " for loading " << *this << " not found." << endl;
@@ -86,20 +86,14 @@ const set<shared_ptr<Loading> > LoadSet::getLoadings() const {
 }
 
 const set<shared_ptr<Loading> > LoadSet::getLoadingsByType(Loading::Type loadingType) const {
-	set<shared_ptr<Loading> > result;
-	for (shared_ptr<Loading> loading : getLoadings()) {
-		if (loading->type == loadingType) {
-			result.insert(loading);
-		}
-	}
-	return result;
+	return model.getLoadingsByLoadSet(this->getReference(), loadingType);
 }
 
-bool LoadSet::validate() const {
+bool LoadSet::validate(ostream& diagnostics) const {
 	set<shared_ptr<Loading>> loadings = getLoadings();
 	if (loadings.size() == 0 ) { //or loadings.find(0) != loadings.end()) {
         if (model.configuration.logLevel >= LogLevel::INFO) {
-            cout << "Loadset " << *this << " is not valid, no loads associated" << endl;
+            diagnostics << "Loadset " << *this << " is not valid, no loads associated" << endl;
         }
 		return false;
 	}
@@ -491,7 +485,7 @@ bool ElementLoading::cellDimensionGreatherThan(SpaceDimension dimension) {
 
 }
 
-bool ElementLoading::appliedToGeometry() {
+bool ElementLoading::appliedToGeometry() const {
 	bool isForceOnPoutre = false;
 	bool assigned = false;
 	vector<Cell> cells = getCells(true);
@@ -574,7 +568,7 @@ bool ForceSurface::ineffective() const {
 	return force.iszero() and moment.iszero();
 }
 
-bool ForceSurface::validate() const {
+bool ForceSurface::validate(ostream&) const {
 	return true;
 }
 
@@ -624,7 +618,7 @@ bool ForceLine::ineffective() const {
 	return force->iszero();
 }
 
-bool ForceLine::validate() const {
+bool ForceLine::validate(ostream&) const {
 	return true;
 }
 
@@ -658,7 +652,7 @@ bool NormalPressionFace::ineffective() const {
 	return is_zero(intensity);
 }
 
-bool NormalPressionFace::validate() const {
+bool NormalPressionFace::validate(ostream&) const {
 	// TODO validate : Check that all the elements are 2D
 	return true;
 }
@@ -712,7 +706,7 @@ shared_ptr<Loading> DynamicExcitation::clone() const {
     return make_shared<DynamicExcitation>(*this);
 }
 
-bool DynamicExcitation::validate() const {
+bool DynamicExcitation::validate(ostream&) const {
     //TODO: Validate should be a bit more complex
     return getLoadSet() && getFunctionTableB() && getDynaPhase() && getDynaDelay();
 }
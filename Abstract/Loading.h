@@ -19,6 +19,7 @@
 #include "CoordinateSystem.h"
 #include "Reference.h"
 #include <climits>
+#include <functional>
 
 namespace vega {
 
@@ -66,7 +67,7 @@ public:
 		std::cerr << "loading scale(" << factor << ") used but not implemented" << std::endl;
 		throw std::logic_error("loading scale() used but not implemented");
 	}
-	bool validate() const override;
+	bool validate(std::ostream& diagnostics) const override;
 };
 
 /**
@@ -92,7 +93,12 @@ public:
 	int size() const;
 	const std::set<std::shared_ptr<Loading> > getLoadings() const;
 	const std::set<std::shared_ptr<Loading> > getLoadingsByType(Loading::Type) const;
-	bool validate() const override;
+	/**
+	 * Loadings of type TYPE, in the same order as getLoadingsByType(TYPE), as references to their class.
+	 */
+	template<Loading::Type TYPE>
+	const std::vector<std::reference_wrapper<const typename ClassOfType<Loading, TYPE>::type>> getLoadingsByType() const;
+	bool validate(std::ostream& diagnostics) const override;
 	std::shared_ptr<LoadSet> clone() const;
 	bool hasFunctions() const;
 	//bool operator<(const LoadSet &rhs) const;
@@ -285,7 +291,7 @@ public:
 	virtual SpaceDimension getLoadingDimension() const = 0;
 	//implement a function that tell if this force is applied to a
 	//geometrical element or to a Poutre.
-	bool appliedToGeometry();
+	bool appliedToGeometry() const;
 };
 
 // TODO : refactor conception of ForceSurface to have only one base class and virtual fct to generate skin get/add applications
@@ -310,7 +316,7 @@ public:
 		return SpaceDimension::DIMENSION_2D;
 	}
 	// TODO validate : Check that all the elements are 2D
-	bool validate() const override;
+	bool validate(std::ostream& diagnostics) const override;
 	virtual std::vector<int> getApplicationFace() const {
 		return std::vector<int>();
 	}
@@ -351,7 +357,7 @@ public:
 	bool hasFunctions() const override {
 	    return force->isfunction();
 	}
-	bool validate() const override;
+	bool validate(std::ostream& diagnostics) const override;
 
 };
 
@@ -361,7 +367,7 @@ public:
 	double intensity;
 	NormalPressionFace(const Model&, double intensity, const int original_id = NO_ORIGINAL_ID);
 	const DOFS getDOFSForNode(const int nodePosition) const override;
-	bool validate() const override;
+	bool validate(std::ostream& diagnostics) const override;
 	SpaceDimension getLoadingDimension() const {
 		return SpaceDimension::DIMENSION_2D;
 	}
@@ -395,7 +401,7 @@ public:
     std::set<int> nodePositions() const override;
     const DOFS getDOFSForNode(const int nodePosition) const override;
     std::shared_ptr<Loading> clone() const override;
-    bool validate() const override;
+    bool validate(std::ostream& diagnostics) const override;
     bool ineffective() const override;
 };
 
@@ -410,6 +416,42 @@ public:
 	bool ineffective() const override;
 };
 
+// Classes of the loadings, by type (see ClassOfType)
+template<> struct ClassOfType<Loading, Loading::Type::GRAVITY> {
+	typedef Gravity type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::ROTATION> {
+	typedef Rotation type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::NODAL_FORCE> {
+	typedef NodalForce type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::FORCE_SURFACE> {
+	typedef ForceSurface type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::FORCE_LINE> {
+	typedef ForceLine type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::NORMAL_PRESSION_FACE> {
+	typedef NormalPressionFace type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::DYNAMIC_EXCITATION> {
+	typedef DynamicExcitation type;
+};
+template<> struct ClassOfType<Loading, Loading::Type::INITIAL_TEMPERATURE> {
+	typedef InitialTemperature type;
+};
+
+template<Loading::Type TYPE>
+const std::vector<std::reference_wrapper<const typename ClassOfType<Loading, TYPE>::type>> LoadSet::getLoadingsByType() const {
+	typedef typename ClassOfType<Loading, TYPE>::type LoadingClass;
+	std::vector<std::reference_wrapper<const LoadingClass>> result;
+	for (const auto& loading : getLoadingsByType(TYPE)) {
+		result.push_back(std::cref(static_cast<const LoadingClass&>(*loading)));
+	}
+	return result;
+}
+
 } /* namespace vega */
 
 #endif /* LOADING_H_ */
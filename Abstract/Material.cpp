@@ -43,10 +43,10 @@ shared_ptr<Material> Material::clone() const {
 	return make_shared<Material>(*this);
 }
 
-bool Material::validate() const {
+bool Material::validate(ostream& diagnostics) const {
 	bool validMaterial = nature_by_type.size() > 0;
 	if (!validMaterial) {
-		cerr << *this << " has no nature assigned.";
+		diagnostics << *this << " has no nature assigned." << endl;
 	}
 	return validMaterial;
 }
@@ -180,7 +180,7 @@ public:
     Material(Model* model, int material_id = NO_ORIGINAL_ID);
     void addNature(const Nature &nature);
     const std::shared_ptr<Nature> findNature(Nature::NatureType) const;
-    virtual bool validate() const override;
+    virtual bool validate(std::ostream& diagnostics) const override;
     virtual std::shared_ptr<Material> clone() const;
     /**
      * Get all the cells assigned to a specific material. This inspects
@@ -17,11 +17,13 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/lexical_cast.hpp>
 #include "Model.h"
+#include "OutputManifest.h"
 #include <med.h>
 #include <stdio.h>
 #include <string.h>
 #include <algorithm>
 #include <cstddef>
+#include <future>
 #include <utility>
 #include <iostream>
 #include <iterator>
@@ -41,6 +43,55 @@ using boost::lexical_cast;
 namespace fs = boost::filesystem;
 
 const double NodeStorage::RESERVED_POSITION = -DBL_MAX;
+const int PositionIndex::UNAVAILABLE_POSITION;
+const int Mesh::MED_WRITE_BLOCK_SIZE;
+
+/******************************************************************************
+ * PositionIndex class
+ ******************************************************************************/
+
+int PositionIndex::find(int id) const {
+	if (!positionByDenseId.empty() && id >= denseMinId) {
+		const size_t offset = static_cast<size_t>(id - denseMinId);
+		if (offset < positionByDenseId.size()) {
+			return positionByDenseId[offset];
+		}
+	}
+	auto positionIterator = positionBySparseId.find(id);
+	if (positionIterator == positionBySparseId.end()) {
+		return UNAVAILABLE_POSITION;
+	}
+	return positionIterator->second;
+}
+
+void PositionIndex::set(int id, int position) {
+	if (!positionByDenseId.empty() && id >= denseMinId) {
+		const size_t offset = static_cast<size_t>(id - denseMinId);
+		if (offset < positionByDenseId.size()) {
+			if (positionByDenseId[offset] == UNAVAILABLE_POSITION) {
+				denseCount++;
+			}
+			positionByDenseId[offset] = position;
+			return;
+		}
+	}
+	positionBySparseId[id] = position;
+}
+
+size_t PositionIndex::size() const {
+	return denseCount + positionBySparseId.size();
+}
+
+void PositionIndex::reserve(size_t count, int minId, int maxId) {
+	if (size() != 0 || count == 0 || maxId < minId) {
+		return;
+	}
+	const size_t range = static_cast<size_t>(static_cast<long>(maxId) - minId) + 1;
+	if (range <= 2 * count) {
+		denseMinId = minId;
+		positionByDenseId.assign(range, UNAVAILABLE_POSITION);
+	}
+}
 
 NodeData::NodeData(int id, const DOFS& dofs, double x, double y, double z, int cpPos, int cdPos) :
     id(id), dofs(dofs), x(x), y(y), z(z), cpPos(cpPos), cdPos(cdPos) {
@@ -65,7 +116,7 @@ NodeIterator NodeStorage::end() const {
 int NodeStorage::reserveNodePosition(int nodeId) {
 	int nodePosition = mesh.addNode(nodeId, RESERVED_POSITION, RESERVED_POSITION,
 			RESERVED_POSITION);
-	nodepositionById[nodeId] = nodePosition;
+	nodepositionById.set(nodeId, nodePosition);
 	if (this->logLevel >= LogLevel::TRACE) {
 		cout << "Reserve node id:" << nodeId << " position:" << nodePosition << endl;
 	}
@@ -78,10 +129,19 @@ CellData::CellData(int id, const CellType& type, bool isvirtual, int elementId,
 }
 
 bool NodeStorage::validate() const {
+	const vector<vector<size_t>> undefinedPositionsByChunk = parallelChunks<vector<size_t>>(nodeDatas.size(),
+			[this](size_t begin, size_t end) {
+		vector<size_t> undefinedPositions;
+		for (size_t i = begin; i < end; ++i) {
+			if (nodeDatas[i].id == Node::UNAVAILABLE_NODE) {
+				undefinedPositions.push_back(i);
+			}
+		}
+		return undefinedPositions;
+	}, 1 << 16);
 	bool validNodes = true;
-	for (size_t i = 0; i < nodeDatas.size(); ++i) {
-		const NodeData &nodeData = nodeDatas[i];
-		if (nodeData.id == Node::UNAVAILABLE_NODE) {
+	for (const auto& undefinedPositions : undefinedPositionsByChunk) {
+		for (size_t i : undefinedPositions) {
 			validNodes = false;
 			cerr << "Node in position " << i << " has been reserved, but never defined" << endl;
 		}
@@ -92,6 +152,27 @@ bool NodeStorage::validate() const {
 	return validNodes;
 }
 
+bool CellStorage::validate() const {
+	const vector<vector<size_t>> undefinedPositionsByChunk = parallelChunks<vector<size_t>>(cellDatas.size(),
+			[this](size_t begin, size_t end) {
+		vector<size_t> undefinedPositions;
+		for (size_t i = begin; i < end; ++i) {
+			if (cellDatas[i].id == Cell::UNAVAILABLE_CELL) {
+				undefinedPositions.push_back(i);
+			}
+		}
+		return undefinedPositions;
+	}, 1 << 16);
+	bool validCells = true;
+	for (const auto& undefinedPositions : undefinedPositionsByChunk) {
+		for (size_t i : undefinedPositions) {
+			validCells = false;
+			cerr << "Cell in position " << i << " has been reserved, but never defined" << endl;
+		}
+	}
+	return validCells;
+}
+
 /******************************************************************************
  * Mesh class
  ******************************************************************************/
@@ -109,6 +190,7 @@ Mesh::Mesh(LogLevel logLevel, const string& modelName) :
 }
 
 int Mesh::addNode(int id, double x, double y, double z, int cpPos, int cdPos) {
+	revisionCount++;
 	int nodePosition;
 
 	// In auto mode, we assign the first free node, starting from the biggest possible number
@@ -118,14 +200,13 @@ int Mesh::addNode(int id, double x, double y, double z, int cpPos, int cdPos) {
 			id = Node::auto_node_id--;
 		}
 	}
-	auto positionIterator = nodes.nodepositionById.find(id);
-	if (positionIterator == nodes.nodepositionById.end()) {
+	nodePosition = nodes.nodepositionById.find(id);
+	if (nodePosition == PositionIndex::UNAVAILABLE_POSITION) {
 		nodePosition = static_cast<int>(nodes.nodeDatas.size());
 		NodeData nodeData(id, DOFS::NO_DOFS, x, y, z, cpPos, cdPos);
 		nodes.nodeDatas.push_back(nodeData);
-		nodes.nodepositionById[id] = nodePosition;
+		nodes.nodepositionById.set(id, nodePosition);
 	} else {
-		nodePosition = positionIterator->second;
 		NodeData& nodeData = nodes.nodeDatas[nodePosition];
 		nodeData.x = x;
 		nodeData.y = y;
@@ -141,6 +222,37 @@ int Mesh::countNodes() const {
 	return static_cast<int>(nodes.nodeDatas.size());
 }
 
+void Mesh::reserveNodes(int nodeCount, int minId, int maxId) {
+	if (nodeCount <= 0) {
+		return;
+	}
+	nodes.nodeDatas.reserve(static_cast<size_t>(nodeCount));
+	nodes.nodepositionById.reserve(static_cast<size_t>(nodeCount), minId, maxId);
+	if (this->logLevel >= LogLevel::DEBUG) {
+		cout << "Reserved " << nodeCount << " nodes, "
+				<< (nodes.nodepositionById.isDense() ? "dense" : "hashed") << " id index." << endl;
+	}
+}
+
+void Mesh::reserveCells(const map<CellType::Code, int>& cellCountByType, int minId, int maxId) {
+	int cellCount = 0;
+	for (const auto& countByType : cellCountByType) {
+		const CellType* cellType = CellType::findByCode(countByType.first);
+		const size_t count = static_cast<size_t>(countByType.second);
+		cellPositionsByType[*cellType].reserve(count);
+		cellCount += countByType.second;
+	}
+	if (cellCount <= 0) {
+		return;
+	}
+	cells.cellDatas.reserve(static_cast<size_t>(cellCount));
+	cells.cellpositionById.reserve(static_cast<size_t>(cellCount), minId, maxId);
+	if (this->logLevel >= LogLevel::DEBUG) {
+		cout << "Reserved " << cellCount << " cells, "
+				<< (cells.cellpositionById.isDense() ? "dense" : "hashed") << " id index." << endl;
+	}
+}
+
 const Node Mesh::findNode(const int nodePosition) const {
 	if (nodePosition == Node::UNAVAILABLE_NODE) {
 		throw invalid_argument(
@@ -195,11 +307,11 @@ int Mesh::findNodeId(const int nodePosition) const {
 }
 
 int Mesh::findNodePosition(const int nodeId) const {
-	auto positionIterator = this->nodes.nodepositionById.find(nodeId);
-	if (positionIterator == this->nodes.nodepositionById.end()) {
+	const int nodePosition = this->nodes.nodepositionById.find(nodeId);
+	if (nodePosition == PositionIndex::UNAVAILABLE_POSITION) {
 		return Node::UNAVAILABLE_NODE;
 	}
-	return positionIterator->second;
+	return nodePosition;
 }
 
 void Mesh::allowDOFS(int nodePosition, const DOFS& allowed) {
@@ -207,8 +319,52 @@ void Mesh::allowDOFS(int nodePosition, const DOFS& allowed) {
 			| allowed);
 }
 
+DOFS Mesh::findNodeDOFS(int nodePosition) const {
+	return DOFS(nodes.nodeDatas[nodePosition].dofs);
+}
+
+vector<int> Mesh::addPointCells(const vector<int>& nodePositions, bool virtualCell) {
+	return addCells(CellType::POINT1, nodePositions, virtualCell);
+}
+
+vector<int> Mesh::addCells(const CellType& cellType, const vector<int>& nodePositions, bool virtualCell) {
+	revisionCount++;
+	const size_t numNodes = cellType.numNodes;
+	if (numNodes == 0 or nodePositions.size() % numNodes != 0) {
+		throw invalid_argument(string("Connectivity of ") + lexical_cast<string>(nodePositions.size())
+				+ " nodes does not match cells of type " + cellType.description);
+	}
+	const size_t cellCount = nodePositions.size() / numNodes;
+	vector<int> cellIds;
+	cellIds.reserve(cellCount);
+	vector<int>& cellPositions = cellPositionsByType.find(cellType)->second;
+	cellPositions.reserve(cellPositions.size() + cellCount);
+	cells.cellDatas.reserve(cells.cellDatas.size() + cellCount);
+	auto it = cells.nodepositionsByCelltype.find(cellType);
+	if (it == cells.nodepositionsByCelltype.end()) {
+		it = cells.nodepositionsByCelltype.insert(make_pair(cellType, make_shared<deque<int>>())).first;
+	}
+	deque<int>& typeNodePositions = *(it->second);
+	typeNodePositions.insert(typeNodePositions.end(), nodePositions.begin(), nodePositions.end());
+	for (size_t i = 0; i < cellCount; i++) {
+		// Same automatic ids as addCell
+		int cellId = Cell::auto_cell_id--;
+		while (findCellPosition(cellId) != Cell::UNAVAILABLE_CELL) {
+			cellId = Cell::auto_cell_id--;
+		}
+		const int cellPosition = static_cast<int>(cells.cellDatas.size());
+		cells.cellpositionById.set(cellId, cellPosition);
+		const int cellTypePosition = static_cast<int>(cellPositions.size());
+		cellPositions.push_back(cellPosition);
+		cells.cellDatas.push_back(CellData(cellId, cellType, virtualCell, Cell::UNAVAILABLE_CELL, cellTypePosition));
+		cellIds.push_back(cellId);
+	}
+	return cellIds;
+}
+
 int Mesh::addCell(int id, const CellType &cellType, const std::vector<int> &nodeIds,
 		bool virtualCell, const int cpos, int elementId) {
+	revisionCount++;
 	int cellId;
 	const int cellPosition = static_cast<int>(cells.cellDatas.size());
 
@@ -236,7 +392,7 @@ int Mesh::addCell(int id, const CellType &cellType, const std::vector<int> &node
 					string("Duplicate node in connectivity cellId:")
 							+ lexical_cast<string>(cellId));
 		}
-		if (cells.cellpositionById.find(cellId) != cells.cellpositionById.end()) {
+		if (cells.cellpositionById.find(cellId) != PositionIndex::UNAVAILABLE_POSITION) {
 			throw logic_error(
 					string("CellId: ") + lexical_cast<string>(cellId) + " Already used.");
 		}
@@ -247,7 +403,7 @@ int Mesh::addCell(int id, const CellType &cellType, const std::vector<int> &node
 		throw logic_error("Invalid cell");
 	}
 
-	cells.cellpositionById[cellId] = cellPosition;
+	cells.cellpositionById.set(cellId, cellPosition);
 	const int cellTypePosition = static_cast<int>(cellPositionsByType.find(cellType)->second.size());
 	cellPositionsByType.find(cellType)->second.push_back(cellPosition);
 	CellData cellData(cellId, cellType, virtualCell, elementId, cellTypePosition);
@@ -271,6 +427,7 @@ int Mesh::addCell(int id, const CellType &cellType, const std::vector<int> &node
 
 int Mesh::updateCell(int id, const CellType &cellType, const std::vector<int> &nodeIds,
         bool virtualCell, const int cpos, int elementId) {
+    revisionCount++;
 
     if (id == Cell::AUTO_ID) {
         throw invalid_argument("Can't update a cell with AUTO_ID.");
@@ -306,7 +463,7 @@ int Mesh::updateCell(int id, const CellType &cellType, const std::vector<int> &n
     // We build another CellData, with an other cellPosition, and hope
     // for the best
     const int cellPosition = static_cast<int>(cells.cellDatas.size());
-    cells.cellpositionById[id] = cellPosition;
+    cells.cellpositionById.set(id, cellPosition);
 
     const int cellTypePosition = static_cast<int>(cellPositionsByType.find(cellType)->second.size());
     cellPositionsByType.find(cellType)->second.push_back(cellPosition);
@@ -353,6 +510,63 @@ const Cell Mesh::findCell(int cellPosition) const {
 	return Cell(cellData.id, *type, nodeIds, nodePositions, false, cellData.csPos, cellData.elementId, cellData.cellTypePosition);
 }
 
+vector<int> Mesh::gatherNodePositions(const vector<int>& cellIds) const {
+	vector<vector<int>> nodePositionsByChunk = parallelChunks<vector<int>>(cellIds.size(),
+			[this, &cellIds](size_t begin, size_t end) {
+		vector<int> nodePositions;
+		for (size_t i = begin; i < end; i++) {
+			const int cellPosition = findCellPosition(cellIds[i]);
+			if (cellPosition == Cell::UNAVAILABLE_CELL) {
+				throw logic_error("Unavailable cell requested.");
+			}
+			const CellData& cellData = cells.cellDatas[cellPosition];
+			const CellType* type = CellType::findByCode(cellData.typeCode);
+			const deque<int>& typeNodePositions = *(cells.nodepositionsByCelltype.find(*type)->second);
+			const int numNodes = static_cast<int>(type->numNodes);
+			const auto start = typeNodePositions.begin() + cellData.cellTypePosition * numNodes;
+			nodePositions.insert(nodePositions.end(), start, start + numNodes);
+		}
+		sort(nodePositions.begin(), nodePositions.end());
+		nodePositions.erase(unique(nodePositions.begin(), nodePositions.end()), nodePositions.end());
+		return nodePositions;
+	});
+	if (nodePositionsByChunk.size() == 1) {
+		return move(nodePositionsByChunk[0]);
+	}
+	vector<int> nodePositions;
+	for (const auto& chunkNodePositions : nodePositionsByChunk) {
+		const auto middle = nodePositions.insert(nodePositions.end(), chunkNodePositions.begin(), chunkNodePositions.end());
+		inplace_merge(nodePositions.begin(), middle, nodePositions.end());
+	}
+	nodePositions.erase(unique(nodePositions.begin(), nodePositions.end()), nodePositions.end());
+	return nodePositions;
+}
+
+void Mesh::visitCells(const set<int>& cellIds,
+		const function<void(int cellId, const CellType& type, const vector<int>& nodeIds)>& visitor) const {
+	const CellType* lastType = nullptr;
+	const deque<int>* typeNodePositions = nullptr;
+	vector<int> nodeIds;
+	for (int cellId : cellIds) {
+		const int cellPosition = findCellPosition(cellId);
+		if (cellPosition == Cell::UNAVAILABLE_CELL) {
+			throw logic_error("Unavailable cell requested.");
+		}
+		const CellData& cellData = cells.cellDatas[cellPosition];
+		const CellType* type = CellType::findByCode(cellData.typeCode);
+		if (type != lastType) {
+			typeNodePositions = cells.nodepositionsByCelltype.find(*type)->second.get();
+			lastType = type;
+		}
+		const unsigned int numNodes = type->numNodes;
+		nodeIds.resize(numNodes);
+		const auto start = typeNodePositions->begin() + cellData.cellTypePosition * static_cast<int>(numNodes);
+		for (unsigned int i = 0; i < numNodes; i++) {
+			nodeIds[i] = nodes.nodeDatas[static_cast<size_t>(start[i])].id;
+		}
+		visitor(cellData.id, *type, nodeIds);
+	}
+}
 
 void Mesh::createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
 		const vector<Family>& families) {
@@ -371,6 +585,17 @@ void Mesh::createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
 	}
 }
 
+void Mesh::writeMEDBlockFilter(med_idt fid, int nentity, int nconstituent, int blockStart, int blockEnd,
+		med_filter& filter) {
+	// MED entities are numbered from 1, a block is written as a single stride of blockEnd - blockStart entities
+	if (MEDfilterBlockOfEntityCr(fid, nentity, 1, nconstituent, MED_ALL_CONSTITUENT, MED_FULL_INTERLACE,
+			MED_COMPACT_STMODE, MED_ALLENTITIES_PROFILE, static_cast<med_size>(blockStart + 1),
+			static_cast<med_size>(blockEnd - blockStart), 1, static_cast<med_size>(blockEnd - blockStart), 0,
+			&filter) < 0) {
+		throw logic_error("ERROR : creating MED block filter ...");
+	}
+}
+
 void Mesh::writeMED(const Model& model, const char* medFileName) {
 	if (!finished) {
 		this->finish();
@@ -389,6 +614,27 @@ void Mesh::writeMED(const Model& model, const char* medFileName) {
 		cout << "Num cells : " << this->countCells() << endl;
 	}
 
+	// Families only depend on the groups: they are computed by another thread while this one
+	// writes the coordinates and connectivities (the MED library is not thread safe).
+	const vector<shared_ptr<NodeGroup>> nodeGroups = getNodeGroups();
+	future<shared_ptr<NodeGroup2Families>> nodeFamilies = async(launch::async, [this, &nodeGroups]() {
+		return nodeGroups.empty() ? nullptr : make_shared<NodeGroup2Families>(countNodes(), nodeGroups);
+	});
+	const vector<shared_ptr<CellGroup>> cellGroups = getCellGroups();
+	future<shared_ptr<CellGroup2Families>> cellFamilies = async(launch::async, [this, &cellGroups]() {
+		if (cellGroups.empty()) {
+			return shared_ptr<CellGroup2Families>();
+		}
+		unordered_map<CellType::Code, int, EnumClassHash> cellCountByType;
+		for (auto typeAndCodePair : CellType::typeByCode) {
+			int cellNum = this->countCells(*typeAndCodePair.second);
+			if (cellNum > 0) {
+				cellCountByType[typeAndCodePair.first] = cellNum;
+			}
+		}
+		return make_shared<CellGroup2Families>(*this, cellCountByType, cellGroups);
+	});
+
 	/* open MED file */
 	med_idt fid = MEDfileOpen(medFileName, MED_ACC_CREAT);
 	if (fid < 0) {
@@ -400,25 +646,36 @@ void Mesh::writeMED(const Model& model, const char* medFileName) {
 			MED_SORT_DTIT, MED_CARTESIAN, axisname, unitname) < 0) {
 		throw logic_error("ERROR : Mesh creation ...");
 	}
+	// Coordinates and connectivities are written by blocks of MED_WRITE_BLOCK_SIZE entities, so
+	// that the temporary buffers stay small whatever the size of the mesh.
 	vector<med_float> coordinates;
-	coordinates.reserve(nnodes);
-	for (NodeData& nodeData : nodes.nodeDatas) {
-	    if (nodeData.cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
-            coordinates.push_back(nodeData.x);
-            coordinates.push_back(nodeData.y);
-            coordinates.push_back(nodeData.z);
-	    } else {
-	        shared_ptr<CoordinateSystem> coordSystem = model.mesh->getCoordinateSystemByPosition(nodeData.cpPos);
-            VectorialValue gCoord = coordSystem->positionToGlobal(VectorialValue(nodeData.x,nodeData.y,nodeData.z));
-            coordinates.push_back(gCoord.x());
-            coordinates.push_back(gCoord.y());
-            coordinates.push_back(gCoord.z());
-	    }
-	}
-	if (MEDmeshNodeCoordinateWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, MED_FULL_INTERLACE,
-			nnodes, coordinates.data()) < 0) {
-		throw logic_error("ERROR : writing nodes ...");
+	coordinates.reserve(3 * static_cast<size_t>(min(nnodes, MED_WRITE_BLOCK_SIZE)));
+	for (int blockStart = 0; blockStart < nnodes; blockStart += MED_WRITE_BLOCK_SIZE) {
+		const int blockEnd = min(nnodes, blockStart + MED_WRITE_BLOCK_SIZE);
+		coordinates.clear();
+		for (int nodePosition = blockStart; nodePosition < blockEnd; nodePosition++) {
+			const NodeData& nodeData = nodes.nodeDatas[nodePosition];
+			if (nodeData.cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+				coordinates.push_back(nodeData.x);
+				coordinates.push_back(nodeData.y);
+				coordinates.push_back(nodeData.z);
+			} else {
+				shared_ptr<CoordinateSystem> coordSystem = model.mesh->getCoordinateSystemByPosition(nodeData.cpPos);
+				VectorialValue gCoord = coordSystem->positionToGlobal(VectorialValue(nodeData.x,nodeData.y,nodeData.z));
+				coordinates.push_back(gCoord.x());
+				coordinates.push_back(gCoord.y());
+				coordinates.push_back(gCoord.z());
+			}
+		}
+		med_filter filter = MED_FILTER_INIT;
+		writeMEDBlockFilter(fid, nnodes, 3, blockStart, blockEnd, filter);
+		if (MEDmeshNodeCoordinateAdvancedWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, &filter,
+				coordinates.data()) < 0) {
+			throw logic_error("ERROR : writing nodes ...");
+		}
+		MEDfilterClose(&filter);
 	}
+	vector<med_float>().swap(coordinates);
 
 	/*char* nodeNames = new char[nodes.countNodes()*MED_SNAME_SIZE+1]();
 
@@ -430,28 +687,32 @@ void Mesh::writeMED(const Model& model, const char* medFileName) {
 	 nodes.countNodes(), nodeNames);
 	 delete[](nodeNames);*/
 
-	for (auto kv : cellPositionsByType) {
-		CellType type = kv.first;
-		vector<int> cellPositions = kv.second;
-		size_t numCells = cellPositions.size();
+	vector<med_int> connectivity;
+	for (const auto& kv : cellPositionsByType) {
+		const CellType& type = kv.first;
+		const int numCells = static_cast<int>(kv.second.size());
 		if (type.numNodes == 0 || numCells == 0) {
 			continue;
 		}
-		vector<med_int> connectivity;
-		connectivity.reserve(numCells * type.numNodes);
-		for (int cellPosition : cellPositions) {
-			const Cell&& cell = findCell(cellPosition);
-			for (int nodePosition : cell.nodePositions) {
+		// Node positions are stored contiguously by type, in the same order as cellPositionsByType
+		const deque<int>& nodePositions = *(cells.nodepositionsByCelltype.find(type)->second);
+		const int numNodes = static_cast<int>(type.numNodes);
+		connectivity.reserve(static_cast<size_t>(min(numCells, MED_WRITE_BLOCK_SIZE) * numNodes));
+		for (int blockStart = 0; blockStart < numCells; blockStart += MED_WRITE_BLOCK_SIZE) {
+			const int blockEnd = min(numCells, blockStart + MED_WRITE_BLOCK_SIZE);
+			connectivity.clear();
+			for (auto it = nodePositions.begin() + blockStart * numNodes;
+					it != nodePositions.begin() + blockEnd * numNodes; ++it) {
 				// med nodes starts at node number 1.
-				connectivity.push_back(nodePosition + 1);
+				connectivity.push_back(*it + 1);
 			}
-		}
-		int result = MEDmeshElementConnectivityWr(fid, meshname, MED_NO_DT,
-		MED_NO_IT, 0.0, MED_CELL, static_cast<int>(type.code), MED_NODAL, MED_FULL_INTERLACE,
-				static_cast<med_int>(numCells),
-				connectivity.data());
-		if (result < 0) {
-			throw logic_error("ERROR : writing cells ...");
+			med_filter filter = MED_FILTER_INIT;
+			writeMEDBlockFilter(fid, numCells, numNodes, blockStart, blockEnd, filter);
+			if (MEDmeshElementConnectivityAdvancedWr(fid, meshname, MED_NO_DT, MED_NO_IT, 0.0, MED_CELL,
+					static_cast<int>(type.code), MED_NODAL, &filter, connectivity.data()) < 0) {
+				throw logic_error("ERROR : writing cells ...");
+			}
+			MEDfilterClose(&filter);
 		}
 
 		/*		 char* cellNames = new char[numCells*MED_SNAME_SIZE+1]();
@@ -474,36 +735,28 @@ void Mesh::writeMED(const Model& model, const char* medFileName) {
 		 throw logic_error("ERROR : writing cell names ...");
 		 }*/
 	}
+	vector<med_int>().swap(connectivity);
 
 	if (MEDfamilyCr(fid, meshname, MED_NO_NAME, 0, 0, MED_NO_GROUP) < 0) {
 		throw logic_error("ERROR : writing family 0 ...");
 	}
 
-	vector<shared_ptr<NodeGroup>> nodeGroups = getNodeGroups();
-	if (nodeGroups.size() > 0) {
-		NodeGroup2Families ng2fam(countNodes(), nodeGroups);
+	const shared_ptr<NodeGroup2Families> ng2fam = nodeFamilies.get();
+	if (ng2fam != nullptr) {
 		//WARN: if writing to file is delayed to MEDfileClose may be necessary
 		//to move the allocation outside the if
-		auto& families = ng2fam.getFamilies();
+		auto& families = ng2fam->getFamilies();
 		createFamilies(fid, meshname, families);
 		//write family number for nodes
 		if (MEDmeshEntityFamilyNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_NODE, MED_NONE,
-				nnodes, ng2fam.getFamilyOnNodes().data()) < 0) {
+				nnodes, ng2fam->getFamilyOnNodes().data()) < 0) {
 			throw logic_error("ERROR : writing family on nodes ...");
 		}
 	}
-	vector<shared_ptr<CellGroup>> cellGroups = this->getCellGroups();
-	if (cellGroups.size() > 0) {
-		unordered_map<CellType::Code, int, EnumClassHash> cellCountByType;
-		for (auto typeAndCodePair : CellType::typeByCode) {
-			int cellNum = this->countCells(*typeAndCodePair.second);
-			if (cellNum > 0) {
-				cellCountByType[typeAndCodePair.first] = cellNum;
-			}
-		}
-		CellGroup2Families cellGroup2Family = CellGroup2Families(*this, cellCountByType, cellGroups);
-		createFamilies(fid, meshname, cellGroup2Family.getFamilies());
-		for (auto cellCodeFamilyVectorPair : cellGroup2Family.getFamilyOnCells()) {
+	const shared_ptr<CellGroup2Families> cellGroup2Family = cellFamilies.get();
+	if (cellGroup2Family != nullptr) {
+		createFamilies(fid, meshname, cellGroup2Family->getFamilies());
+		for (auto cellCodeFamilyVectorPair : cellGroup2Family->getFamilyOnCells()) {
 			int ncells = static_cast<int>(cellCodeFamilyVectorPair.second->size());
 			if (MEDmeshEntityFamilyNumberWr(fid, meshname, MED_NO_DT, MED_NO_IT, MED_CELL,
 					static_cast<int>(cellCodeFamilyVectorPair.first), ncells, cellCodeFamilyVectorPair.second->data())
@@ -528,11 +781,64 @@ void Mesh::writeMED(const Model& model, const char* medFileName) {
 	}
 }
 
+uint64_t Mesh::contentHash() const {
+	ContentHash hash;
+	// The MED library writes its own version of the format
+	med_int medVersion[3];
+	MEDlibraryNumVersion(&medVersion[0], &medVersion[1], &medVersion[2]);
+	hash.add(static_cast<long long>(medVersion[0])).add(static_cast<long long>(medVersion[1]))
+			.add(static_cast<long long>(medVersion[2]));
+	hash.add(this->name);
+	hash.add(this->countNodes());
+	for (const NodeData& nodeData : nodes.nodeDatas) {
+		hash.add(nodeData.id);
+		if (nodeData.cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+			hash.add(nodeData.x).add(nodeData.y).add(nodeData.z);
+		} else {
+			VectorialValue gCoord = getCoordinateSystemByPosition(nodeData.cpPos)->positionToGlobal(
+					VectorialValue(nodeData.x, nodeData.y, nodeData.z));
+			hash.add(gCoord.x()).add(gCoord.y()).add(gCoord.z());
+		}
+	}
+	for (const auto& kv : cellPositionsByType) {
+		const CellType& type = kv.first;
+		if (type.numNodes == 0 || kv.second.empty()) {
+			continue;
+		}
+		hash.add(static_cast<int>(type.code));
+		const deque<int>& nodePositions = *(cells.nodepositionsByCelltype.find(type)->second);
+		hash.add(static_cast<long long>(nodePositions.size()));
+		for (int nodePosition : nodePositions) {
+			hash.add(nodePosition);
+		}
+	}
+	// The families are computed per cell type, from the cell positions of the groups
+	for (const CellData& cellData : cells.cellDatas) {
+		hash.add(cellData.id).add(static_cast<int>(cellData.typeCode)).add(cellData.cellTypePosition);
+	}
+	for (const auto& nodeGroup : getNodeGroups()) {
+		hash.add(nodeGroup->getName());
+		hash.add(static_cast<long long>(nodeGroup->nodePositions().size()));
+		for (int nodePosition : nodeGroup->nodePositions()) {
+			hash.add(nodePosition);
+		}
+	}
+	for (const auto& cellGroup : getCellGroups()) {
+		hash.add(cellGroup->getName());
+		const vector<int> cellPositions = cellGroup->cellPositions();
+		hash.add(static_cast<long long>(cellPositions.size()));
+		for (int cellPosition : cellPositions) {
+			hash.add(cellPosition);
+		}
+	}
+	return hash.getValue();
+}
+
 shared_ptr<CellGroup> Mesh::getOrCreateCellGroupForCS(int cid){
 	shared_ptr<CellGroup> result;
 	auto cellGroupNameIter = cellGroupNameByCID.find(cid);
 	if (cellGroupNameIter != cellGroupNameByCID.end()) {
-		string cellGroupName = cellGroupNameIter->second;
+		const string& cellGroupName = cellGroupNameIter->second;
 		result = dynamic_pointer_cast<CellGroup>(findGroup(cellGroupName));
 	} else {
 		string gmaName;
@@ -549,6 +855,7 @@ shared_ptr<CellGroup> Mesh::getOrCreateCellGroupForCS(int cid){
 }
 
 void Mesh::add(const CoordinateSystem& coordinateSystem) {
+  revisionCount++;
   if (this->logLevel >= LogLevel::DEBUG) {
       cout << "Adding " << coordinateSystem << endl;
   }
@@ -629,10 +936,11 @@ void Mesh::finish() {
 }
 
 shared_ptr<NodeGroup> Mesh::createNodeGroup(const string& name, int group_id, const string & comment) {
+	revisionCount++;
 	if (name.empty()) {
 		throw invalid_argument("Can't create a nodeGroup with empty name ");
 	}
-	if (this->groupByName.find(name) != this->groupByName.end()) {
+	if (this->groupByName.find(symbols.find(name)) != this->groupByName.end()) {
 		throw invalid_argument("Another group exists with same name : " + name);
 	}
 	if (group_id != NodeGroup::NO_ORIGINAL_ID
@@ -644,7 +952,7 @@ shared_ptr<NodeGroup> Mesh::createNodeGroup(const string& name, int group_id, co
 		throw invalid_argument(errorMessage);
 	}
 	shared_ptr<NodeGroup> group = shared_ptr<NodeGroup>(new NodeGroup(*this, name, group_id, comment));
-	this->groupByName[name] = group;
+	this->groupByName[group->name] = group;
 	if (group_id != NodeGroup::NO_ORIGINAL_ID) {
 		this->groupById[group_id] = group;
 	}
@@ -671,10 +979,11 @@ shared_ptr<NodeGroup> Mesh::findOrCreateNodeGroup(const string& name, int group_
 }
 
 shared_ptr<CellGroup> Mesh::createCellGroup(const string& name, int group_id, const string & comment) {
+	revisionCount++;
 	if (name.empty()) {
 		throw invalid_argument("Can't create a cellGroup with empty name.");
 	}
-	if (this->groupByName.find(name) != this->groupByName.end()) {
+	if (this->groupByName.find(symbols.find(name)) != this->groupByName.end()) {
 		throw invalid_argument("Another group exists with same name: " + name);
 	}
 	if (group_id != CellGroup::NO_ORIGINAL_ID
@@ -686,7 +995,7 @@ shared_ptr<CellGroup> Mesh::createCellGroup(const string& name, int group_id, co
 		throw invalid_argument(errorMessage);
 	}
 	shared_ptr<CellGroup> group= shared_ptr<CellGroup>(new CellGroup(*this, name, group_id, comment));
-	this->groupByName[name] = group;
+	this->groupByName[group->name] = group;
 	if (group_id != CellGroup::NO_ORIGINAL_ID) {
 		this->groupById[group_id] = group;
 	}
@@ -698,22 +1007,23 @@ shared_ptr<CellGroup> Mesh::createCellGroup(const string& name, int group_id, co
 }
 
 void Mesh::renameGroup(const string& oldname, const string& newname, const string& comment) {
+    revisionCount++;
     if (oldname.empty()) {
         throw invalid_argument("Can't rename a group with empty oldname.");
     }
     if (newname.empty()) {
         throw invalid_argument("Can't rename a group with empty newname.");
     }
-    const auto & it = this->groupByName.find(oldname);
+    const auto & it = this->groupByName.find(symbols.find(oldname));
     if (it == this->groupByName.end()) {
         throw invalid_argument("No group exists with this name: " + oldname);
     }
 
     shared_ptr<Group> group = it->second;
-    group->name = newname;
-    group->comment = comment;
+    group->name = symbols.intern(newname);
+    group->comment = symbols.intern(comment);
     this->groupByName.erase(it);
-    this->groupByName[newname] = group;
+    this->groupByName[group->name] = group;
 
 
     if (this->logLevel >= LogLevel::DEBUG) {
@@ -722,11 +1032,11 @@ void Mesh::renameGroup(const string& oldname, const string& newname, const strin
 }
 
 void Mesh::removeGroup(const string& name) {
-
-    auto it = this->groupByName.find(name);
+    revisionCount++;
+    auto it = this->groupByName.find(symbols.find(name));
     if (it != this->groupByName.end()) {
         std::shared_ptr<Group> group = it->second;
-        this->groupByName.erase(name);
+        this->groupByName.erase(it);
         const int gId= group->getId();
         if (gId!= Group::NO_ORIGINAL_ID){
             this->groupById.erase(gId);
@@ -746,6 +1056,10 @@ vector<shared_ptr<NodeGroup>> Mesh::getNodeGroups() const {
 		}
 		groups.push_back(dynamic_pointer_cast<NodeGroup>(group));
 	}
+	// Groups are returned sorted by name, whatever the order of the index
+	sort(groups.begin(), groups.end(), [](const shared_ptr<NodeGroup>& left, const shared_ptr<NodeGroup>& right) {
+		return left->getName() < right->getName();
+	});
 	return groups;
 }
 
@@ -758,10 +1072,15 @@ vector<shared_ptr<CellGroup>> Mesh::getCellGroups() const {
 		}
 		groups.push_back(dynamic_pointer_cast<CellGroup>(group));
 	}
+	// Groups are returned sorted by name, whatever the order of the index
+	sort(groups.begin(), groups.end(), [](const shared_ptr<CellGroup>& left, const shared_ptr<CellGroup>& right) {
+		return left->getName() < right->getName();
+	});
 	return groups;
 }
 
 void Mesh::assignElementId(const CellContainer& cellContainer, int elementId) {
+	revisionCount++;
 	for (int cellId : cellContainer.getCellIds(true)) {
 		int cellPosition = findCellPosition(cellId);
 		CellData& cellData = cells.cellDatas[cellPosition];
@@ -770,7 +1089,7 @@ void Mesh::assignElementId(const CellContainer& cellContainer, int elementId) {
 }
 
 shared_ptr<Group> Mesh::findGroup(string groupName) const {
-	auto groupIterator = groupByName.find(groupName);
+	auto groupIterator = groupByName.find(symbols.find(groupName));
 	if (groupIterator == groupByName.end())
 		return nullptr;
 	return groupIterator->second;
@@ -794,21 +1113,20 @@ int Mesh::countCells(const CellType& type) const {
 }
 
 bool Mesh::hasCell(int cellId) const {
-	auto positionIterator =
-			cells.cellpositionById.find(cellId);
-	return positionIterator != cells.cellpositionById.end();
+	return cells.cellpositionById.find(cellId) != PositionIndex::UNAVAILABLE_POSITION;
 }
 
 int Mesh::findCellPosition(int cellId) const {
-	auto it = this->cells.cellpositionById.find(cellId);
-	if (it == this->cells.cellpositionById.end()) {
+	const int cellPosition = this->cells.cellpositionById.find(cellId);
+	if (cellPosition == PositionIndex::UNAVAILABLE_POSITION) {
 		return Cell::UNAVAILABLE_CELL;
 	}
-	return it->second;
+	return cellPosition;
 }
 
 bool Mesh::validate() const {
-	return nodes.validate();
+	const bool validNodes = nodes.validate();
+	return cells.validate() && validNodes;
 }
 
 } /* namespace vega */
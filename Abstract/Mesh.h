@@ -12,6 +12,8 @@
 #define MESH_H_
 
 #include <array>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <stdexcept>
 #include <boost/range.hpp>
@@ -29,6 +31,38 @@
 namespace vega {
 
 class Mesh;
+class MeshStream;
+
+/**
+ * Index from input model ids to Vega positions.
+ * By default ids are kept in a map. When the input solver knows in advance that ids are
+ * compact (see reserve()), the ids of the reserved range are kept in a dense array, and
+ * only the ids outside this range fall back to the map.
+ */
+class PositionIndex final {
+private:
+	std::map<int, int> positionBySparseId;
+	std::vector<int> positionByDenseId;
+	int denseMinId = 0;
+	size_t denseCount = 0;
+public:
+	static const int UNAVAILABLE_POSITION = INT_MIN;
+	/**
+	 * Returns the position associated with this id, UNAVAILABLE_POSITION if not found.
+	 */
+	int find(int id) const;
+	void set(int id, int position);
+	size_t size() const;
+	/**
+	 * Prepare the index for count ids expected between minId and maxId.
+	 * A dense array is chosen only if these ids fill at least half of the range.
+	 * Does nothing if the index is not empty.
+	 */
+	void reserve(size_t count, int minId, int maxId);
+	bool isDense() const {
+		return !positionByDenseId.empty();
+	}
+};
 
 class NodeData final {
 public:
@@ -49,7 +83,7 @@ private:
 
 	const LogLevel logLevel;
 	std::vector<NodeData> nodeDatas;
-	std::map<int, int> nodepositionById;
+	PositionIndex nodepositionById;
 	/**
 	 * Reserve a node position (VEGA Id) given a node id (input model id).
 	 * WARNING! Reserving an already created node will erase the previous value
@@ -83,10 +117,11 @@ private:
 	friend Mesh;
 	friend NodeGroup;
 	friend CellGroup;
+	friend CellGroup2Families;
 
 	const LogLevel logLevel;
 	std::vector<CellData> cellDatas;
-	std::map<int, int> cellpositionById;
+	PositionIndex cellpositionById;
 	std::map<CellType, std::shared_ptr<std::deque<int>>> nodepositionsByCelltype;
 	/*
 	 * Reserve a cell position given an id
@@ -107,16 +142,19 @@ private:
 	friend NodeIterator;
 	friend CellIterator;
 	//access flag debug on model
+	friend NodeGroup;
 	friend CellGroup;
 	friend CoordinateSystemStorage;
+	friend MeshStream;
 	const LogLevel logLevel;
 	const std::string name;
 	bool finished;
+	size_t revisionCount = 0;
 
 	//mapping position->external id
 	std::map<CellType, std::vector<int>> cellPositionsByType;
 
-	std::map<std::string, std::shared_ptr<Group>> groupByName;
+	std::unordered_map<Symbol, std::shared_ptr<Group>, SymbolHash> groupByName;
 
 	/**
 	 * Groups ordered by the id provided by the input solver. Since inputSolver may not provide
@@ -125,13 +163,24 @@ private:
 	std::map<int, std::shared_ptr<Group>> groupById;
 
 	std::shared_ptr<CellGroup> getOrCreateCellGroupForCS(const int cid);
-	void createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
+	static void createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
 			const std::vector<Family>& families);
+	/**
+	 * Number of entities (nodes or cells of a type) written to MED at once.
+	 */
+	static const int MED_WRITE_BLOCK_SIZE = 1 << 16;
+	/**
+	 * Create the MED filter selecting entities [blockStart, blockEnd[ (Vega positions) out of nentity,
+	 * each one having nconstituent values in a compact, full interlace, buffer.
+	 */
+	static void writeMEDBlockFilter(med_idt fid, int nentity, int nconstituent, int blockStart, int blockEnd,
+			med_filter& filter);
 public:
 
 	std::map<int, std::string> cellGroupNameByCID;
 	std::map<int, std::string> cellGroupNameByMaterialOrientationTimes100;
 	Mesh(LogLevel logLevel, const std::string& name);
+	SymbolTable symbols; /**< Interned names and comments of the groups **/
 	NodeStorage nodes;
 	CellStorage cells;
 	CoordinateSystemStorage coordinateSystemStorage; /**< Container for Coordinate System numerotations. **/
@@ -182,7 +231,21 @@ public:
 	        int cpPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID,
 	        int cdPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
 	int countNodes() const;
+	/**
+	 * Pre-allocate storage for nodeCount nodes with ids between minId and maxId, as counted
+	 * by the input solver before the actual parsing. Must be called before any addNode.
+	 */
+	void reserveNodes(int nodeCount, int minId, int maxId);
+	/**
+	 * Pre-allocate storage for cells with ids between minId and maxId, knowing the expected
+	 * count of cells of each type. Must be called before any addCell.
+	 */
+	void reserveCells(const std::map<CellType::Code, int>& cellCountByType, int minId, int maxId);
 	void allowDOFS(int nodePosition, const DOFS& allowed);
+	/**
+	 * DOFS currently allowed on a node, given its Vega position.
+	 */
+	DOFS findNodeDOFS(int nodePosition) const;
 	/**
 	 * Find a node from its Vega position.
 	 * throws invalid_argument if node not found
@@ -222,8 +285,48 @@ public:
 	 **/
     int updateCell(int id, const CellType &type, const std::vector<int> &nodesIds,
             bool virtualCell = false, const int cpos=CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, int elementId = Cell::UNAVAILABLE_CELL);
+    /**
+     * Add one POINT1 cell, with an automatic id, on each of the given node positions.
+     * Faster than addCell for many cells, as nodes are already known by position.
+     * Returns the ids of the new cells, in the same order.
+     */
+    std::vector<int> addPointCells(const std::vector<int>& nodePositions, bool virtualCell = false);
+    /**
+     * Add cells of the given type, with automatic ids, all at once. nodePositions holds the
+     * Vega positions of the nodes of each cell, one cell after the other.
+     * Returns the ids of the new cells, in the same order.
+     */
+    std::vector<int> addCells(const CellType& cellType, const std::vector<int>& nodePositions,
+            bool virtualCell = false);
     int findCellPosition(int cellId) const;
 	const Cell findCell(int cellPosition) const;
+	/**
+	 * Sorted and unique positions of the nodes of some cells, gathered (concurrently for many cells)
+	 * straight from the connectivity of each cell type, without building the Cell objects.
+	 * Throws logic_error if a cell is not found.
+	 */
+	std::vector<int> gatherNodePositions(const std::vector<int>& cellIds) const;
+	/**
+	 * Calls visitor on each of the given cells, in order, with the ids of its nodes read straight
+	 * from the connectivity of its cell type, without building the Cell objects.
+	 * Throws logic_error if a cell is not found.
+	 */
+	void visitCells(const std::set<int>& cellIds,
+			const std::function<void(int cellId, const CellType& type, const std::vector<int>& nodeIds)>& visitor) const;
+	/**
+	 * Changes each time a cell is added or updated: caches built from the cells connectivity
+	 * keep it to know when they are outdated.
+	 */
+	size_t cellsVersion() const {
+		return cells.cellDatas.size();
+	}
+	/**
+	 * Changes each time nodes, cells, groups or coordinate systems are added, updated or
+	 * removed, directly or through a group: Model::finish() uses it to know if the mesh was edited.
+	 */
+	size_t revision() const {
+		return revisionCount;
+	}
 	bool hasCell(int cellId) const;
 
 	/**
@@ -233,6 +336,11 @@ public:
 	void assignElementId(const CellContainer&, int elementId);
 
 	void writeMED(const Model& model, const char* medFileName);
+	/**
+	 * Hash of everything written by writeMED(): nodes, cells, groups. Two meshes having the same
+	 * hash give the same MED file.
+	 */
+	uint64_t contentHash() const;
 	void finish();
 	bool validate() const;
 	Mesh(const Mesh& that) = delete;
@@ -238,16 +238,16 @@ const CellType CellType::polyType(unsigned int nbNodes) {
 }
 
 Group::Group(Mesh& mesh, const string& name, Type type, int _id, const string& comment) :
-                Identifiable(_id), mesh(mesh), name(name), type(type), comment(comment) {
+                Identifiable(_id), mesh(mesh), name(mesh.symbols.intern(name)), comment(mesh.symbols.intern(comment)), type(type) {
     isUseful=false;
 }
 
 const string& Group::getName() const {
-	return this->name;
+	return this->name.str();
 }
 
 const string& Group::getComment() const {
-	return this->comment;
+	return this->comment.str();
 }
 
 Group::~Group() {
@@ -261,19 +261,30 @@ NodeGroup::NodeGroup(Mesh& mesh, const string& name, int groupId, const string&
 }
 
 void NodeGroup::addNodeId(int nodeId) {
+	mesh.revisionCount++;
 	int nodePosition = this->mesh.findOrReserveNode(nodeId);
 	_nodePositions.insert(nodePosition);
 }
 
+void NodeGroup::addNodeIds(const IntervalList& nodeIds) {
+	mesh.revisionCount++;
+	for (int nodeId : nodeIds) {
+		_nodePositions.insert(_nodePositions.end(), this->mesh.findOrReserveNode(nodeId));
+	}
+}
+
 void NodeGroup::addNode(const Node& node) {
+	mesh.revisionCount++;
 	_nodePositions.insert(node.position);
 }
 
 void NodeGroup::addNodeByPosition(int nodePosition) {
+	mesh.revisionCount++;
 	_nodePositions.insert(nodePosition);
 }
 
 void NodeGroup::removeNodeByPosition(int nodePosition) {
+	mesh.revisionCount++;
 	if (_nodePositions.find(nodePosition) == _nodePositions.end()) {
 		throw logic_error("Node position not present : " + to_string(nodePosition));
 	}
@@ -287,7 +298,7 @@ void NodeGroup::removeNodeByPosition(int nodePosition) {
 	}
 }
 
-const std::set<int> NodeGroup::nodePositions() const {
+const std::set<int>& NodeGroup::nodePositions() const {
 	return _nodePositions;
 }
 
@@ -317,7 +328,18 @@ CellGroup::CellGroup(Mesh& mesh, const string& name, int groupId, const string&
 }
 
 void CellGroup::addCellId(int cellId) {
+	mesh.revisionCount++;
 	this->cellIds.insert(cellId);
+	cachedNodePositionsVersion = 0;
+}
+
+void CellGroup::addCellIds(const IntervalList& cellIds) {
+	mesh.revisionCount++;
+	// Ids inside intervals are sorted: the hint makes each insertion constant time
+	for (int cellId : cellIds) {
+		this->cellIds.insert(this->cellIds.end(), cellId);
+	}
+	cachedNodePositionsVersion = 0;
 }
 
 const vector<Cell> CellGroup::getCells() {
@@ -337,14 +359,15 @@ const vector<int> CellGroup::cellPositions() {
 	return result;
 }
 
-const set<int> CellGroup::nodePositions() const {
-	set<int> result;
-	for (int cellId : cellIds) {
-		int position = mesh.findCellPosition(cellId);
-		const Cell& cell = mesh.findCell(position);
-		result.insert(cell.nodePositions.begin(), cell.nodePositions.end());
+const set<int>& CellGroup::nodePositions() const {
+	lock_guard<mutex> lock(nodePositionsMutex);
+	if (cachedNodePositionsVersion != mesh.cellsVersion() or cachedNodePositionsVersion == 0) {
+		const vector<int> nodePositions = mesh.gatherNodePositions(vector<int>(cellIds.begin(), cellIds.end()));
+		// Sorted input: linear construction
+		cachedNodePositions = set<int>(nodePositions.begin(), nodePositions.end());
+		cachedNodePositionsVersion = mesh.cellsVersion();
 	}
-	return result;
+	return cachedNodePositions;
 }
 
 bool CellGroup::empty() const {
@@ -599,6 +622,10 @@ void NodeContainer::addNodeId(int nodeId) {
 	nodeIds.insert(nodeId);
 }
 
+void NodeContainer::addNodeIds(const IntervalList& nodeIds) {
+	nodeIdIntervals.append(nodeIds);
+}
+
 void NodeContainer::addNodeGroup(const string& groupName) {
 	shared_ptr<Group> group = mesh.findGroup(groupName);
 	if (group == nullptr) {
@@ -619,6 +646,7 @@ void NodeContainer::add(const NodeContainer& nodeContainer) {
 	if (nodeContainer.nodeIds.size() > 0) {
 		this->nodeIds.insert(nodeContainer.nodeIds.begin(), nodeContainer.nodeIds.end());
 	}
+	nodeIdIntervals.append(nodeContainer.nodeIdIntervals);
 
 	if (nodeContainer.groupNames.size() > 0) {
 		this->groupNames.insert(nodeContainer.groupNames.begin(), nodeContainer.groupNames.end());
@@ -627,6 +655,14 @@ void NodeContainer::add(const NodeContainer& nodeContainer) {
 
 const vector<int> NodeContainer::getNodeIds(bool all) const {
 	vector<int> nodes(nodeIds.begin(), nodeIds.end());
+	if (!nodeIdIntervals.empty()) {
+		unordered_set<int> addedIds(nodeIds);
+		for (int nodeId : nodeIdIntervals) {
+			if (addedIds.insert(nodeId).second) {
+				nodes.push_back(nodeId);
+			}
+		}
+	}
 	if (all) {
 		for (string groupName : groupNames) {
 			shared_ptr<NodeGroup> group = dynamic_pointer_cast<NodeGroup>(mesh.findGroup(groupName));
@@ -643,20 +679,24 @@ const set<int> NodeContainer::nodePositions() const {
 	for (int nodeId : nodeIds) {
 		result.insert(mesh.findNodePosition(nodeId));
 	}
+	for (int nodeId : nodeIdIntervals) {
+		result.insert(mesh.findNodePosition(nodeId));
+	}
 	return result;
 }
 
 bool NodeContainer::empty() const {
-	return groupNames.empty() && nodeIds.empty();
+	return groupNames.empty() && nodeIds.empty() && nodeIdIntervals.empty();
 }
 
 void NodeContainer::clear() {
 	groupNames.clear();
 	nodeIds.clear();
+	nodeIdIntervals = IntervalList();
 }
 
 bool NodeContainer::hasNodes() const {
-	return !nodeIds.empty();
+	return !nodeIds.empty() || !nodeIdIntervals.empty();
 }
 
 bool NodeContainer::hasNodeGroups() const {
@@ -727,7 +767,7 @@ const vector<int> CellContainer::getCellIds(bool all) const {
 		for (string groupName : groupNames) {
 			shared_ptr<CellGroup> group = dynamic_pointer_cast<CellGroup>(mesh.findGroup(groupName));
 			if (group != nullptr) {
-				cells.insert(cells.end(), group->cellIds.begin(), group->cellIds.end());
+				cells.insert(cells.end(), group->getCellIds().begin(), group->getCellIds().end());
 			}
 		}
 	}
@@ -735,9 +775,14 @@ const vector<int> CellContainer::getCellIds(bool all) const {
 }
 
 const set<int> CellContainer::nodePositions() const {
-	set<int> result;
-	for (Cell cell : getCells(true)) {
-		result.insert(cell.nodePositions.begin(), cell.nodePositions.end());
+	const vector<int> nodePositions = mesh.gatherNodePositions(vector<int>(cellIds.begin(), cellIds.end()));
+	set<int> result(nodePositions.begin(), nodePositions.end());
+	for (const string& groupName : groupNames) {
+		shared_ptr<CellGroup> group = dynamic_pointer_cast<CellGroup>(mesh.findGroup(groupName));
+		if (group != nullptr) {
+			const set<int>& groupNodePositions = group->nodePositions();
+			result.insert(groupNodePositions.begin(), groupNodePositions.end());
+		}
 	}
 	return result;
 }
@@ -854,9 +899,10 @@ CellGroup2Families::CellGroup2Families(
 	for (auto& cellGroup : cellGroups) {
 		newFamilyByOldfamily.clear();
 		for (auto cellPosition : cellGroup->cellPositions()) {
-			const Cell&& cell = mesh.findCell(cellPosition);
-			shared_ptr<vector<int>> currentCellFamilies = cellFamiliesByType[cell.type.code];
-			int oldFamilyId = currentCellFamilies->at(cell.cellTypePosition);
+			// Only the type and position by type are needed here: avoid building the whole Cell
+			const CellData& cellData = mesh.cells.cellDatas[cellPosition];
+			shared_ptr<vector<int>> currentCellFamilies = cellFamiliesByType[cellData.typeCode];
+			int oldFamilyId = currentCellFamilies->at(cellData.cellTypePosition);
 			auto newFamilyPair = newFamilyByOldfamily.find(oldFamilyId);
 			int newFamilyId;
 			if (newFamilyPair == newFamilyByOldfamily.end()) {
@@ -882,7 +928,7 @@ CellGroup2Families::CellGroup2Families(
 			} else {
 				newFamilyId = newFamilyPair->second;
 			}
-			currentCellFamilies->at(cell.cellTypePosition) = newFamilyId;
+			currentCellFamilies->at(cellData.cellTypePosition) = newFamilyId;
 		}
 	}
 
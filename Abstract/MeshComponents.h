@@ -28,6 +28,8 @@
 #include "Dof.h"
 #include <boost/lexical_cast.hpp>
 #include <vector>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
@@ -224,15 +226,19 @@ protected:
     friend Mesh;
     Group(Mesh& mesh, const std::string& name, Type, int id = NO_ORIGINAL_ID, const std::string& comment=" ");
     Mesh& mesh;
-    std::string name;
+    Symbol name; ///< Interned in the symbol table of the mesh.
+    Symbol comment; ///< A comment string, usually use to retain the command which created the group.
 public:
     //const SpaceDimension dimension;
     Type type;
-    std::string comment; ///< A comment string, usually use to retain the command which created the group.
     bool isUseful; ///< A boolean that can be used by Writer to keep or discard group.
     const std::string& getName() const;
     const std::string& getComment() const;
-    virtual const std::set<int> nodePositions() const = 0;
+    /**
+     * Positions of the nodes of the group. The reference stays valid until the group, or the
+     * cells of the mesh, change.
+     */
+    virtual const std::set<int>& nodePositions() const = 0;
     virtual bool empty() const = 0;
     virtual ~Group();
     Group(const Group& that) = delete;
@@ -288,10 +294,12 @@ private:
 public:
     // Add a node using its numerical id. If the node hasn't been yet defined it reserve position in the model.
     void addNodeId(int nodeId);
+    // Add nodes using their numerical ids, iterating the intervals without building a list of ids.
+    void addNodeIds(const IntervalList& nodeIds);
     void addNode(const Node& node);
     void addNodeByPosition(int nodePosition);
     void removeNodeByPosition(int nodePosition);
-    const std::set<int> nodePositions() const override;
+    const std::set<int>& nodePositions() const override;
     bool empty() const override;
     const std::set<int> getNodeIds() const;
     const std::vector<Node> getNodes() const;
@@ -364,12 +372,23 @@ class CellGroup final: public Group {
 private:
     friend Mesh;
     CellGroup(Mesh& mesh, const std::string & name, int id = NO_ORIGINAL_ID, const std::string & comment = "");
-public:
     std::set<int> cellIds;
+    mutable std::mutex nodePositionsMutex;
+    mutable std::set<int> cachedNodePositions;
+    mutable size_t cachedNodePositionsVersion = 0; /**< Mesh::cellsVersion() of cachedNodePositions, 0 if outdated */
+public:
+    const std::set<int>& getCellIds() const {
+        return cellIds;
+    }
     void addCellId(int cellId);
+    void addCellIds(const IntervalList& cellIds);
     const std::vector<Cell> getCells();
     const std::vector<int> cellPositions();
-    const std::set<int> nodePositions() const override;
+    /**
+     * Gathered once from the mesh connectivity, then cached until a cell is added to
+     * the group or to the mesh.
+     */
+    const std::set<int>& nodePositions() const override;
     bool empty() const override;
     virtual ~CellGroup();
     CellGroup(const CellGroup& that) = delete;
@@ -430,11 +449,14 @@ class NodeContainer {
 protected:
     const Mesh& mesh;
     std::unordered_set<int> nodeIds;
+    // Node ids added in bulk, kept as intervals until the ids are actually requested
+    IntervalList nodeIdIntervals;
     std::unordered_set<std::string> groupNames;
 public:
     NodeContainer(const Mesh& mesh);
     // Adds a nodeId to the current set
     void addNodeId(int nodeId);
+    void addNodeIds(const IntervalList& nodeIds);
     void addNodeGroup(const std::string& groupName);
     void add(const Node& node);
     void add(const NodeGroup& nodeGroup);
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * MeshStream.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "MeshStream.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace vega {
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+const char MeshStream::MESH_NAME[MED_NAME_SIZE + 1] = "3D unstructured mesh";
+
+MeshStream::MeshStream(const string& medFileName, const string& meshDescription, const vector<int>& nodeIds,
+		LogLevel logLevel) :
+		medFileName(medFileName), logLevel(logLevel) {
+	if (!nodeIds.empty()) {
+		const auto minmax = minmax_element(nodeIds.begin(), nodeIds.end());
+		nodePositionById.reserve(nodeIds.size(), *minmax.first, *minmax.second);
+	}
+	for (int nodeId : nodeIds) {
+		if (nodePositionById.find(nodeId) == PositionIndex::UNAVAILABLE_POSITION) {
+			nodePositionById.set(nodeId, nodeCount++);
+		}
+	}
+	coordinates.reserve(3 * static_cast<size_t>(min(nodeCount, Mesh::MED_WRITE_BLOCK_SIZE)));
+
+	const med_int spacedim = 3;
+	const med_int meshdim = 3;
+	const char axisname[3 * MED_SNAME_SIZE + 1] = "x               y               z               ";
+	const char unitname[3 * MED_SNAME_SIZE + 1] = "m               m               m               ";
+	fid = MEDfileOpen(medFileName.c_str(), MED_ACC_CREAT);
+	if (fid < 0) {
+		throw logic_error("ERROR : MED file creation ...");
+	}
+	if (MEDmeshCr(fid, MESH_NAME, spacedim, meshdim, MED_UNSTRUCTURED_MESH, meshDescription.c_str(), "",
+			MED_SORT_DTIT, MED_CARTESIAN, axisname, unitname) < 0) {
+		MEDfileClose(fid);
+		throw logic_error("ERROR : Mesh creation ...");
+	}
+}
+
+MeshStream::~MeshStream() {
+	if (!closed && fid >= 0) {
+		MEDfileClose(fid);
+	}
+	removeTemporaryFiles();
+}
+
+void MeshStream::addNode(int id, double x, double y, double z, int cpPos) {
+	const int nodePosition = nodePositionById.find(id);
+	if (nodePosition == PositionIndex::UNAVAILABLE_POSITION) {
+		throw invalid_argument("Node " + to_string(id) + " not found by the first pass over the input.");
+	}
+	if (nodePosition < nextNodePosition) {
+		throw invalid_argument("Node " + to_string(id) + " defined twice.");
+	}
+	// The nodes not added (skipped because of an error) are left at the origin
+	while (nextNodePosition <= nodePosition) {
+		if (nextNodePosition == nodePosition && cpPos == CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+			coordinates.push_back(x);
+			coordinates.push_back(y);
+			coordinates.push_back(z);
+		} else {
+			coordinates.insert(coordinates.end(), 3, 0.0);
+		}
+		nextNodePosition++;
+		if (nextNodePosition - coordinatesBlockStart == Mesh::MED_WRITE_BLOCK_SIZE) {
+			writeCoordinates();
+		}
+	}
+	if (cpPos != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+		// Written again at close(), when the coordinate systems can be built
+		localNodes.push_back({nodePosition, x, y, z, cpPos});
+	}
+}
+
+void MeshStream::writeCoordinates() {
+	if (nextNodePosition == coordinatesBlockStart) {
+		return;
+	}
+	med_filter filter = MED_FILTER_INIT;
+	Mesh::writeMEDBlockFilter(fid, nodeCount, 3, coordinatesBlockStart, nextNodePosition, filter);
+	if (MEDmeshNodeCoordinateAdvancedWr(fid, MESH_NAME, MED_NO_DT, MED_NO_IT, 0.0, &filter,
+			coordinates.data()) < 0) {
+		throw logic_error("ERROR : writing nodes ...");
+	}
+	MEDfilterClose(&filter);
+	coordinates.clear();
+	coordinatesBlockStart = nextNodePosition;
+}
+
+void MeshStream::addCell(const CellType& cellType, const vector<int>& nodeIds,
+		const shared_ptr<CellGroup>& cellGroup) {
+	vector<med_int> connectivity;
+	connectivity.reserve(nodeIds.size());
+	for (int nodeId : nodeIds) {
+		const int nodePosition = nodePositionById.find(nodeId);
+		if (nodePosition == PositionIndex::UNAVAILABLE_POSITION) {
+			throw invalid_argument("Node " + to_string(nodeId) + " of a " + cellType.description + " not found.");
+		}
+		// med nodes starts at node number 1.
+		connectivity.push_back(nodePosition + 1);
+	}
+	CellTypeStream& cellTypeStream = cellTypeStreams[cellType.code];
+	if (cellTypeStream.file == nullptr) {
+		cellTypeStream.fileName = medFileName + "." + to_string(static_cast<int>(cellType.code)) + ".tmp";
+		cellTypeStream.file = unique_ptr<ofstream>(new ofstream(cellTypeStream.fileName,
+				ios::binary | ios::trunc | ios::out));
+		if (!cellTypeStream.file->is_open()) {
+			throw logic_error("Can't open file " + cellTypeStream.fileName + " for writing.");
+		}
+	}
+	cellTypeStream.file->write(reinterpret_cast<const char*>(connectivity.data()),
+			static_cast<streamsize>(connectivity.size() * sizeof(med_int)));
+	med_int family = 0;
+	if (cellGroup != nullptr) {
+		const auto& familyIt = familyByCellGroup.find(cellGroup.get());
+		if (familyIt == familyByCellGroup.end()) {
+			cellGroups.push_back(cellGroup);
+			family = -static_cast<med_int>(cellGroups.size());
+			familyByCellGroup[cellGroup.get()] = family;
+		} else {
+			family = familyIt->second;
+		}
+	}
+	cellTypeStream.families.push_back(family);
+}
+
+int MeshStream::countCells() const {
+	size_t cellCount = 0;
+	for (const auto& codeAndStream : cellTypeStreams) {
+		cellCount += codeAndStream.second.families.size();
+	}
+	return static_cast<int>(cellCount);
+}
+
+void MeshStream::writeLocalNodes(const Mesh& mesh) {
+	if (localNodes.empty()) {
+		return;
+	}
+	for (auto& coordinateSystemEntry : mesh.coordinateSystemStorage.coordinateSystemById) {
+		coordinateSystemEntry.second->build();
+	}
+	vector<med_int> nodeNumbers;
+	for (size_t blockStart = 0; blockStart < localNodes.size();
+			blockStart += static_cast<size_t>(Mesh::MED_WRITE_BLOCK_SIZE)) {
+		const size_t blockEnd = min(localNodes.size(), blockStart + static_cast<size_t>(Mesh::MED_WRITE_BLOCK_SIZE));
+		nodeNumbers.clear();
+		coordinates.clear();
+		for (size_t i = blockStart; i < blockEnd; i++) {
+			const LocalNode& localNode = localNodes[i];
+			shared_ptr<CoordinateSystem> coordSystem = mesh.getCoordinateSystemByPosition(localNode.cpPos);
+			if (coordSystem == nullptr) {
+				throw logic_error("ERROR : coordinate system of node number " + to_string(localNode.position + 1)
+						+ " not found ...");
+			}
+			VectorialValue gCoord = coordSystem->positionToGlobal(VectorialValue(localNode.x, localNode.y, localNode.z));
+			nodeNumbers.push_back(localNode.position + 1);
+			coordinates.push_back(gCoord.x());
+			coordinates.push_back(gCoord.y());
+			coordinates.push_back(gCoord.z());
+		}
+		med_filter filter = MED_FILTER_INIT;
+		if (MEDfilterEntityCr(fid, nodeCount, 1, 3, MED_ALL_CONSTITUENT, MED_FULL_INTERLACE, MED_COMPACT_STMODE,
+				MED_ALLENTITIES_PROFILE, static_cast<med_int>(nodeNumbers.size()), nodeNumbers.data(), &filter) < 0) {
+			throw logic_error("ERROR : creating MED filter ...");
+		}
+		if (MEDmeshNodeCoordinateAdvancedWr(fid, MESH_NAME, MED_NO_DT, MED_NO_IT, 0.0, &filter,
+				coordinates.data()) < 0) {
+			throw logic_error("ERROR : writing nodes ...");
+		}
+		MEDfilterClose(&filter);
+	}
+	vector<LocalNode>().swap(localNodes);
+}
+
+void MeshStream::writeCells() {
+	vector<med_int> connectivity;
+	for (auto& codeAndStream : cellTypeStreams) {
+		const CellType& cellType = *CellType::findByCode(codeAndStream.first);
+		CellTypeStream& cellTypeStream = codeAndStream.second;
+		const int numCells = static_cast<int>(cellTypeStream.families.size());
+		const int numNodes = static_cast<int>(cellType.numNodes);
+		cellTypeStream.file->close();
+		ifstream cellFile(cellTypeStream.fileName, ios::binary);
+		for (int blockStart = 0; blockStart < numCells; blockStart += Mesh::MED_WRITE_BLOCK_SIZE) {
+			const int blockEnd = min(numCells, blockStart + Mesh::MED_WRITE_BLOCK_SIZE);
+			connectivity.resize(static_cast<size_t>((blockEnd - blockStart) * numNodes));
+			if (!cellFile.read(reinterpret_cast<char*>(connectivity.data()),
+					static_cast<streamsize>(connectivity.size() * sizeof(med_int)))) {
+				throw logic_error("ERROR : reading " + cellTypeStream.fileName + " ...");
+			}
+			med_filter filter = MED_FILTER_INIT;
+			Mesh::writeMEDBlockFilter(fid, numCells, numNodes, blockStart, blockEnd, filter);
+			if (MEDmeshElementConnectivityAdvancedWr(fid, MESH_NAME, MED_NO_DT, MED_NO_IT, 0.0, MED_CELL,
+					static_cast<int>(cellType.code), MED_NODAL, &filter, connectivity.data()) < 0) {
+				throw logic_error("ERROR : writing cells ...");
+			}
+			MEDfilterClose(&filter);
+		}
+		cellFile.close();
+		fs::remove(cellTypeStream.fileName);
+		if (!cellGroups.empty() && MEDmeshEntityFamilyNumberWr(fid, MESH_NAME, MED_NO_DT, MED_NO_IT, MED_CELL,
+				static_cast<int>(cellType.code), numCells, cellTypeStream.families.data()) < 0) {
+			throw logic_error("ERROR : writing family on cells ...");
+		}
+		vector<med_int>().swap(cellTypeStream.families);
+	}
+}
+
+void MeshStream::close(const Mesh& mesh) {
+	// The nodes announced but never added are left at the origin
+	while (nextNodePosition < nodeCount) {
+		coordinates.insert(coordinates.end(), 3, 0.0);
+		nextNodePosition++;
+		if (nextNodePosition - coordinatesBlockStart == Mesh::MED_WRITE_BLOCK_SIZE) {
+			writeCoordinates();
+		}
+	}
+	writeCoordinates();
+	writeLocalNodes(mesh);
+	vector<med_float>().swap(coordinates);
+	writeCells();
+
+	if (MEDfamilyCr(fid, MESH_NAME, MED_NO_NAME, 0, 0, MED_NO_GROUP) < 0) {
+		throw logic_error("ERROR : writing family 0 ...");
+	}
+	vector<Family> families;
+	for (size_t i = 0; i < cellGroups.size(); i++) {
+		Family family;
+		family.groups.push_back(cellGroups[i]);
+		family.name = cellGroups[i]->getName();
+		family.num = -static_cast<int>(i + 1);
+		families.push_back(family);
+	}
+	Mesh::createFamilies(fid, MESH_NAME, families);
+	closed = true;
+	if (MEDfileClose(fid) < 0) {
+		throw logic_error("ERROR : closing med file ...");
+	}
+	if (logLevel >= LogLevel::DEBUG) {
+		cout << "File created : " << fs::absolute(medFileName) << " (" << nodeCount << " nodes, "
+				<< countCells() << " cells)" << endl;
+	}
+}
+
+void MeshStream::removeTemporaryFiles() {
+	for (auto& codeAndStream : cellTypeStreams) {
+		CellTypeStream& cellTypeStream = codeAndStream.second;
+		if (cellTypeStream.file != nullptr && cellTypeStream.file->is_open()) {
+			cellTypeStream.file->close();
+		}
+		boost::system::error_code error;
+		fs::remove(cellTypeStream.fileName, error);
+	}
+}
+
+} /* namespace vega */
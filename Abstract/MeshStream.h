@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * MeshStream.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef MESHSTREAM_H_
+#define MESHSTREAM_H_
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Mesh.h"
+
+namespace vega {
+
+/**
+ * Writes a mesh to a MED file while it is read, without building it in a Mesh.
+ *
+ * The ids of all the nodes, in their input order, must be known in advance (a first pass over the
+ * input gives them): node positions are then fixed and the coordinates are written to the MED file
+ * by blocks of Mesh::MED_WRITE_BLOCK_SIZE nodes, as they are read. Only the nodes located in a
+ * local coordinate system are kept, until close() builds the coordinate systems.
+ * The connectivity of each cell type is spilled to a temporary file next to the MED file, and
+ * copied to it by blocks at close(): one family number per cell is the only cell data kept in memory.
+ */
+class MeshStream final {
+private:
+	struct LocalNode {
+		int position;
+		double x;
+		double y;
+		double z;
+		int cpPos;
+	};
+	struct CellTypeStream {
+		std::string fileName;
+		std::unique_ptr<std::ofstream> file;
+		std::vector<med_int> families;
+	};
+	const std::string medFileName;
+	const LogLevel logLevel;
+	med_idt fid = -1;
+	bool closed = false;
+	PositionIndex nodePositionById;
+	int nodeCount = 0;
+	int nextNodePosition = 0;
+	int coordinatesBlockStart = 0;
+	std::vector<med_float> coordinates; /**< Coordinates of the nodes from coordinatesBlockStart **/
+	std::vector<LocalNode> localNodes;
+	std::map<CellType::Code, CellTypeStream> cellTypeStreams;
+	std::vector<std::shared_ptr<CellGroup>> cellGroups; /**< Group of the family -(i+1) **/
+	std::unordered_map<const CellGroup*, med_int> familyByCellGroup;
+	static const char MESH_NAME[MED_NAME_SIZE + 1];
+	void writeCoordinates();
+	void writeLocalNodes(const Mesh& mesh);
+	void writeCells();
+	void removeTemporaryFiles();
+public:
+	/**
+	 * Create the MED file medFileName and its mesh. nodeIds are the ids of all the nodes that will
+	 * be added, in the order they will be added: a repeated id is only counted once.
+	 */
+	MeshStream(const std::string& medFileName, const std::string& meshDescription,
+			const std::vector<int>& nodeIds, LogLevel logLevel = LogLevel::INFO);
+	MeshStream(const MeshStream&) = delete;
+	MeshStream& operator=(const MeshStream&) = delete;
+	/**
+	 * Close the MED file if close() was not called, and remove the temporary files.
+	 */
+	~MeshStream();
+	/**
+	 * Add a node in the coordinate system at position cpPos of the mesh given to close().
+	 * Throws invalid_argument if the id was not announced, or if it was already added.
+	 */
+	void addNode(int id, double x, double y, double z,
+			int cpPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
+	/**
+	 * Add a cell, in the cell group if not null. Throws invalid_argument if a node id was not announced.
+	 */
+	void addCell(const CellType& cellType, const std::vector<int>& nodeIds,
+			const std::shared_ptr<CellGroup>& cellGroup);
+	/**
+	 * Write the pending data: the nodes in local coordinate systems (taken from mesh), the cells,
+	 * the families of the cell groups. Then close the MED file.
+	 */
+	void close(const Mesh& mesh);
+	int countNodes() const {
+		return nodeCount;
+	}
+	int countCells() const;
+};
+
+} /* namespace vega */
+
+#endif /* MESHSTREAM_H_ */
@@ -51,6 +51,7 @@ void Model::Container<T>::add(shared_ptr<T> ptr) {
         throw runtime_error(oss.str());
     }
     by_id[ptr->getId()] = ptr;
+    by_id_by_type[ptr->type][ptr->getId()] = ptr;
     if (ptr->isOriginal())
         by_original_ids_by_type[ptr->type][ptr->getOriginalId()] = ptr;
 }
@@ -58,6 +59,7 @@ void Model::Container<T>::add(shared_ptr<T> ptr) {
 template<class T>
 void Model::Container<T>::erase(const Reference<T> ref) {
     by_id.erase(ref.id);
+    by_id_by_type[ref.type].erase(ref.id);
     if (ref.has_original_id())
         by_original_ids_by_type[ref.type].erase(ref.original_id);
 }
@@ -65,8 +67,10 @@ void Model::Container<T>::erase(const Reference<T> ref) {
 template<class T>
 const vector<shared_ptr<T>> Model::Container<T>::filter(const typename T::Type type) const {
     vector<shared_ptr<T>> result;
-    for (const auto& id_obj_pair: by_id) {
-        if (id_obj_pair.second->type == type) {
+    const auto& typeAndObjects = by_id_by_type.find(type);
+    if (typeAndObjects != by_id_by_type.end()) {
+        result.reserve(typeAndObjects->second.size());
+        for (const auto& id_obj_pair : typeAndObjects->second) {
             result.push_back(id_obj_pair.second);
         }
     }
@@ -103,6 +107,7 @@ void Model::Container<NamedValue>::add(const NamedValue& t) {
     }
     if (!t.isPlaceHolder()) {
         by_id[t.getId()] = ptr;
+        by_id_by_type[t.type][t.getId()] = ptr;
     }
     if (t.isOriginal()) {
         by_original_ids_by_type[t.type][t.getOriginalId()] = ptr;
@@ -157,22 +162,25 @@ shared_ptr<T> Model::Container<T>::get(int id) const {
 
 
 void Model::add(const Analysis& analysis) {
+    markDirty(ModelPass::ANALYSES);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << analysis << endl;
+        ModelPassManager::out() << "Adding " << analysis << endl;
     }
     analyses.add(analysis);
 }
 
 void Model::add(const Loading& loading) {
+    markDirty(ModelPass::LOADINGS);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << loading << endl;
+        ModelPassManager::out() << "Adding " << loading << endl;
     }
     loadings.add(loading);
 }
 
 void Model::add(const LoadSet& loadSet) {
+    markDirty(ModelPass::LOADINGS);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << loadSet << endl;
+        ModelPassManager::out() << "Adding " << loadSet << endl;
     }
     loadSets.add(loadSet);
 }
@@ -181,50 +189,56 @@ void Model::add(const LoadSet& loadSet) {
 // clone it, which does not keep the original id.
 //TODO: same type of "add" than the other ?
 void Model::add(const shared_ptr<Material> material) {
+    markDirty(ModelPass::MATERIALS);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << *material << endl;
+        ModelPassManager::out() << "Adding " << *material << endl;
     }
     materials.add(material);
 }
 
 void Model::add(const Constraint& constraint) {
+    markDirty(ModelPass::CONSTRAINTS);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << constraint << endl;
+        ModelPassManager::out() << "Adding " << constraint << endl;
     }
     constraints.add(constraint);
 }
 
 void Model::add(const ConstraintSet& constraintSet) {
+    markDirty(ModelPass::CONSTRAINTS);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << constraintSet << endl;
+        ModelPassManager::out() << "Adding " << constraintSet << endl;
     }
     constraintSets.add(constraintSet);
 }
 
 void Model::add(const Objective& objective) {
+    markDirty(ModelPass::OBJECTIVES);
     if (configuration.logLevel >= LogLevel::TRACE) {
-        cout << "Adding " << objective << endl;
+        ModelPassManager::out() << "Adding " << objective << endl;
     }
     objectives.add(objective);
 }
 
 void Model::add(const NamedValue& value) {
+    markDirty(ModelPass::VALUES);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << value << endl;
+        ModelPassManager::out() << "Adding " << value << endl;
     }
     values.add(value);
 }
 
 void Model::add(const ElementSet& elementSet) {
+    markDirty(ModelPass::ELEMENTS);
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << elementSet << endl;
+        ModelPassManager::out() << "Adding " << elementSet << endl;
     }
     elementSets.add(elementSet);
 }
 
 void Model::add(const Target& target) {
     if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Adding " << target << endl;
+        ModelPassManager::out() << "Adding " << target << endl;
     }
     targets.add(target);
 }
@@ -287,6 +301,7 @@ const vector<int> Model::getElementSetsId() const{
 
 template<>
 void Model::remove(const Reference<Constraint> constraintReference) {
+    markDirty(ModelPass::CONSTRAINTS);
     for (auto it : constraintReferences_by_constraintSet_ids) {
         for (auto it2 : it.second) {
             if (*it2 == constraintReference) {
@@ -311,6 +326,7 @@ void Model::remove(const Reference<Constraint> constraintReference) {
 }
 
 void Model::remove(const Reference<Constraint> refC, const int idCS, const int originalIdCS, const ConstraintSet::Type csT) {
+    markDirty(ModelPass::CONSTRAINTS);
 
     const auto & cR = constraintReferences_by_constraintSet_ids[idCS];
     for (auto it2 : cR) {
@@ -331,8 +347,38 @@ void Model::remove(const Reference<Constraint> refC, const int idCS, const int o
     constraints.erase(refC);
 }
 
+void Model::remove(const set<Reference<Constraint>>& refsC, const int idCS, const int originalIdCS, const ConstraintSet::Type csT) {
+    if (refsC.empty()) {
+        return;
+    }
+    markDirty(ModelPass::CONSTRAINTS);
+
+    auto& cR = constraintReferences_by_constraintSet_ids[idCS];
+    for (auto it2 = cR.begin(); it2 != cR.end();) {
+        if (refsC.find(**it2) != refsC.end()) {
+            it2 = cR.erase(it2);
+        } else {
+            ++it2;
+        }
+    }
+    if (originalIdCS!= Identifiable<ConstraintSet>::NO_ORIGINAL_ID){
+        auto& cR2 = constraintReferences_by_constraintSet_original_ids_by_constraintSet_type[csT][originalIdCS];
+        for (auto it3 = cR2.begin(); it3 != cR2.end();) {
+            if (refsC.find(**it3) != refsC.end()) {
+                it3 = cR2.erase(it3);
+            } else {
+                ++it3;
+            }
+        }
+    }
+    for (const auto& refC : refsC) {
+        constraints.erase(refC);
+    }
+}
+
 template<>
 void Model::remove(const Reference<Loading> loadingReference) {
+    markDirty(ModelPass::LOADINGS);
     for (auto it : loadingReferences_by_loadSet_ids) {
         for (auto it2 : it.second) {
             if (*it2 == loadingReference) {
@@ -357,11 +403,12 @@ void Model::remove(const Reference<Loading> loadingReference) {
 
 template<>
 void Model::remove(const Reference<LoadSet> loadSetReference) {
+    markDirty(ModelPass::LOADINGS);
     shared_ptr<LoadSet> loadSet = loadSets.find(loadSetReference);
     for (auto analysis : analyses) {
         if (analysis->contains(loadSetReference)) {
             if (configuration.logLevel >= LogLevel::DEBUG)
-                cout << "Disassociating empty " << *loadSet << " from " << *analysis << endl;
+                ModelPassManager::out() << "Disassociating empty " << *loadSet << " from " << *analysis << endl;
             analysis->remove(loadSetReference);
         }
     }
@@ -370,11 +417,12 @@ void Model::remove(const Reference<LoadSet> loadSetReference) {
 
 template<>
 void Model::remove(const Reference<ConstraintSet> constraintSetReference) {
+    markDirty(ModelPass::CONSTRAINTS);
     shared_ptr<ConstraintSet> constraintSet = constraintSets.find(constraintSetReference);
     for (auto analysis : analyses) {
         if (analysis->contains(constraintSetReference)) {
             if (configuration.logLevel >= LogLevel::DEBUG)
-                cout << "Disassociating empty " << *constraintSet << " from " << *analysis << endl;
+                ModelPassManager::out() << "Disassociating empty " << *constraintSet << " from " << *analysis << endl;
             analysis->remove(constraintSetReference);
         }
     }
@@ -383,12 +431,13 @@ void Model::remove(const Reference<ConstraintSet> constraintSetReference) {
 
 template<>
 void Model::remove(const Reference<Objective> objectiveReference) {
+    markDirty(ModelPass::OBJECTIVES | ModelPass::ANALYSES);
     shared_ptr<Objective> objective = objectives.find(objectiveReference);
     if (objective && objective->isAssertion()) {
         for (auto analysis : analyses) {
             if (analysis->contains(objectiveReference)) {
                 if (configuration.logLevel >= LogLevel::TRACE) {
-                    cout << "Disassociating dangling " << *objective << " from  " << *analysis
+                    ModelPassManager::out() << "Disassociating dangling " << *objective << " from  " << *analysis
                             << endl;
                 }
                 analysis->remove(objectiveReference);
@@ -463,6 +512,7 @@ const shared_ptr<Target> Model::find(const Reference<Target> reference) const {
 
 void Model::addLoadingIntoLoadSet(const Reference<Loading>& loadingReference,
         const Reference<LoadSet>& loadSetReference) {
+    markDirty(ModelPass::LOADINGS);
     shared_ptr<Reference<Loading>> loadingReference_ptr = loadingReference.clone();
     if (loadSetReference.has_id())
         loadingReferences_by_loadSet_ids[loadSetReference.id].insert(loadingReference_ptr);
@@ -493,10 +543,23 @@ shared_ptr<LoadSet> Model::getOrCreateLoadSet(int loadset_id, LoadSet::Type load
 
 const set<shared_ptr<Loading>> Model::getLoadingsByLoadSet(
         const Reference<LoadSet>& loadSetReference) const {
+    return findLoadingsByLoadSet(loadSetReference, nullptr);
+}
+
+const set<shared_ptr<Loading>> Model::getLoadingsByLoadSet(
+        const Reference<LoadSet>& loadSetReference, Loading::Type loadingType) const {
+    return findLoadingsByLoadSet(loadSetReference, &loadingType);
+}
+
+const set<shared_ptr<Loading>> Model::findLoadingsByLoadSet(
+        const Reference<LoadSet>& loadSetReference, const Loading::Type* loadingType) const {
     set<shared_ptr<Loading>> result;
     auto itm = loadingReferences_by_loadSet_ids.find(loadSetReference.id);
     if (itm != loadingReferences_by_loadSet_ids.end()) {
         for (auto itm2 : itm->second) {
+            if (loadingType != nullptr && itm2->type != *loadingType) {
+                continue;
+            }
             shared_ptr<Loading> loading = find(*itm2);
             assert(loading != nullptr);
             result.insert(loading);
@@ -508,6 +571,9 @@ const set<shared_ptr<Loading>> Model::getLoadingsByLoadSet(
         auto itm3 = itm2->second.find(loadSetReference.original_id);
         if (itm3 != itm2->second.end()) {
             for (auto itm4 : itm3->second) {
+                if (loadingType != nullptr && itm4->type != *loadingType) {
+                    continue;
+                }
                 shared_ptr<Loading> loading = find(*itm4);
                 assert(loading != nullptr);
                 result.insert(loading);
@@ -519,6 +585,7 @@ const set<shared_ptr<Loading>> Model::getLoadingsByLoadSet(
 
 void Model::addConstraintIntoConstraintSet(const Reference<Constraint>& constraintReference,
         const Reference<ConstraintSet>& constraintSetReference) {
+    markDirty(ModelPass::CONSTRAINTS);
     shared_ptr<Reference<Constraint>> constraintReference_ptr = constraintReference.clone();
     if (constraintSetReference.has_id())
         constraintReferences_by_constraintSet_ids[constraintSetReference.id].insert(
@@ -533,11 +600,23 @@ void Model::addConstraintIntoConstraintSet(const Reference<Constraint>& constrai
 
 const set<shared_ptr<Constraint>> Model::getConstraintsByConstraintSet(
         const Reference<ConstraintSet>& constraintSetReference) const {
+    return findConstraintsByConstraintSet(constraintSetReference, nullptr);
+}
+
+const set<shared_ptr<Constraint>> Model::getConstraintsByConstraintSet(
+        const Reference<ConstraintSet>& constraintSetReference, Constraint::Type constraintType) const {
+    return findConstraintsByConstraintSet(constraintSetReference, &constraintType);
+}
+
+const set<shared_ptr<Constraint>> Model::findConstraintsByConstraintSet(
+        const Reference<ConstraintSet>& constraintSetReference, const Constraint::Type* constraintType) const {
     set<shared_ptr<Constraint>> result;
     auto itm = constraintReferences_by_constraintSet_ids.find(constraintSetReference.id);
     if (itm != constraintReferences_by_constraintSet_ids.end()) {
         for (auto itm2 : itm->second) {
-            result.insert(find(*itm2));
+            if (constraintType == nullptr || itm2->type == *constraintType) {
+                result.insert(find(*itm2));
+            }
         }
     }
     auto itm2 = constraintReferences_by_constraintSet_original_ids_by_constraintSet_type.find(
@@ -546,7 +625,9 @@ const set<shared_ptr<Constraint>> Model::getConstraintsByConstraintSet(
         auto itm3 = itm2->second.find(constraintSetReference.original_id);
         if (itm3 != itm2->second.end()) {
             for (auto itm4 : itm3->second) {
-                result.insert(find(*itm4));
+                if (constraintType == nullptr || itm4->type == *constraintType) {
+                    result.insert(find(*itm4));
+                }
             }
         }
     }
@@ -670,84 +751,110 @@ const set<shared_ptr<LoadSet>> Model::getUncommonLoadSets() const {
 
 void Model::generateDiscrets() {
 
+    // DOFS required by the boundary conditions of each analysis, and missing on the nodes, in one sweep
+    const int nodeCount = mesh->countNodes();
+    vector<char> nodeDOFSByPosition(static_cast<size_t>(nodeCount));
+    for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+        nodeDOFSByPosition[static_cast<size_t>(nodePosition)] = mesh->findNodeDOFS(nodePosition);
+    }
+    vector<char> missingDOFSByPosition(static_cast<size_t>(nodeCount), DOFS::NO_DOFS);
+    for (const auto& analysis : analyses) {
+        for (const auto& positionAndDOFS : analysis->getBoundaryDOFSByNodePosition()) {
+            const size_t nodePosition = static_cast<size_t>(positionAndDOFS.first);
+            missingDOFSByPosition[nodePosition] = static_cast<char>(missingDOFSByPosition[nodePosition]
+                    | (positionAndDOFS.second & ~nodeDOFSByPosition[nodePosition]));
+        }
+    }
+
+    //extra dofs added by the DISCRET. They need to be blocked.
+    vector<char> addedDOFSByPosition(static_cast<size_t>(nodeCount), DOFS::NO_DOFS);
+    vector<int> discretNodePositions;
+    vector<bool> isRotationDiscret;
+    bool hasRotationDiscret = false;
+    bool hasTranslationDiscret = false;
+    for (int nodePosition = 0; nodePosition < nodeCount; nodePosition++) {
+        const DOFS missingDOFS(missingDOFSByPosition[static_cast<size_t>(nodePosition)]);
+        if (missingDOFS.size() == 0) {
+            continue;
+        }
+        const DOFS nodeDOFS(nodeDOFSByPosition[static_cast<size_t>(nodePosition)]);
+        const bool rotations = missingDOFS.containsAnyOf(DOFS::ROTATIONS);
+        const DOFS& discretDOFS = rotations ? DOFS::ALL_DOFS : DOFS::TRANSLATIONS;
+        addedDOFSByPosition[static_cast<size_t>(nodePosition)] = discretDOFS - nodeDOFS - missingDOFS;
+        mesh->allowDOFS(nodePosition, discretDOFS);
+        discretNodePositions.push_back(nodePosition);
+        isRotationDiscret.push_back(rotations);
+        hasRotationDiscret = hasRotationDiscret or rotations;
+        hasTranslationDiscret = hasTranslationDiscret or !rotations;
+    }
+
     //rigid constraints
     shared_ptr<CellGroup> virtualDiscretTRGroup = nullptr;
-
     shared_ptr<CellGroup> virtualDiscretTGroup = nullptr;
-
-    for (const Node& node : this->mesh->nodes) {
-        DOFS missingDOFS;
-
-        for (auto& analysis : analyses) {
-
-            const DOFS& requiredDOFS = analysis->findBoundaryDOFS(node.position);
-            if (!node.dofs.containsAll(requiredDOFS)) {
-                missingDOFS = missingDOFS + requiredDOFS - node.dofs;
-            }
+    if (hasRotationDiscret) {
+        DiscretePoint virtualDiscretTR(*this, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+        virtualDiscretTRGroup = mesh->createCellGroup("VDiscrTR");
+        virtualDiscretTR.assignCellGroup(virtualDiscretTRGroup);
+        if (this->configuration.addVirtualMaterial) {
+            virtualDiscretTR.assignMaterial(getVirtualMaterial());
+        }
+        this->add(virtualDiscretTR);
+    }
+    if (hasTranslationDiscret) {
+        DiscretePoint virtualDiscretT(*this, 0.0, 0.0, 0.0);
+        virtualDiscretTGroup = mesh->createCellGroup("VDiscrT");
+        virtualDiscretT.assignCellGroup(virtualDiscretTGroup);
+        if (this->configuration.addVirtualMaterial) {
+            virtualDiscretT.assignMaterial(getVirtualMaterial());
+        }
+        this->add(virtualDiscretT);
+    }
+    // Cells are created in node order, as before, to keep the same automatic ids
+    const vector<int>& cellIds = mesh->addPointCells(discretNodePositions, true);
+    for (size_t i = 0; i < cellIds.size(); i++) {
+        if (isRotationDiscret[i]) {
+            virtualDiscretTRGroup->addCellId(cellIds[i]);
+        } else {
+            virtualDiscretTGroup->addCellId(cellIds[i]);
         }
+    }
 
-        DOFS addedDOFS;
-        if (missingDOFS.size() != 0) {
-            if (missingDOFS.containsAnyOf(DOFS::ROTATIONS)) {
-                //extra dofs added by the DISCRET. They need to be blocked.
-                addedDOFS = DOFS::ALL_DOFS - node.dofs - missingDOFS;
-                if (virtualDiscretTRGroup == nullptr) {
-                    DiscretePoint virtualDiscretTR(*this, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
-                    virtualDiscretTRGroup = mesh->createCellGroup("VDiscrTR");
-                    virtualDiscretTR.assignCellGroup(virtualDiscretTRGroup);
-                    if (this->configuration.addVirtualMaterial) {
-                        virtualDiscretTR.assignMaterial(getVirtualMaterial());
-                    }
-                    this->add(virtualDiscretTR);
-                }
-                vector<int> cellNodes;
-                cellNodes.push_back(node.id);
-                mesh->allowDOFS(node.position, DOFS::ALL_DOFS);
-                int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::POINT1, cellNodes,
-                        true);
-                virtualDiscretTRGroup->addCellId(mesh->findCell(cellPosition).id);
-            } else {
-                addedDOFS = DOFS::TRANSLATIONS - node.dofs - missingDOFS;
-                if (virtualDiscretTGroup == nullptr) {
-                    DiscretePoint virtualDiscretT(*this, 0.0, 0.0, 0.0);
-                    virtualDiscretTGroup = mesh->createCellGroup("VDiscrT");
-                    virtualDiscretT.assignCellGroup(virtualDiscretTGroup);
-                    if (this->configuration.addVirtualMaterial) {
-                        virtualDiscretT.assignMaterial(getVirtualMaterial());
-                    }
-                    this->add(virtualDiscretT);
-                }
-                int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::POINT1, { node.id },
-                        true);
-                virtualDiscretTGroup->addCellId(mesh->findCell(cellPosition).id);
-                mesh->allowDOFS(node.position, DOFS::TRANSLATIONS);
+    // One SPC for each analysis and each combination of DOFS to be blocked, on a group of nodes
+    for (auto& analysis : analyses) {
+        map<char, shared_ptr<NodeGroup>> nodeGroupByExtraDOFS;
+        for (const auto& positionAndDOFS : analysis->getBoundaryDOFSByNodePosition()) {
+            const size_t nodePosition = static_cast<size_t>(positionAndDOFS.first);
+            const DOFS requiredDOFS(positionAndDOFS.second);
+            const DOFS nodeDOFS(nodeDOFSByPosition[nodePosition]);
+            if (nodeDOFS.containsAll(requiredDOFS)) {
+                continue;
             }
+            const DOFS& extraDOFS = DOFS(addedDOFSByPosition[nodePosition]) - requiredDOFS - nodeDOFS;
+            if (extraDOFS == DOFS::NO_DOFS) {
+                continue;
+            }
+            shared_ptr<NodeGroup>& nodeGroup = nodeGroupByExtraDOFS[extraDOFS];
+            if (nodeGroup == nullptr) {
+                nodeGroup = mesh->createNodeGroup("VSPC" + to_string(analysis->getId()) + "_"
+                        + to_string(static_cast<int>(extraDOFS)));
+            }
+            nodeGroup->addNodeByPosition(positionAndDOFS.first);
         }
-
-        for (auto& analysis : analyses) {
-            ConstraintSet* spcSet = nullptr;
-
-            const DOFS& requiredDOFS = analysis->findBoundaryDOFS(node.position);
-            if (!node.dofs.containsAll(requiredDOFS)) {
-                const DOFS& extraDOFS = addedDOFS - requiredDOFS - node.dofs;
-
-                if (extraDOFS != DOFS::NO_DOFS) {
-                    if (spcSet == nullptr) {
-                        spcSet = new ConstraintSet(*this, ConstraintSet::Type::SPC);
-                        add(*spcSet);
-                    }
-                    SinglePointConstraint spc = SinglePointConstraint(*this, extraDOFS);
-                    spc.addNodeId(node.id);
-                    add(spc);
-                    addConstraintIntoConstraintSet(spc, *spcSet);
-                    analysis->add(*spcSet);
-                    if (configuration.logLevel >= LogLevel::DEBUG) {
-                        cout << "Adding virtual spc on node: id: " << node.id << "for " << extraDOFS
-                                << endl;
-                    }
-                }
+        if (nodeGroupByExtraDOFS.empty()) {
+            continue;
+        }
+        ConstraintSet spcSet(*this, ConstraintSet::Type::SPC);
+        add(spcSet);
+        for (const auto& extraDOFSAndGroup : nodeGroupByExtraDOFS) {
+            SinglePointConstraint spc(*this, DOFS(extraDOFSAndGroup.first), 0, extraDOFSAndGroup.second);
+            add(spc);
+            addConstraintIntoConstraintSet(spc, spcSet);
+            if (configuration.logLevel >= LogLevel::DEBUG) {
+                ModelPassManager::out() << "Adding virtual spc on " << extraDOFSAndGroup.second->nodePositions().size()
+                        << " nodes for " << DOFS(extraDOFSAndGroup.first) << endl;
             }
         }
+        analysis->add(spcSet);
     }
 }
 
@@ -894,7 +1001,7 @@ void Model::emulateLocalDisplacementConstraint() {
                     coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
                     DOFS dofs = constraint->getDOFSForNode(nodePosition);
                     if (configuration.logLevel >= LogLevel::DEBUG)
-                        cout << "Replacing local spc" << *spc << "node:" << node << ",dofs " << constraint->getDOFSForNode(nodePosition) << endl;
+                        ModelPassManager::out() << "Replacing local spc" << *spc << "node:" << node << ",dofs " << constraint->getDOFSForNode(nodePosition) << endl;
                     for (int i = 0; i < 6; i++) {
                         vega::DOF currentDOF = *DOF::dofByPosition[i];
                         if (dofs.contains(currentDOF)) {
@@ -911,7 +1018,7 @@ void Model::emulateLocalDisplacementConstraint() {
                                         participation.y(), participation.z());
                             }
                             if (configuration.logLevel >= LogLevel::DEBUG)
-                                cout << "Node:" << node << ", current dof:" << currentDOF << ", participation:" << participation << ", coef:" << lmpc->coef_impo << endl;
+                                ModelPassManager::out() << "Node:" << node << ", current dof:" << currentDOF << ", participation:" << participation << ", coef:" << lmpc->coef_impo << endl;
                             linearMultiplePointConstraintsByConstraint[constraint].insert(lmpc);
                         }
                     }
@@ -1034,7 +1141,7 @@ void Model::generateBeamsToDisplayHomogeneousConstraint() {
 void Model::generateMaterialAssignments() {
     if (configuration.partitionModel) {
         if (this->material_assignment_by_material_id.size() > 0) {
-            cerr << "generateMaterialAssignments with PartitionModel is not "
+            ModelPassManager::err() << "generateMaterialAssignments with PartitionModel is not "
                     << " yet implemented. " << endl
                     << "This method should partition the elementSets"
                     << " and assign materials to elementSets. Useful if output=Nastran" << endl;
@@ -1068,7 +1175,7 @@ void Model::removeIneffectives() {
     }
     for (auto loading : loadingsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG)
-            cout << "Removed ineffective " << *loading << endl;
+            ModelPassManager::out() << "Removed ineffective " << *loading << endl;
         remove(Reference<Loading>(*loading));
     }
 
@@ -1081,7 +1188,7 @@ void Model::removeIneffectives() {
     }
     for (Reference<LoadSet> loadSetRef : loadSetSetsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG)
-            cout << "Removed empty loadset " << loadSetRef.id << endl;
+            ModelPassManager::out() << "Removed empty loadset " << loadSetRef.id << endl;
         remove(loadSetRef);
     }
 
@@ -1093,7 +1200,7 @@ void Model::removeIneffectives() {
     }
     for (auto constraint : constraintsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG)
-            cout << "Removed ineffective " << *constraint << endl;
+            ModelPassManager::out() << "Removed ineffective " << *constraint << endl;
         remove(Reference<Constraint>(*constraint));
     }
 
@@ -1106,19 +1213,19 @@ void Model::removeIneffectives() {
     }
     for (Reference<ConstraintSet> constraintSetRef : constraintSetSetsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG)
-            cout << "Removed empty " << constraintSetRef.id << endl;
+            ModelPassManager::out() << "Removed empty " << constraintSetRef.id << endl;
         remove(constraintSetRef);
     }
 
     // remove empty elementSets from the model
     vector<shared_ptr<ElementSet>> elementSetsToRemove;
     for (auto elementSet : elementSets) {
-        if (elementSet->cellGroup && elementSet->cellGroup->cellIds.size() == 0)
+        if (elementSet->cellGroup && elementSet->cellGroup->getCellIds().size() == 0)
             elementSetsToRemove.push_back(elementSet);
     }
     for (auto elementSet : elementSetsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG)
-            cout << "Removed empty " << *elementSet << endl;
+            ModelPassManager::out() << "Removed empty " << *elementSet << endl;
         this->elementSets.erase(Reference<ElementSet>(*elementSet));
     }
 }
@@ -1135,7 +1242,7 @@ void Model::removeUnassignedMaterials() {
     //}
     for (auto& material : materialsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG)
-            cout << "Removed unassigned " << *material << endl;
+            ModelPassManager::out() << "Removed unassigned " << *material << endl;
         this->materials.erase(Reference<Material>(*material));
     }
 }
@@ -1145,7 +1252,7 @@ void Model::replaceCombinedLoadSets() {
         for (auto& kv : loadSet->embedded_loadsets) {
             shared_ptr<LoadSet> otherloadSet = this->find(kv.first);
             if (!otherloadSet) {
-                cerr << "CombinedLoadSet: missing loadSet " << to_string(kv.first.id) << endl;
+                ModelPassManager::err() << "CombinedLoadSet: missing loadSet " << to_string(kv.first.id) << endl;
             }
             double coefficient = kv.second;
             for (shared_ptr<Loading> loading : otherloadSet->getLoadings()) {
@@ -1155,7 +1262,7 @@ void Model::replaceCombinedLoadSets() {
                 this->add(*newLoading);
                 this->addLoadingIntoLoadSet(*newLoading, *loadSet);
                 if (configuration.logLevel >= LogLevel::DEBUG) {
-                    cout << "Cloned " << *loading << " into " << *newLoading << " and scaled by "
+                    ModelPassManager::out() << "Cloned " << *loading << " into " << *newLoading << " and scaled by "
                             << coefficient << " and assigned to " << *loadSet << endl;
                 }
             }
@@ -1183,7 +1290,7 @@ void Model::removeAssertionsMissingDOFS()
     }
     for (auto objective : objectivesToRemove) {
         if (configuration.logLevel >= LogLevel::TRACE)
-            cout << "Removed ineffective " << *objective << endl;
+            ModelPassManager::out() << "Removed ineffective " << *objective << endl;
 
         remove(Reference<Objective>(*objective));
     }
@@ -1196,7 +1303,7 @@ void Model::addDefaultAnalysis()
         LinearMecaStat analysis(*this, "", 1);
         add(analysis);
         if (this->configuration.logLevel >= LogLevel::DEBUG) {
-            cout << "Default linear analysis added." << endl;
+            ModelPassManager::out() << "Default linear analysis added." << endl;
         }
     }
 }
@@ -1208,6 +1315,24 @@ void Model::replaceDirectMatrices()
     map<int, DOFS> addedDofsByNode;
     map<int, DOFS> requiredDofsByNode;
     map<int, DOFS> ownedDofsByNode;
+    bool hasMatrixElement = false;
+    for (const auto elementSetI : elementSets) {
+        hasMatrixElement = hasMatrixElement or elementSetI->isMatrixElement();
+    }
+    if (not hasMatrixElement) {
+        return;
+    }
+    // DOFS owned by each node through the cells of the elements, computed once for all the matrices
+    unordered_map<int, DOFS> ownedDofsByNodePosition;
+    for (const auto elementSetI : elementSets) {
+        if (elementSetI->cellGroup == nullptr) {
+            continue;
+        }
+        const DOFS cellDofs = (elementSetI->isBeam() or elementSetI->isShell()) ? DOFS::ALL_DOFS : DOFS::TRANSLATIONS;
+        for (int nodePosition : elementSetI->cellGroup->nodePositions()) {
+            ownedDofsByNodePosition[nodePosition] += cellDofs;
+        }
+    }
     for (auto elementSetM : elementSets) {
         if (!elementSetM->isMatrixElement()) {
             continue;
@@ -1215,42 +1340,21 @@ void Model::replaceDirectMatrices()
         shared_ptr<MatrixElement> matrix = dynamic_pointer_cast<MatrixElement>(elementSetM);
         for (int nodePosition : matrix->nodePositions()) {
             requiredDofsByNode[nodePosition] = DOFS();
-            const int nodeId = mesh->findNodeId(nodePosition);
-            DOFS owned;
-            for (const auto elementSetI : elementSets) {
-                if (elementSetI->cellGroup == nullptr) {
-                    continue;
-                }
-                for (const Cell& cell : elementSetI->cellGroup->getCells()) {
-                    for (int cellNodeId : cell.nodeIds) {
-                        if (cellNodeId == nodeId) {
-                            if (elementSetI->isBeam() or elementSetI->isShell()) {
-                                owned += DOFS::ALL_DOFS;
-                            } else {
-                                owned += DOFS::TRANSLATIONS;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-            ownedDofsByNode[nodePosition] = owned;
-        }
-        for (auto pair : matrix->nodePairs()) {
-            if (pair.first == pair.second) {
-                if (matrix->findInPairs(pair.first).size() != 0) {
-                    continue; // will be handled by a segment cell with another node
+            auto ownedIt = ownedDofsByNodePosition.find(nodePosition);
+            ownedDofsByNode[nodePosition] = ownedIt == ownedDofsByNodePosition.end() ? DOFS() : ownedIt->second;
+        }
+        const map<int, int>& offDiagonalBlocksByNode = matrix->countOffDiagonalBlocksByNode();
+        matrix->getBlocks().forEachBlock([&](const DOFBlock& block) {
+            if (block.rowNodePosition == block.columnNodePosition) {
+                if (offDiagonalBlocksByNode.find(block.rowNodePosition) != offDiagonalBlocksByNode.end()) {
+                    return; // will be handled by a segment cell with another node
                 }
                 // single node
-                int nodePosition = pair.first;
+                int nodePosition = block.rowNodePosition;
                 const int nodeId = mesh->findNodeId(nodePosition);
                 DOFS requiredDofs = requiredDofsByNode.find(nodePosition)->second;
-                shared_ptr<DOFMatrix> submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
                 DiscretePoint discrete(*this, {});
-                for (auto& kv : submatrix->componentByDofs) {
-                    double value = kv.second;
-                    const vega::DOF& dof1 = kv.first.first;
-                    const vega::DOF& dof2 = kv.first.second;
+                block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
                     if (!is_equal(value, 0)) {
                         switch (matrix->type) {
                         case ElementSet::Type::STIFFNESS_MATRIX:
@@ -1262,7 +1366,7 @@ void Model::replaceDirectMatrices()
                         requiredDofs += dof1;
                         requiredDofs += dof2;
                     }
-                }
+                });
                 if (configuration.addVirtualMaterial) {
                     discrete.assignMaterial(getVirtualMaterial());
                 }
@@ -1280,14 +1384,15 @@ void Model::replaceDirectMatrices()
                     mesh->allowDOFS(nodePosition, DOFS::TRANSLATIONS);
                 }
                 if (this->configuration.logLevel >= LogLevel::DEBUG) {
-                    cout << "Creating discrete : " << discrete << " over node id : "
+                    ModelPassManager::out() << "Creating discrete : " << discrete << " over node id : "
                             << to_string(nodeId) << endl;
                 }
                 this->add(discrete);
+                ownedDofsByNodePosition[nodePosition] += DOFS::TRANSLATIONS;
             } else {
                 // node couple
-                int rowNodePosition = pair.first;
-                int colNodePosition = pair.second;
+                int rowNodePosition = block.rowNodePosition;
+                int colNodePosition = block.columnNodePosition;
                 const int rowNodeId = mesh->findNodeId(rowNodePosition);
                 const int colNodeId = mesh->findNodeId(colNodePosition);
                 DOFS requiredRowDofs = requiredDofsByNode.find(rowNodePosition)->second;
@@ -1329,13 +1434,15 @@ void Model::replaceDirectMatrices()
                         } else {
                             colNodePosition2 = colNodePosition;
                         }
-                        shared_ptr<DOFMatrix> submatrix = matrix->findSubmatrix(rowNodePosition2,
+                        const DOFBlock* submatrix = matrix->getBlocks().findBlock(rowNodePosition2,
                                 colNodePosition2);
-                        for (auto& kv : submatrix->componentByDofs) {
+                        if (submatrix == nullptr) {
+                            continue;
+                        }
+                        const int segmentCount = offDiagonalBlocksByNode.find(rowNodePosition)->second;
+                        submatrix->forEachComponent([&](const DOF& rowDof, const DOF& colDof, double component) {
                             // We are disassembling the matrix, so we must divide the value by the segments
-                            double value = kv.second / static_cast<int>(matrix->findInPairs(pair.first).size());
-                            const DOF& rowDof = kv.first.first;
-                            const DOF& colDof = kv.first.second;
+                            double value = component / segmentCount;
                             if (!is_equal(value, 0)) {
                                 switch (matrix->type) {
                                 case ElementSet::Type::STIFFNESS_MATRIX:
@@ -1348,18 +1455,33 @@ void Model::replaceDirectMatrices()
                                 requiredRowDofs += rowDof;
                                 requiredColDofs += colDof;
                             }
-                        }
+                        });
                     }
                 }
                 if (this->configuration.logLevel >= LogLevel::DEBUG) {
-                    cout << "Creating discrete : " << discrete << " over node ids : "
+                    ModelPassManager::out() << "Creating discrete : " << discrete << " over node ids : "
                             << to_string(rowNodeId) << " and : " << to_string(colNodeId) << endl;
                 }
                 this->add(discrete);
+                ownedDofsByNodePosition[rowNodePosition] += DOFS::TRANSLATIONS;
+                ownedDofsByNodePosition[colNodePosition] += DOFS::TRANSLATIONS;
             }
-        }
+        });
         elementSetsToRemove.push_back(elementSetM);
     }
+    // DOFS used by the loadings (on any node) and by the constraints, computed once for all the nodes
+    DOFS loadingDofs;
+    for (const auto loading : loadings) {
+        for (int nodePosition2 : loading->nodePositions()) {
+            loadingDofs += loading->getDOFSForNode(nodePosition2);
+        }
+    }
+    map<int, DOFS> constraintDofsByNode;
+    for (const auto constraint : constraints) {
+        for (int nodePosition2 : constraint->nodePositions()) {
+            constraintDofsByNode[nodePosition2] += constraint->getDOFSForNode(nodePosition2);
+        }
+    }
     for (auto& kv : addedDofsByNode) {
         int nodePosition = kv.first;
         const int nodeId = this->mesh->findNodeId(nodePosition);
@@ -1380,17 +1502,10 @@ void Model::replaceDirectMatrices()
             owned = it2->second;
         }
 
-        for (const auto loading : loadings) {
-            for (int nodePosition2 : loading->nodePositions()) {
-                required += loading->getDOFSForNode(nodePosition2);
-            }
-        }
-        for (const auto constraint : constraints) {
-            set<int> constraintNodes = constraint->nodePositions();
-            if (constraintNodes.find(nodePosition) == constraintNodes.end()) {
-                continue;
-            }
-            required += constraint->getDOFSForNode(nodePosition);
+        required += loadingDofs;
+        auto it3 = constraintDofsByNode.find(nodePosition);
+        if (it3 != constraintDofsByNode.end()) {
+            required += it3->second;
         }
         const DOFS& extra = added - owned - required;
         if (extra != DOFS::NO_DOFS) {
@@ -1399,14 +1514,14 @@ void Model::replaceDirectMatrices()
             add(spc);
             addConstraintIntoConstraintSet(spc, commonConstraintSet);
             if (configuration.logLevel >= LogLevel::DEBUG) {
-                cout << "Adding virtual spc on node id: " << nodeId << "for " << extra
+                ModelPassManager::out() << "Adding virtual spc on node id: " << nodeId << "for " << extra
                         << endl;
             }
         }
     }
     for (auto elementSet : elementSetsToRemove) {
         if (configuration.logLevel >= LogLevel::DEBUG) {
-            cout << "Replaced " << *elementSet << endl;
+            ModelPassManager::out() << "Replaced " << *elementSet << endl;
         }
         this->elementSets.erase(elementSet->getReference());
     }
@@ -1449,7 +1564,7 @@ void Model::removeRedundantSpcs()
                     if (dofsToRemove.size() >= 1) {
                         analysis->removeSPCNodeDofs(*spc, nodePosition, dofsToRemove);
                         if (configuration.logLevel >= LogLevel::DEBUG) {
-                            cout << "Removed redundant node id : " << this->mesh->findNodeId(nodePosition)
+                            ModelPassManager::out() << "Removed redundant node id : " << this->mesh->findNodeId(nodePosition)
                                     << " from spc : " << *spc << " for analysis : " << *analysis << endl;
                         }
                     }
@@ -1498,28 +1613,59 @@ void Model::splitDirectMatrices(const unsigned int sizeMax){
         dummyMatrix->clear();
 
 
-        map<int,int> stackOfNodesByNodes;
+        // We attribute a stack of sizeStack to each node. Stacks 2k and 2k+1 share the same
+        // diagonal submatrix: nodes are partitioned by pairs of stacks, then each part is cut in two.
+        const DOFBlockMatrix& blocks = matrix->getBlocks();
+        auto stacksOfParts = [sizeStack](const vector<vector<int>>& parts) {
+            map<int, int> stackByNode;
+            for (size_t part = 0; part < parts.size(); part++) {
+                for (size_t rank = 0; rank < parts[part].size(); rank++) {
+                    stackByNode[parts[part][rank]] = static_cast<int>(2 * part + rank / sizeStack);
+                }
+            }
+            return stackByNode;
+        };
+        map<int, int> stackOfNodesByNodes = stacksOfParts(blocks.partitionNodesByOrder(2 * sizeStack));
+        if (configuration.partitionDirectMatrices) {
+            // Terms between different pairs of stacks are cut, each coupled pair of stacks
+            // needing its own matrix.
+            auto countCutTermsAndMatrices = [&blocks](const map<int, int>& stackByNode) {
+                int cutTerms = 0;
+                set<pair<int, int>> matrixStacks;
+                blocks.forEachBlock([&](const DOFBlock& block) {
+                    const int sI = stackByNode.at(block.rowNodePosition);
+                    const int sJ = stackByNode.at(block.columnNodePosition);
+                    if (sI / 2 == sJ / 2) {
+                        matrixStacks.insert(make_pair(sI / 2, -1));
+                    } else {
+                        cutTerms += block.countComponents();
+                        matrixStacks.insert(make_pair(min(sI, sJ), max(sI, sJ)));
+                    }
+                });
+                return make_pair(cutTerms, matrixStacks.size());
+            };
+            const auto orderCut = countCutTermsAndMatrices(stackOfNodesByNodes);
+            map<int, int> stackByCoupling = stacksOfParts(blocks.partitionNodesByCoupling(2 * sizeStack));
+            const auto couplingCut = countCutTermsAndMatrices(stackByCoupling);
+            // The partition by coupling is kept unless it would lead to more matrices
+            const bool keepCoupling = couplingCut.second <= orderCut.second;
+            if (keepCoupling) {
+                stackOfNodesByNodes = move(stackByCoupling);
+            }
+            if (configuration.logLevel >= LogLevel::INFO) {
+                ModelPassManager::out() << "Element Matrix " << matrix->bestId() << " split by node coupling: "
+                        << couplingCut.first << " cut terms in " << couplingCut.second << " matrices, instead of "
+                        << orderCut.first << " cut terms in " << orderCut.second << " matrices by node order"
+                        << (keepCoupling ? "." : ". Node order is kept.") << endl;
+            }
+        }
         map<pair<int, int>, shared_ptr<ElementSet>>  esToAddByStackNumber;
 
         // Splitting the matrices, pairs of nodes by pairs of node (I,J).
-        for (const auto np : matrix->nodePairs()){
-
-            // We attribute a stack of sizeStack to each node.
-            int sI, sJ;
-            auto it = stackOfNodesByNodes.find(np.first);
-            if (it == stackOfNodesByNodes.end()){
-                sI = static_cast<int>(stackOfNodesByNodes.size()/sizeStack);
-                stackOfNodesByNodes[np.first]=sI;
-            }else{
-                sI = it->second;
-            }
-            it = stackOfNodesByNodes.find(np.second);
-            if (it == stackOfNodesByNodes.end()){
-                sJ = static_cast<int>(stackOfNodesByNodes.size()/sizeStack);
-                stackOfNodesByNodes[np.second]=sJ;
-            }else{
-                sJ = it->second;
-            }
+        blocks.forEachBlock([&](const DOFBlock& block) {
+            const pair<int, int> np(block.rowNodePosition, block.columnNodePosition);
+            const int sI = stackOfNodesByNodes.at(np.first);
+            const int sJ = stackOfNodesByNodes.at(np.second);
 
             // We attribute a elementSet to the pair (sI, sJ), and create it if needed
             pair<int, int> ps;
@@ -1552,19 +1698,20 @@ void Model::splitDirectMatrices(const unsigned int sizeMax){
 
             // We copy the values
             shared_ptr<MatrixElement> nM = dynamic_pointer_cast<MatrixElement>(newElementSet);
-            shared_ptr<DOFMatrix> dM = matrix->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
-                nM->addComponent(nodeIdOfElement[np.first], dof.first.first, nodeIdOfElement[np.second], dof.first.second, dof.second);
-            }
+            const int nodeId1 = nodeIdOfElement[np.first];
+            const int nodeId2 = nodeIdOfElement[np.second];
+            block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                nM->addComponent(nodeId1, dof1, nodeId2, dof2, value);
+            });
 
-        }
+        });
 
         if (configuration.logLevel >= LogLevel::DEBUG) {
-            cout << "Element Matrix "<<matrix->bestId()<< " has been split into the smaller matrices ";
+            ModelPassManager::out() << "Element Matrix "<<matrix->bestId()<< " has been split into the smaller matrices ";
             for (auto es : esToAddByStackNumber){
-                cout << es.second->bestId()<<" ";
+                ModelPassManager::out() << es.second->bestId()<<" ";
             }
-            cout <<endl;
+            ModelPassManager::out() <<endl;
         }
 
     }
@@ -1621,7 +1768,7 @@ void Model::makeCellsFromDirectMatrices(){
         matrixGroup->addCellId(mesh->findCell(cellPosition).id);
 
         if (configuration.logLevel >= LogLevel::DEBUG){
-           cout << "Built cells, in cellgroup "<<matrixGroup->getName()<<", for Matrix Elements in "<< elementSetM->name<<"."<<endl;
+           ModelPassManager::out() << "Built cells, in cellgroup "<<matrixGroup->getName()<<", for Matrix Elements in "<< elementSetM->name<<"."<<endl;
         }
 
     }
@@ -1633,6 +1780,22 @@ void Model::makeCellsFromLMPC(){
     shared_ptr<Mesh> mesh = this->mesh;
     shared_ptr<Material> materialLMPC= nullptr;
 
+    // Cells are added at once, by runs of cells of the same size, keeping the order of the LMPC to keep the same automatic ids
+    unsigned int pendingCellSize = 0;
+    vector<int> pendingNodePositions;
+    vector<shared_ptr<CellGroup>> pendingGroups;
+    auto addPendingCells = [&]() {
+        if (pendingGroups.empty()) {
+            return;
+        }
+        const vector<int>& cellIds = mesh->addCells(CellType::polyType(pendingCellSize), pendingNodePositions, true);
+        for (size_t i = 0; i < cellIds.size(); i++) {
+            pendingGroups[i]->addCellId(cellIds[i]);
+        }
+        pendingNodePositions.clear();
+        pendingGroups.clear();
+    };
+
     for (auto analysis : this->analyses) {
         map< vector<DOFCoefs>, shared_ptr<CellGroup>> groupBySetOfCoefs;
         for (const auto& constraintSet : analysis->getConstraintSets()) {
@@ -1669,21 +1832,22 @@ void Model::makeCellsFromLMPC(){
                     groupBySetOfCoefs[sortedCoefs]= group;
                 }
 
-                // Creating a cell and adding it to the CellGroup
-                vector<int> nodes;
-                for (int position : sortedNodesPosition){
-                    const int nodeId = mesh->findNodeId(position);
-                    nodes.push_back(nodeId);
+                // Creating a cell for the CellGroup
+                const unsigned int cellSize = static_cast<unsigned int>(sortedNodesPosition.size());
+                if (cellSize != pendingCellSize) {
+                    addPendingCells();
+                    pendingCellSize = cellSize;
                 }
-                int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::polyType(static_cast<unsigned int>(nodes.size())), nodes, true);
-                group->addCellId(mesh->findCell(cellPosition).id);
+                pendingNodePositions.insert(pendingNodePositions.end(), sortedNodesPosition.begin(), sortedNodesPosition.end());
+                pendingGroups.push_back(group);
                 if (configuration.logLevel >= LogLevel::DEBUG){
-                    cout << "Building cells in group "<<group->getName()<<" from "<< *lmpc<<"."<<endl;
+                    ModelPassManager::out() << "Building cells in group "<<group->getName()<<" from "<< *lmpc<<"."<<endl;
                 }
             }
 
         }
     }
+    addPendingCells();
 
     // After the translation, we remove all LMPC constraints
     // We don't do this during the loop because some LMPC may be used by several analysis.
@@ -1692,10 +1856,11 @@ void Model::makeCellsFromLMPC(){
             const int idConstraintSet = constraintSet->getId();
             const int originalIdConstraintSet = constraintSet->getOriginalId();
             const ConstraintSet::Type natConstraintSet = constraintSet->type;
-            set<shared_ptr<Constraint>> constraints = constraintSet->getConstraintsByType(Constraint::Type::LMPC);
-            for (const auto& constraint : constraints) {
-                remove(constraint->getReference(), idConstraintSet, originalIdConstraintSet, natConstraintSet);
+            set<Reference<Constraint>> toBeRemoved;
+            for (const auto& constraint : constraintSet->getConstraintsByType(Constraint::Type::LMPC)) {
+                toBeRemoved.insert(constraint->getReference());
             }
+            remove(toBeRemoved, idConstraintSet, originalIdConstraintSet, natConstraintSet);
         }
     }
 }
@@ -1705,82 +1870,98 @@ void Model::makeCellsFromRBE(){
     shared_ptr<Mesh> mesh = this->mesh;
     vector<shared_ptr<ConstraintSet>> commonConstraintSets = this->getCommonConstraintSets();
 
+    // A single dummy rigid material for all the RBAR and RBE2, and one for each coefficient of RBE3
+    shared_ptr<Material> materialRigid = nullptr;
+    map<double, shared_ptr<Material>> materialRBE3ByCoef;
+
     for (const auto& constraintSet : commonConstraintSets) {
 
         const int idConstraintSet = constraintSet->getId();
         const int originalIdConstraintSet = constraintSet->getOriginalId();
         const ConstraintSet::Type natConstraintSet = constraintSet->type;
 
+        // All the SEG2 cells of the constraint set are added at once, at the end, with the group of each one
+        vector<int> segmentNodePositions;
+        vector<shared_ptr<CellGroup>> segmentGroups;
+
+        // Constraints are fetched once, and split by type, as it is costly for big constraint sets
+        map<Constraint::Type, set<shared_ptr<Constraint>>> constraintsByType;
+        for (const auto& constraint : constraintSet->getConstraints()) {
+            if (constraint->type == Constraint::Type::RIGID or constraint->type == Constraint::Type::QUASI_RIGID
+                    or constraint->type == Constraint::Type::RBE3) {
+                constraintsByType[constraint->type].insert(constraint);
+            }
+        }
 
         // Translation of RBAR and RBE2 (RBE2 are viewed as an assembly of RBAR)
         // See Systus Reference Analysis Manual: RIGID BODY Element (page 498)
-        set<shared_ptr<Constraint>> constraints = constraintSet->getConstraintsByType(Constraint::Type::RIGID);
-        vector<shared_ptr<Constraint>> toBeRemoved;
-        for (const auto& constraint : constraints) {
+        set<Reference<Constraint>> toBeRemoved;
+        for (const auto& constraint : constraintsByType[Constraint::Type::RIGID]) {
             const shared_ptr<RigidConstraint> rbe2 = dynamic_pointer_cast<RigidConstraint>(constraint);
 
-            // Creating an elementset, a CellGroup and a dummy rigid material
-            shared_ptr<Material> materialRBE2 = make_shared<Material>(this);
-            materialRBE2->addNature(RigidNature(*this, 1));
-            this->add(materialRBE2);
+            // Creating an elementset and a CellGroup, sharing the dummy rigid material
+            if (materialRigid == nullptr) {
+                materialRigid = make_shared<Material>(this);
+                materialRigid->addNature(RigidNature(*this, 1));
+                this->add(materialRigid);
+            }
 
             shared_ptr<CellGroup> group = mesh->createCellGroup("RBE2_"+to_string(constraint->getOriginalId()), CellGroup::NO_ORIGINAL_ID, "RBE2");
             Rbar elementsetRbe2(*this, mesh->findNodeId(rbe2->getMaster()));
             elementsetRbe2.assignCellGroup(group);
-            elementsetRbe2.assignMaterial(materialRBE2);
+            elementsetRbe2.assignMaterial(materialRigid);
             this->add(elementsetRbe2);
 
-            // Creating cells and adding them to the CellGroup
-            const int masterId = mesh->findNodeId(rbe2->getMaster());
+            // Creating cells for the CellGroup
             for (int position : rbe2->getSlaves()){
-                const int slaveId = mesh->findNodeId(position);
-                vector<int> nodes = {masterId, slaveId};
-                int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, nodes, true);
-                group->addCellId(mesh->findCell(cellPosition).id);
+                segmentNodePositions.push_back(rbe2->getMaster());
+                segmentNodePositions.push_back(position);
+                segmentGroups.push_back(group);
             }
 
             // Removing the constraint from the model.
-            toBeRemoved.push_back(constraint);
+            toBeRemoved.insert(constraint->getReference());
             if (configuration.logLevel >= LogLevel::DEBUG){
-                cout << "Building cells in cellgroup "<<group->getName()<<" from "<< *rbe2<<"."<<endl;
+                ModelPassManager::out() << "Building cells in cellgroup "<<group->getName()<<" from "<< *rbe2<<"."<<endl;
             }
         }
 
-        constraints = constraintSet->getConstraintsByType(Constraint::Type::QUASI_RIGID);
-        for (const auto& constraint : constraints) {
+        for (const auto& constraint : constraintsByType[Constraint::Type::QUASI_RIGID]) {
             shared_ptr<QuasiRigidConstraint> rbar = dynamic_pointer_cast<QuasiRigidConstraint>(constraint);
 
             if (!(rbar->isCompletelyRigid())){
-                cerr << "QUASI_RIGID constraint not available yet. Constraint "+to_string(constraint->bestId())+ " translated as rigid constraint."<<endl;
+                ModelPassManager::err() << "QUASI_RIGID constraint not available yet. Constraint "+to_string(constraint->bestId())+ " translated as rigid constraint."<<endl;
             }
             if (rbar->getSlaves().size()!=2){
                throw logic_error("QUASI_RIGID constraint must have exactly two slaves.");
             }
 
-            // Creating an elementset, a CellGroup and a dummy rigid material
-            shared_ptr<Material> materialRBAR = make_shared<Material>(this);
-            materialRBAR->addNature(RigidNature(*this, 1));
-            this->add(materialRBAR);
+            // Creating an elementset and a CellGroup, sharing the dummy rigid material
+            if (materialRigid == nullptr) {
+                materialRigid = make_shared<Material>(this);
+                materialRigid->addNature(RigidNature(*this, 1));
+                this->add(materialRigid);
+            }
 
             // Master Node : first one. Slave Node : second and last one
-            const int masterNodeId = mesh->findNodeId(*rbar->getSlaves().begin());
-            const int slaveNodeId = mesh->findNodeId(*rbar->getSlaves().rbegin());
+            const int masterNodePosition = *rbar->getSlaves().begin();
+            const int slaveNodePosition = *rbar->getSlaves().rbegin();
             shared_ptr<CellGroup> group = mesh->createCellGroup("RBAR_"+to_string(constraint->getOriginalId()), CellGroup::NO_ORIGINAL_ID, "RBAR");
 
-            Rbar elementsetRBAR(*this, masterNodeId);
+            Rbar elementsetRBAR(*this, mesh->findNodeId(masterNodePosition));
             elementsetRBAR.assignCellGroup(group);
-            elementsetRBAR.assignMaterial(materialRBAR);
+            elementsetRBAR.assignMaterial(materialRigid);
             this->add(elementsetRBAR);
 
-            // Creating a cell and adding it to the CellGroup
-            vector<int> nodes = {masterNodeId, slaveNodeId};
-            int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, nodes, true);
-            group->addCellId(mesh->findCell(cellPosition).id);
+            // Creating a cell for the CellGroup
+            segmentNodePositions.push_back(masterNodePosition);
+            segmentNodePositions.push_back(slaveNodePosition);
+            segmentGroups.push_back(group);
 
             // Removing the constraint from the model.
-            toBeRemoved.push_back(constraint);
+            toBeRemoved.insert(constraint->getReference());
             if (configuration.logLevel >= LogLevel::DEBUG){
-                cout << "Building cells in cellgroup "<<group->getName()<<" from "<< *rbar<<"."<<endl;
+                ModelPassManager::out() << "Building cells in cellgroup "<<group->getName()<<" from "<< *rbar<<"."<<endl;
             }
         }
 
@@ -1789,8 +1970,7 @@ void Model::makeCellsFromRBE(){
          * See Systus Reference Analysis Manual, Section 8.8 "Special Elements",
          * Subsection "Use of Averaging Type Solid Elements", p500.
          */
-        constraints = constraintSet->getConstraintsByType(Constraint::Type::RBE3);
-        for (const auto& constraint : constraints) {
+        for (const auto& constraint : constraintsByType[Constraint::Type::RBE3]) {
 
             const shared_ptr<RBE3>& rbe3 = dynamic_pointer_cast<RBE3>(constraint);
             const int masterId = mesh->findNodeId(rbe3->getMaster());
@@ -1801,10 +1981,7 @@ void Model::makeCellsFromRBE(){
 
             for (int position : rbe3->getSlaves()){
 
-                const int slaveId = mesh->findNodeId(position);
-                int cellPosition = mesh->addCell(Cell::AUTO_ID, CellType::SEG2, {masterId, slaveId}, true);
-
-                /* We build a material for each value of "Slave DOFS" and "Slave Coeff" */
+                /* We build a group for each value of "Slave DOFS" and "Slave Coeff", and a material for each "Slave Coeff" */
                 const DOFS& sDOFS = rbe3->getDOFSForNode(position);
                 const double sCoef = rbe3->getCoefForNode(position);
 
@@ -1818,34 +1995,42 @@ void Model::makeCellsFromRBE(){
 
                 if (groupRBE3==nullptr){
 
-                    // Creating an elementset, a CellGroup and a dummy rigid material
+                    // Creating an elementset, a CellGroup and, if needed, a dummy rigid material
                     nbParts++;
-                    shared_ptr<Material> materialRBE3 = make_shared<Material>(this);
-                    materialRBE3->addNature(RigidNature(*this, Nature::UNAVAILABLE_DOUBLE, sCoef));
-                    this->add(materialRBE3);
+                    shared_ptr<Material>& materialRBE3 = materialRBE3ByCoef[sCoef];
+                    if (materialRBE3 == nullptr) {
+                        materialRBE3 = make_shared<Material>(this);
+                        materialRBE3->addNature(RigidNature(*this, Nature::UNAVAILABLE_DOUBLE, sCoef));
+                        this->add(materialRBE3);
+                    }
 
-                    shared_ptr<CellGroup> group = mesh->createCellGroup("RBE3_"+to_string(nbParts)+"_"+to_string(constraint->getOriginalId()), CellGroup::NO_ORIGINAL_ID, "RBE3");
+                    groupRBE3 = mesh->createCellGroup("RBE3_"+to_string(nbParts)+"_"+to_string(constraint->getOriginalId()), CellGroup::NO_ORIGINAL_ID, "RBE3");
                     Rbe3 elementsetRbe3(*this, masterId, mDOFS, sDOFS);
-                    elementsetRbe3.assignCellGroup(group);
+                    elementsetRbe3.assignCellGroup(groupRBE3);
                     elementsetRbe3.assignMaterial(materialRBE3);
                     this->add(elementsetRbe3);
 
                     if (configuration.logLevel >= LogLevel::DEBUG){
-                        cout << "Building cells in CellGroup "<<group->getName()<<" from "<< *rbe3<<"."<<endl;
+                        ModelPassManager::out() << "Building cells in CellGroup "<<groupRBE3->getName()<<" from "<< *rbe3<<"."<<endl;
                     }
-                    groupByCoefByDOFS[sDOFS][sCoef]= group;
+                    groupByCoefByDOFS[sDOFS][sCoef]= groupRBE3;
                 }
-                groupRBE3=groupByCoefByDOFS[sDOFS][sCoef];
-                groupRBE3->addCellId(mesh->findCell(cellPosition).id);
+                segmentNodePositions.push_back(rbe3->getMaster());
+                segmentNodePositions.push_back(position);
+                segmentGroups.push_back(groupRBE3);
             }
 
             // Removing the constraint from the model.
-            toBeRemoved.push_back(constraint);
+            toBeRemoved.insert(constraint->getReference());
         }
 
-        for(auto& constraint: toBeRemoved) {
-            remove(constraint->getReference(), idConstraintSet, originalIdConstraintSet, natConstraintSet);
+        // Cells are created in the same order as the constraints and their slaves, as before, to keep the same automatic ids
+        const vector<int>& cellIds = mesh->addCells(CellType::SEG2, segmentNodePositions, true);
+        for (size_t i = 0; i < cellIds.size(); i++) {
+            segmentGroups[i]->addCellId(cellIds[i]);
         }
+
+        remove(toBeRemoved, idConstraintSet, originalIdConstraintSet, natConstraintSet);
     }
 }
 
@@ -1886,7 +2071,7 @@ void Model::splitElementsByDOFS(){
                 const string name = ss->cellGroup->getName();
                 const string comment = ss->cellGroup->getComment();
                 if (configuration.logLevel >= LogLevel::DEBUG)
-                    cout<< *elementSet << " spring must be split."<<endl;
+                    ModelPassManager::out() << *elementSet << " spring must be split."<<endl;
                 for (const auto & it : ss->getCellPositionByDOFS()){
                     ScalarSpring scalarSpring(*this, Identifiable<ElementSet>::NO_ORIGINAL_ID, stiffness, damping);
                     shared_ptr<CellGroup> cellGroup = this->mesh->createCellGroup(name+"_"+to_string(i), Group::NO_ORIGINAL_ID, comment);
@@ -1905,7 +2090,7 @@ void Model::splitElementsByDOFS(){
         }
         default: {
             //TODO : throw ModelException("ElementSet type not supported");
-            cerr << "Warning in splitElementsByDOFS: " << *elementSet << " not supported" << endl;
+            ModelPassManager::err() << "Warning in splitElementsByDOFS: " << *elementSet << " not supported" << endl;
         }
         }
     }
@@ -2029,111 +2214,159 @@ void Model::addAutoAnalysis() {
     }
 }
 
-void Model::finish() {
-    if (finished) {
-        return;
-    }
+void Model::markDirty(unsigned int parts) {
+    // Also called by the passes of finish(), concurrently
+    dirtyParts |= parts;
+    ModelPassManager::recordWrites(parts);
+}
 
-    /* Build the coordinate systems from their definition points */
-    for (auto& coordinateSystemEntry : mesh->coordinateSystemStorage.coordinateSystemById) {
-        coordinateSystemEntry.second->build();
+void Model::reconfigure(const ModelConfiguration& configuration) {
+    if (finished) {
+        throw logic_error("Model " + name + " can't be reconfigured after finish().");
     }
+    this->configuration = configuration;
+}
 
-    for (shared_ptr<ElementSet> elementSet : elementSets) {
-        for (int nodePosition : elementSet->nodePositions()) {
-            mesh->allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
-        }
+void Model::finish() {
+    if (finished && mesh->revision() != finishedMeshRevision) {
+        dirtyParts |= ModelPass::MESH;
     }
-
-    if (this->configuration.autoDetectAnalysis and analyses.size() == 0) {
-        addAutoAnalysis();
+    if (finished && dirtyParts == ModelPass::NONE) {
+        return;
     }
 
-    for (shared_ptr<Analysis> analysis : analyses) {
-        for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
-            for(int nodePosition: boundaryCondition->nodePositions()) {
-                analysis->addBoundaryDOFS(nodePosition,
-                        boundaryCondition->getDOFSForNode(nodePosition));
+    ModelPassManager passManager(configuration.logLevel, configuration.profile);
+    /* Build the coordinate systems from their definition points */
+    passManager.add(ModelPass("buildCoordinateSystems", ModelPass::MESH, ModelPass::MESH, [this]() {
+        for (auto& coordinateSystemEntry : mesh->coordinateSystemStorage.coordinateSystemById) {
+            coordinateSystemEntry.second->build();
+        }
+    }, true));
+    passManager.add(ModelPass("allowElementDOFS", ModelPass::ELEMENTS, ModelPass::MESH, [this]() {
+        for (shared_ptr<ElementSet> elementSet : elementSets) {
+            for (int nodePosition : elementSet->nodePositions()) {
+                mesh->allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
             }
         }
-    }
-
-    removeAssertionsMissingDOFS();
-
-    if (this->configuration.makeBoundaryCells) {
+    }, true));
+    passManager.add(ModelPass("addAutoAnalysis", ModelPass::ALL, ModelPass::ANALYSES, [this]() {
+        if (analyses.size() == 0) {
+            addAutoAnalysis();
+        }
+    }, true), this->configuration.autoDetectAnalysis);
+    passManager.add(ModelPass("addBoundaryDOFS", ModelPass::MESH | ModelPass::CONSTRAINTS | ModelPass::LOADINGS,
+            ModelPass::ANALYSES, [this]() {
+        for (shared_ptr<Analysis> analysis : analyses) {
+            // Built again from scratch: boundary conditions may have been removed since the last run
+            analysis->clearBoundaryDOFS();
+            for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
+                for(int nodePosition: boundaryCondition->nodePositions()) {
+                    analysis->addBoundaryDOFS(nodePosition,
+                            boundaryCondition->getDOFSForNode(nodePosition));
+                }
+            }
+        }
+    }, true));
+    passManager.add(ModelPass("removeAssertionsMissingDOFS", ModelPass::MESH,
+            ModelPass::ANALYSES | ModelPass::OBJECTIVES, [this]() {
+        removeAssertionsMissingDOFS();
+    }, true));
+    passManager.add(ModelPass("makeBoundaryCells", ModelPass::MESH | ModelPass::CONSTRAINTS,
+            ModelPass::MESH | ModelPass::CONSTRAINTS,
+            [this]() {
         makeBoundarySegments();
         makeBoundarySurfaces();
-    }
-
-    if (this->configuration.emulateLocalDisplacement) {
+    }), this->configuration.makeBoundaryCells);
+    passManager.add(ModelPass("emulateLocalDisplacementConstraint", ModelPass::MESH,
+            ModelPass::CONSTRAINTS | ModelPass::ANALYSES, [this]() {
         emulateLocalDisplacementConstraint();
-    }
-
-    if (this->configuration.displayHomogeneousConstraint) {
+    }), this->configuration.emulateLocalDisplacement);
+    passManager.add(ModelPass("generateBeamsToDisplayHomogeneousConstraint",
+            ModelPass::MESH | ModelPass::CONSTRAINTS,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::MATERIALS | ModelPass::CONSTRAINTS, [this]() {
         generateBeamsToDisplayHomogeneousConstraint();
-    }
-
-    if (this->configuration.createSkin) {
+    }), this->configuration.displayHomogeneousConstraint);
+    passManager.add(ModelPass("generateSkin", ModelPass::MESH | ModelPass::LOADINGS,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::LOADINGS, [this]() {
         generateSkin();
-    }
-    if (this->configuration.emulateAdditionalMass) {
+    }), this->configuration.createSkin);
+    passManager.add(ModelPass("emulateAdditionalMass", ModelPass::MESH | ModelPass::ELEMENTS,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::MATERIALS, [this]() {
         emulateAdditionalMass();
-    }
-
-    if (this->configuration.replaceCombinedLoadSets) {
+    }), this->configuration.emulateAdditionalMass);
+    passManager.add(ModelPass("replaceCombinedLoadSets", ModelPass::LOADINGS, ModelPass::LOADINGS, [this]() {
         replaceCombinedLoadSets();
-    }
-
-    if (this->configuration.replaceDirectMatrices) {
+    }, true), this->configuration.replaceCombinedLoadSets);
+    passManager.add(ModelPass("replaceDirectMatrices", ModelPass::ANALYSES,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::MATERIALS | ModelPass::CONSTRAINTS
+                    | ModelPass::LOADINGS | ModelPass::VALUES, [this]() {
         replaceDirectMatrices();
-    }
-
-    if (this->configuration.removeRedundantSpcs) {
+    }), this->configuration.replaceDirectMatrices);
+    passManager.add(ModelPass("removeRedundantSpcs", ModelPass::MESH,
+            ModelPass::CONSTRAINTS | ModelPass::ANALYSES, [this]() {
         removeRedundantSpcs();
-    }
-
-    if (this->configuration.removeIneffectives) {
+    }, true), this->configuration.removeRedundantSpcs);
+    passManager.add(ModelPass("removeIneffectives", ModelPass::MESH,
+            ModelPass::ELEMENTS | ModelPass::CONSTRAINTS | ModelPass::LOADINGS | ModelPass::ANALYSES, [this]() {
         removeIneffectives();
-    }
-
-    if (this->configuration.virtualDiscrets) {
+    }, true), this->configuration.removeIneffectives);
+    passManager.add(ModelPass("generateDiscrets", ModelPass::MESH | ModelPass::CONSTRAINTS | ModelPass::ANALYSES,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::MATERIALS | ModelPass::CONSTRAINTS
+                    | ModelPass::ANALYSES, [this]() {
         generateDiscrets();
-    }
-
-    if (this->configuration.splitDirectMatrices){
+    }), this->configuration.virtualDiscrets);
+    passManager.add(ModelPass("splitDirectMatrices", ModelPass::MESH, ModelPass::ELEMENTS | ModelPass::VALUES,
+            [this]() {
         splitDirectMatrices(this->configuration.sizeDirectMatrices);
-    }
-
-    if (this->configuration.makeCellsFromDirectMatrices){
+    }), this->configuration.splitDirectMatrices);
+    passManager.add(ModelPass("makeCellsFromDirectMatrices", ModelPass::MESH | ModelPass::ELEMENTS,
+            ModelPass::MESH | ModelPass::ELEMENTS, [this]() {
         makeCellsFromDirectMatrices();
-    }
-
-    if (this->configuration.makeCellsFromLMPC){
+    }), this->configuration.makeCellsFromDirectMatrices);
+    passManager.add(ModelPass("makeCellsFromLMPC", ModelPass::MESH | ModelPass::CONSTRAINTS | ModelPass::ANALYSES,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::MATERIALS | ModelPass::CONSTRAINTS
+                    | ModelPass::ANALYSES, [this]() {
         makeCellsFromLMPC();
-    }
-
-    if (this->configuration.makeCellsFromRBE){
+    }), this->configuration.makeCellsFromLMPC);
+    passManager.add(ModelPass("makeCellsFromRBE", ModelPass::MESH | ModelPass::CONSTRAINTS,
+            ModelPass::MESH | ModelPass::ELEMENTS | ModelPass::MATERIALS | ModelPass::CONSTRAINTS
+                    | ModelPass::ANALYSES, [this]() {
         makeCellsFromRBE();
-    }
-
-    if (this->configuration.splitElementsByDOFS){
+    }), this->configuration.makeCellsFromRBE);
+    passManager.add(ModelPass("splitElementsByDOFS", ModelPass::MESH | ModelPass::ELEMENTS,
+            ModelPass::MESH | ModelPass::ELEMENTS,
+            [this]() {
         splitElementsByDOFS();
-    }
-
-    if (this->configuration.addVirtualMaterial) {
+    }), this->configuration.splitElementsByDOFS);
+    passManager.add(ModelPass("assignVirtualMaterial", ModelPass::ELEMENTS,
+            ModelPass::ELEMENTS | ModelPass::MATERIALS, [this]() {
         assignVirtualMaterial();
-    }
-
-    assignElementsToCells();
-    generateMaterialAssignments();
-
-    if (this->configuration.removeIneffectives) {
+    }, true), this->configuration.addVirtualMaterial);
+    passManager.add(ModelPass("assignElementsToCells", ModelPass::ELEMENTS, ModelPass::MESH, [this]() {
+        assignElementsToCells();
+    }, true));
+    passManager.add(ModelPass("generateMaterialAssignments", ModelPass::MESH | ModelPass::ELEMENTS,
+            ModelPass::MATERIALS, [this]() {
+        generateMaterialAssignments();
+    }, true));
+    passManager.add(ModelPass("removeUnassignedMaterials", ModelPass::MATERIALS, ModelPass::MATERIALS, [this]() {
         removeUnassignedMaterials();
+    }, true), this->configuration.removeIneffectives);
+    passManager.add(ModelPass("addDefaultAnalysis", ModelPass::CONSTRAINTS | ModelPass::LOADINGS,
+            ModelPass::ANALYSES, [this]() {
+        addDefaultAnalysis();
+    }, true));
+    passManager.add(ModelPass("finishMesh", ModelPass::MESH, ModelPass::MESH, [this]() {
+        this->mesh->finish();
+    }, true));
+    if (!finished) {
+        passManager.run();
+    } else {
+        // Only what depends on the changes made since the last finish() is done again
+        passManager.runIncremental(dirtyParts);
     }
-
-    addDefaultAnalysis();
-
-    this->mesh->finish();
+    dirtyParts = ModelPass::NONE;
+    finishedMeshRevision = mesh->revision();
     finished = true;
 }
 
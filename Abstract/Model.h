@@ -23,6 +23,9 @@
 #include "Objective.h"
 #include "Reference.h"
 #include "Target.h"
+#include "ModelPass.h"
+#include "Utility.h"
+#include <atomic>
 #include <string>
 
 namespace vega {
@@ -113,6 +116,14 @@ private:
      * Get a non rigid material (virtual)
      */
     std::shared_ptr<Material> getVirtualMaterial();
+    /**
+     * Parts of the model changed since the last finish(), as a ModelPass::Part bitmask.
+     */
+    std::atomic<unsigned int> dirtyParts{ModelPass::ALL};
+    /**
+     * Mesh::revision() at the end of the last finish(): the mesh is dirty when it differs.
+     */
+    size_t finishedMeshRevision = 0;
 
 public:
     bool finished;
@@ -124,7 +135,7 @@ public:
     std::string title;
     std::string description;
 
-    const ModelConfiguration configuration;
+    ModelConfiguration configuration; /**< Change it only through reconfigure() */
     vega::ConfigurationParameters::TranslationMode translationMode;
     std::shared_ptr<Mesh> mesh; /**< Handles geometrical information */
 
@@ -142,6 +153,16 @@ public:
     const ConstraintSet commonConstraintSet;
 
 private:
+    /**
+     * Loadings of a LoadSet, of the given type only if loadingType is not null.
+     */
+    const std::set<std::shared_ptr<Loading>> findLoadingsByLoadSet(const Reference<LoadSet>&,
+            const Loading::Type* loadingType) const;
+    /**
+     * Constraints of a ConstraintSet, of the given type only if constraintType is not null.
+     */
+    const std::set<std::shared_ptr<Constraint>> findConstraintsByConstraintSet(const Reference<ConstraintSet>&,
+            const Constraint::Type* constraintType) const;
     std::unordered_map<LoadSet::Type, std::map<int, std::set<std::shared_ptr<Reference<Loading>>> > ,EnumClassHash>
     loadingReferences_by_loadSet_original_ids_by_loadSet_type;
     std::unordered_map<int, std::set<std::shared_ptr<Reference<Loading>>> >
@@ -157,6 +178,8 @@ private:
         std::map<int, std::shared_ptr<T>> by_id;
         std::unordered_map< typename T::Type, std::map<int, std::shared_ptr<T>>,
         EnumClassHash> by_original_ids_by_type;
+        std::unordered_map< typename T::Type, std::map<int, std::shared_ptr<T>>,
+        EnumClassHash> by_id_by_type; /**< Objects sorted by type, then by id, for filter() */
     private:
         Model& model;
     public:
@@ -198,14 +221,62 @@ private:
         std::shared_ptr<T> find(int) const; /**< Find an object by its Original Id **/
         std::shared_ptr<T> get(int) const; /**< Return an object by its Vega Id **/
         const std::vector<std::shared_ptr<T>> filter(const typename T::Type) const; /**< Choose objects based on their type */
-        bool validate(){
+        /**
+         * Objects of type TYPE, in id order, as references to their class (see ClassOfType).
+         */
+        template<typename T::Type TYPE>
+        const std::vector<std::reference_wrapper<const typename ClassOfType<T, TYPE>::type>> filter() const {
+            typedef typename ClassOfType<T, TYPE>::type TypeClass;
+            std::vector<std::reference_wrapper<const TypeClass>> result;
+            const auto& typeAndObjects = by_id_by_type.find(TYPE);
+            if (typeAndObjects != by_id_by_type.end()) {
+                result.reserve(typeAndObjects->second.size());
+                for (const auto& idAndObject : typeAndObjects->second) {
+                    result.push_back(std::cref(static_cast<const TypeClass&>(*idAndObject.second)));
+                }
+            }
+            return result;
+        }
+        /**
+         * Validate all the objects, concurrently. Their diagnostics, and the invalid ones, are
+         * written to diagnostics in id order. Invalid objects are removed unless in strict mode.
+         */
+        bool validate(std::ostream& diagnostics = std::cerr) {
+            std::vector<std::shared_ptr<T>> objects;
+            objects.reserve(by_id.size());
+            for (const auto& idAndObject : by_id) {
+                objects.push_back(idAndObject.second);
+            }
+            struct Validation {
+                size_t index;
+                bool valid;
+                std::string diagnostics;
+            };
+            // Only the objects which are invalid or wrote diagnostics are kept
+            const std::vector<std::vector<Validation>> validationsByChunk = parallelChunks<std::vector<Validation>>(
+                    objects.size(), [&objects](size_t begin, size_t end) {
+                std::vector<Validation> validations;
+                std::ostringstream objectDiagnostics;
+                for (size_t index = begin; index < end; index++) {
+                    const bool valid = objects[index]->validate(objectDiagnostics);
+                    if (!valid or objectDiagnostics.tellp() > 0) {
+                        validations.push_back({index, valid, objectDiagnostics.str()});
+                        objectDiagnostics.str("");
+                    }
+                }
+                return validations;
+            });
             bool isValid = true;
             std::vector<std::shared_ptr<T>> toBeRemoved;
-            for (iterator it = this->begin(); it != this->end(); ++it) {
-                std::shared_ptr<T> t = *it;
-                if (!t->validate()) {
+            for (const auto& validations : validationsByChunk) {
+                for (const Validation& validation : validations) {
+                    diagnostics << validation.diagnostics;
+                    if (validation.valid) {
+                        continue;
+                    }
+                    std::shared_ptr<T> t = objects[validation.index];
                     isValid = false;
-                    std::cerr << *t << " is not valid" << std::endl;
+                    diagnostics << *t << " is not valid" << std::endl;
 
                     switch (model.translationMode) {
                     case vega::ConfigurationParameters::TranslationMode::MODE_STRICT:
@@ -296,6 +367,10 @@ private:
          * Remove a constraint from a known reference set when we already know some informations
          */
         void remove(const Reference<Constraint> , const int, const int, const ConstraintSet::Type);
+        /**
+         * Remove several constraints from a known reference set at once, in a single pass over the set
+         */
+        void remove(const std::set<Reference<Constraint>>&, const int, const int, const ConstraintSet::Type);
         /**
          * Retrieve any kind of object from the model, by giving a reference.
          * Return 0 if the object is not found in the model.
@@ -313,6 +388,10 @@ private:
          * Retrieve all the Loadings corresponding to a given LoadSet.
          */
         const std::set<std::shared_ptr<Loading>> getLoadingsByLoadSet(const Reference<LoadSet>&) const;
+        /**
+         * Retrieve the Loadings of a given type in a LoadSet: the other ones are not even looked for.
+         */
+        const std::set<std::shared_ptr<Loading>> getLoadingsByLoadSet(const Reference<LoadSet>&, Loading::Type) const;
 
         /**
          * Create a material
@@ -344,6 +423,11 @@ private:
          * Retrieve all the Constraints corresponding to a given ConstraintSet.
          */
         const std::set<std::shared_ptr<Constraint>> getConstraintsByConstraintSet(const Reference<ConstraintSet>&) const;
+        /**
+         * Retrieve the Constraints of a given type in a ConstraintSet: the other ones are not even looked for.
+         */
+        const std::set<std::shared_ptr<Constraint>> getConstraintsByConstraintSet(const Reference<ConstraintSet>&,
+                Constraint::Type) const;
 
         /**
          * Retrieve all the ConstraintSet containing a corresponding Constraint.
@@ -379,8 +463,22 @@ private:
 
         const std::vector<std::shared_ptr<Beam>> getBeams() const;
 
+        /**
+         * Declare changes made to some parts of the model (a ModelPass::Part bitmask) that
+         * Model can't see by itself, for instance a change in the mesh or inside an Analysis.
+         * Additions and removals through the Model methods, and edits through the Mesh methods,
+         * are tracked automatically.
+         */
+        void markDirty(unsigned int parts);
+        /**
+         * Replace the configuration of a model which has not been finished yet, for
+         * instance to prepare the same parsed model for another output solver.
+         */
+        void reconfigure(const ModelConfiguration& configuration);
         /**
          * Method that is called when parsing is complete.
+         * Can be called again after changes in the model: only the passes depending on the
+         * changed parts (see markDirty) are run again.
          */
         void finish();
         /**
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * ModelPass.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "ModelPass.h"
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace vega {
+
+using namespace std;
+
+namespace {
+// State of the pass running in the current thread: nullptr outside the passes
+thread_local unsigned int* currentPassWrites = nullptr;
+thread_local ostream* currentPassOut = nullptr;
+thread_local ostream* currentPassErr = nullptr;
+
+string partNames(unsigned int parts) {
+    static const char* const names[] = { "MESH", "ELEMENTS", "MATERIALS", "CONSTRAINTS", "LOADINGS",
+            "ANALYSES", "OBJECTIVES", "VALUES" };
+    string result;
+    for (unsigned int i = 0; i < 8; i++) {
+        if ((parts & (1u << i)) != 0) {
+            result += (result.empty() ? "" : "|") + string(names[i]);
+        }
+    }
+    return result;
+}
+}
+
+#ifdef NDEBUG
+bool ModelPassManager::writesChecked = false;
+#else
+bool ModelPassManager::writesChecked = true;
+#endif
+
+void ModelPassManager::recordWrites(unsigned int parts) {
+    if (currentPassWrites != nullptr) {
+        *currentPassWrites |= parts;
+    }
+}
+
+ostream& ModelPassManager::out() {
+    return currentPassOut != nullptr ? *currentPassOut : cout;
+}
+
+ostream& ModelPassManager::err() {
+    return currentPassErr != nullptr ? *currentPassErr : cerr;
+}
+
+ModelPass::ModelPass(const string& name, unsigned int reads, unsigned int writes, function<void()> run,
+        bool rerunnable) :
+        name(name), reads(reads | writes), writes(writes), run(run), rerunnable(rerunnable) {
+}
+
+bool ModelPass::conflictsWith(const ModelPass& other) const {
+    return (writes & other.reads) != 0 || (other.writes & reads) != 0;
+}
+
+ModelPassManager::ModelPassManager(LogLevel logLevel, bool profile) :
+        logLevel(logLevel), profile(profile) {
+}
+
+void ModelPassManager::add(const ModelPass& pass, bool enabled) {
+    if (enabled) {
+        passes.push_back(pass);
+    }
+}
+
+vector<vector<size_t>> ModelPassManager::stages() const {
+    vector<size_t> allPasses(passes.size());
+    for (size_t i = 0; i < passes.size(); i++) {
+        allPasses[i] = i;
+    }
+    return stages(allPasses);
+}
+
+vector<vector<size_t>> ModelPassManager::stages(const vector<size_t>& selectedPasses) const {
+    vector<vector<size_t>> result;
+    for (size_t i : selectedPasses) {
+        bool conflict = result.empty();
+        if (!conflict) {
+            for (size_t j : result.back()) {
+                if (passes[i].conflictsWith(passes[j])) {
+                    conflict = true;
+                    break;
+                }
+            }
+        }
+        if (conflict) {
+            result.push_back({i});
+        } else {
+            result.back().push_back(i);
+        }
+    }
+    return result;
+}
+
+double ModelPassManager::runPass(const ModelPass& pass, unsigned int& actualWrites) const {
+    if (logLevel >= LogLevel::TRACE) {
+        out() << "Running " << pass.name << endl;
+    }
+    currentPassWrites = &actualWrites;
+    const auto start = chrono::steady_clock::now();
+    try {
+        pass.run();
+    } catch (...) {
+        currentPassWrites = nullptr;
+        throw;
+    }
+    currentPassWrites = nullptr;
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void ModelPassManager::checkWrites(const vector<size_t>& stage, const vector<unsigned int>& actualWrites) const {
+    unsigned int stageWrites = ModelPass::NONE;
+    for (size_t k = 0; k < stage.size(); k++) {
+        const ModelPass& pass = passes[stage[k]];
+        const unsigned int undeclaredWrites = actualWrites[k] & ~pass.writes;
+        if (undeclaredWrites != ModelPass::NONE) {
+            throw logic_error("Model pass " + pass.name + " changes " + partNames(undeclaredWrites)
+                    + " without declaring it.");
+        }
+        if ((stageWrites & actualWrites[k]) != ModelPass::NONE) {
+            throw logic_error("Model pass " + pass.name + " changes " + partNames(stageWrites & actualWrites[k])
+                    + ", also changed by a concurrent pass.");
+        }
+        stageWrites |= actualWrites[k];
+    }
+}
+
+void ModelPassManager::run() {
+    vector<size_t> allPasses(passes.size());
+    for (size_t i = 0; i < passes.size(); i++) {
+        allPasses[i] = i;
+    }
+    run(allPasses);
+}
+
+vector<string> ModelPassManager::runIncremental(unsigned int dirtyParts) {
+    vector<size_t> selectedPasses;
+    vector<string> skippedPasses;
+    for (size_t i = 0; i < passes.size(); i++) {
+        if ((passes[i].reads & dirtyParts) == 0) {
+            continue;
+        }
+        if (passes[i].rerunnable) {
+            selectedPasses.push_back(i);
+            dirtyParts |= passes[i].writes;
+        } else {
+            skippedPasses.push_back(passes[i].name);
+        }
+    }
+    if (logLevel >= LogLevel::DEBUG) {
+        cout << "Incremental finish: " << selectedPasses.size() << " of " << passes.size()
+                << " passes to run again";
+        for (size_t i = 0; i < skippedPasses.size(); i++) {
+            cout << (i == 0 ? ", not run again: " : ", ") << skippedPasses[i];
+        }
+        cout << "." << endl;
+    }
+    run(selectedPasses);
+    return skippedPasses;
+}
+
+void ModelPassManager::run(const vector<size_t>& selectedPasses) {
+    durations.clear();
+    durations.reserve(selectedPasses.size());
+    for (const auto& stage : stages(selectedPasses)) {
+        vector<double> stageDurations(stage.size(), 0.0);
+        vector<unsigned int> actualWrites(stage.size(), ModelPass::NONE);
+        if (stage.size() == 1) {
+            stageDurations[0] = runPass(passes[stage[0]], actualWrites[0]);
+        } else {
+            vector<exception_ptr> errors(stage.size());
+            vector<ostringstream> outs(stage.size());
+            vector<ostringstream> errs(stage.size());
+            vector<thread> threads;
+            threads.reserve(stage.size());
+            for (size_t k = 0; k < stage.size(); k++) {
+                threads.emplace_back([this, &stage, &stageDurations, &actualWrites, &errors, &outs, &errs, k]() {
+                    currentPassOut = &outs[k];
+                    currentPassErr = &errs[k];
+                    try {
+                        stageDurations[k] = runPass(passes[stage[k]], actualWrites[k]);
+                    } catch (...) {
+                        errors[k] = current_exception();
+                    }
+                    currentPassOut = nullptr;
+                    currentPassErr = nullptr;
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            for (size_t k = 0; k < stage.size(); k++) {
+                cout << outs[k].str();
+                cerr << errs[k].str();
+            }
+            // Same error as the sequential run: the one of the first failing pass
+            for (const auto& error : errors) {
+                if (error) {
+                    rethrow_exception(error);
+                }
+            }
+        }
+        if (writesChecked) {
+            checkWrites(stage, actualWrites);
+        }
+        for (size_t k = 0; k < stage.size(); k++) {
+            durations.push_back(make_pair(passes[stage[k]].name, stageDurations[k]));
+        }
+    }
+    if (profile) {
+        printProfile(cout);
+    }
+}
+
+void ModelPassManager::printProfile(ostream& out) const {
+    double total = 0.0;
+    for (const auto& nameAndDuration : durations) {
+        total += nameAndDuration.second;
+    }
+    const ios_base::fmtflags flags = out.flags();
+    const streamsize precision = out.precision();
+    out << "Model preparation profile (ms):" << endl;
+    for (const auto& nameAndDuration : durations) {
+        out << "  " << left << setw(45) << nameAndDuration.first << right << fixed << setprecision(3)
+                << setw(12) << nameAndDuration.second << endl;
+    }
+    out << "  " << left << setw(45) << "Total" << right << fixed << setprecision(3) << setw(12) << total
+            << endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} /* namespace vega */
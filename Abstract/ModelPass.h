@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * ModelPass.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef MODELPASS_H_
+#define MODELPASS_H_
+
+#include "ConfigurationParameters.h"
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vega {
+
+/**
+ * A transformation of the model, as run by Model::finish().
+ * Each pass declares the parts of the model it reads and the parts it writes, so that
+ * passes which can't interfere can be run concurrently.
+ */
+class ModelPass final {
+public:
+    /**
+     * Parts of the model, to be combined in a bitmask.
+     */
+    enum Part : unsigned int {
+        NONE = 0,
+        MESH = 1 << 0, /**< Nodes, cells, groups and coordinate systems **/
+        ELEMENTS = 1 << 1,
+        MATERIALS = 1 << 2, /**< Materials and their assignments **/
+        CONSTRAINTS = 1 << 3, /**< Constraints and ConstraintSets **/
+        LOADINGS = 1 << 4, /**< Loadings and LoadSets **/
+        ANALYSES = 1 << 5,
+        OBJECTIVES = 1 << 6,
+        VALUES = 1 << 7,
+        ALL = (1 << 8) - 1
+    };
+    ModelPass(const std::string& name, unsigned int reads, unsigned int writes, std::function<void()> run,
+            bool rerunnable = false);
+    const std::string name;
+    const unsigned int reads;
+    const unsigned int writes;
+    const std::function<void()> run;
+    /**
+     * True if the pass can be run again on an already finished model, to take into account
+     * later changes of the parts it reads.
+     */
+    const bool rerunnable;
+    /**
+     * True if one of the passes writes a part of the model used by the other one.
+     */
+    bool conflictsWith(const ModelPass& other) const;
+};
+
+/**
+ * Run a sequence of ModelPass.
+ * Consecutive passes which don't conflict are run concurrently: the result is the same as
+ * a sequential run in the order of addition. Optionally measures the time spent in each pass.
+ *
+ * The messages of concurrent passes are kept in a buffer per pass (see out() and err()), and
+ * printed in the order of the passes once they are all over. The parts a pass actually changes
+ * (see recordWrites()) are checked against its declaration.
+ */
+class ModelPassManager final {
+private:
+    static bool writesChecked;
+    const LogLevel logLevel;
+    const bool profile;
+    std::vector<ModelPass> passes;
+    std::vector<std::pair<std::string, double>> durations;
+    /**
+     * Run the pass, measuring its duration if needed.
+     */
+    double runPass(const ModelPass& pass, unsigned int& actualWrites) const;
+    /**
+     * Throws logic_error if a pass of the stage has changed a part it does not declare,
+     * or a part also changed by another pass of the stage.
+     */
+    void checkWrites(const std::vector<size_t>& stage, const std::vector<unsigned int>& actualWrites) const;
+    std::vector<std::vector<size_t>> stages(const std::vector<size_t>& selectedPasses) const;
+    void run(const std::vector<size_t>& selectedPasses);
+public:
+    ModelPassManager(LogLevel logLevel, bool profile);
+    /**
+     * Add a pass at the end of the sequence. Does nothing if the pass is not enabled.
+     */
+    void add(const ModelPass& pass, bool enabled = true);
+    /**
+     * Group the passes into stages of consecutive non conflicting passes.
+     * Each stage is given as the indexes of its passes.
+     */
+    std::vector<std::vector<size_t>> stages() const;
+    /**
+     * Run all the passes.
+     */
+    void run();
+    /**
+     * Run again, on an already processed model, only the passes affected by changes in dirtyParts.
+     * A re-runnable pass is run if it reads one of the dirty parts, and the parts it writes become
+     * dirty for the following passes. Other passes are never run again: they only
+     * add objects derived from the model as it was when they first ran.
+     * Returns the names of the affected passes which are not re-runnable, also logged at DEBUG.
+     */
+    std::vector<std::string> runIncremental(unsigned int dirtyParts);
+    /**
+     * Time spent in each pass (in milliseconds) during the last run, in the order of addition.
+     */
+    const std::vector<std::pair<std::string, double>>& getDurations() const {
+        return durations;
+    }
+    void printProfile(std::ostream& out) const;
+    /**
+     * Declare that the running pass, if any, changes these parts of the model. Called by
+     * Model::markDirty(), from the thread of the pass.
+     */
+    static void recordWrites(unsigned int parts);
+    /**
+     * Check after each stage the parts its passes changed against their declarations (see checkWrites()).
+     * Enabled by default unless NDEBUG is defined: the tests enable it whatever the build type.
+     */
+    static void setWritesChecked(bool checked) {
+        writesChecked = checked;
+    }
+    /**
+     * Stream for the messages of the running pass: its own buffer if it runs concurrently
+     * with other passes, std::cout otherwise.
+     */
+    static std::ostream& out();
+    /**
+     * Stream for the warnings and errors of the running pass, buffered as out().
+     */
+    static std::ostream& err();
+};
+
+} /* namespace vega */
+
+#endif /* MODELPASS_H_ */
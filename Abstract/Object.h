@@ -77,7 +77,10 @@ public:
             original_id(original_id), id(++auto_id) {
     }
 
-    virtual bool validate() const {
+    /**
+     * Check the object, writing to diagnostics why it is not valid.
+     */
+    virtual bool validate(std::ostream&) const {
         return true;
     }
 
@@ -106,6 +109,13 @@ public:
 template<class T> const int Identifiable<T>::NO_ORIGINAL_ID = INT_MIN;
 template<class T> int Identifiable<T>::auto_id = 0;
 
+/**
+ * Class of the objects of a given type: every T having this type is an instance of
+ * ClassOfType<T, type>::type, or of one of its subclasses. It is specialized next to the classes,
+ * so that the objects of a type can be handed out as typed references, without any dynamic_cast.
+ */
+template<class T, typename T::Type> struct ClassOfType;
+
 template<class T>
 std::string to_str(const T& t) {
     std::ostringstream oss;
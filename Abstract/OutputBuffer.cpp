@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * OutputBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "OutputBuffer.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace vega {
+
+using namespace std;
+
+namespace {
+
+// Exact tests, without comparing doubles with == (-Wfloat-equal): the difference of two
+// finite doubles is zero only when they are equal
+bool isZero(double value) {
+    return std::fpclassify(value) == FP_ZERO;
+}
+
+bool isIntegral(double value) {
+    double integralPart;
+    return isZero(std::modf(value, &integralPart));
+}
+
+}
+
+OutputBuffer::OutputBuffer() :
+        out(nullptr), precision(6) {
+}
+
+OutputBuffer::OutputBuffer(ostream& out) :
+        out(&out), precision(static_cast<int>(out.precision())) {
+    buffer.reserve(FLUSH_SIZE + 256);
+}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+}
+
+void OutputBuffer::flush() {
+    if (out != nullptr && !buffer.empty()) {
+        out->write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+char* OutputBuffer::formatInteger(long long value, char* destination) {
+    // Digits are first written backwards, from the lowest one, the minimum value included
+    char digits[24];
+    char* digit = digits;
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+            : static_cast<unsigned long long>(value);
+    do {
+        *digit++ = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *destination++ = '-';
+    }
+    while (digit != digits) {
+        *destination++ = *--digit;
+    }
+    return destination;
+}
+
+size_t OutputBuffer::formatDouble(double value, int precision, char* destination) {
+    // Integral values with less digits than the precision are written as integers by %g:
+    // this frequent case (coordinates, ids, zeros) does not need snprintf.
+    const int digits = min(max(precision, 1), 18);
+    static const double powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+    if (std::abs(value) < powersOfTen[digits] && isIntegral(value)) {
+        if (isZero(value) && std::signbit(value)) {
+            memcpy(destination, "-0", 2);
+            return 2;
+        }
+        return static_cast<size_t>(formatInteger(static_cast<long long>(value), destination) - destination);
+    }
+    const int length = snprintf(destination, 32, "%.*g", precision, value);
+    return static_cast<size_t>(length);
+}
+
+void OutputBuffer::pad(size_t length, unsigned int width) {
+    if (length < width) {
+        buffer.append(width - length, ' ');
+    }
+}
+
+OutputBuffer& OutputBuffer::operator<<(char value) {
+    buffer.push_back(value);
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(const char* value) {
+    buffer.append(value);
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(const string& value) {
+    buffer.append(value);
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(long long value) {
+    char text[24];
+    buffer.append(text, formatInteger(value, text));
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(int value) {
+    return *this << static_cast<long long>(value);
+}
+
+OutputBuffer& OutputBuffer::operator<<(long value) {
+    return *this << static_cast<long long>(value);
+}
+
+OutputBuffer& OutputBuffer::operator<<(unsigned int value) {
+    return *this << static_cast<long long>(value);
+}
+
+OutputBuffer& OutputBuffer::operator<<(unsigned long value) {
+    return *this << static_cast<long long>(value);
+}
+
+OutputBuffer& OutputBuffer::operator<<(double value) {
+    char text[32];
+    buffer.append(text, formatDouble(value, precision, text));
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::field(const string& value, unsigned int width) {
+    pad(value.size(), width);
+    buffer.append(value);
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::leftField(const string& value, unsigned int width) {
+    buffer.append(value);
+    pad(value.size(), width);
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::field(long long value, unsigned int width) {
+    char text[24];
+    char* end = formatInteger(value, text);
+    pad(static_cast<size_t>(end - text), width);
+    buffer.append(text, end);
+    flushIfFull();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::zeroPadded(long long value, unsigned int digits) {
+    char text[24];
+    char* end = formatInteger(value, text);
+    const size_t length = static_cast<size_t>(end - text);
+    if (length < digits) {
+        buffer.append(digits - length, '0');
+    }
+    buffer.append(text, end);
+    flushIfFull();
+    return *this;
+}
+
+size_t OutputBuffer::formatNastranReal(double value, int precision, unsigned int width, char* destination) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*g", precision, value);
+    const char* source = text;
+    char* end = destination;
+    if (*source == '-') {
+        *end++ = *source++;
+    }
+    char* mantissa = end;
+    bool hasPoint = false;
+    while (*source != '\0' && *source != 'e') {
+        hasPoint = hasPoint || *source == '.';
+        *end++ = *source++;
+    }
+    if (!hasPoint) {
+        *end++ = '.';
+    }
+    if (*source == 'e') {
+        // Exponent without plus sign nor leading zeros: "1.5e+07" is written "1.5e7"
+        *end++ = *source++;
+        if (*source == '-') {
+            *end++ = *source;
+        }
+        source++;
+        while (*source == '0' && source[1] != '\0') {
+            source++;
+        }
+        while (*source != '\0') {
+            *end++ = *source++;
+        }
+    }
+    size_t length = static_cast<size_t>(end - destination);
+    if (width != 0 && length > width && mantissa[0] == '0' && mantissa[1] == '.') {
+        // "0.xxx" is written ".xxx" when a digit is missing
+        memmove(mantissa, mantissa + 1, static_cast<size_t>(end - mantissa - 1));
+        length--;
+    }
+    return length;
+}
+
+OutputBuffer& OutputBuffer::nastranReal(double value, unsigned int width) {
+    char text[32];
+    size_t length = 0;
+    if (std::abs(value) < 1e15 && isIntegral(value)) {
+        char* end = text;
+        if (isZero(value) && std::signbit(value)) {
+            *end++ = '-';
+        }
+        end = formatInteger(static_cast<long long>(value), end);
+        *end++ = '.';
+        length = static_cast<size_t>(end - text);
+    }
+    if (width == 0 && length == 0) {
+        // Shortest text giving back the same double: DBL_DIG digits, or more when needed
+        for (int precision = DBL_DIG; precision <= DBL_DIG + 2; precision++) {
+            length = formatNastranReal(value, precision, 0, text);
+            if (isZero(strtod(text, nullptr) - value)) {
+                break;
+            }
+        }
+    } else if (width != 0 && (length == 0 || length > width)) {
+        // The most precise text that fits: a field holds at most width - 1 digits and the point
+        for (int precision = min(static_cast<int>(width) - 1, DBL_DIG); precision > 0; precision--) {
+            length = formatNastranReal(value, precision, width, text);
+            if (length <= width) {
+                break;
+            }
+        }
+    }
+    pad(length, width);
+    buffer.append(text, length);
+    flushIfFull();
+    return *this;
+}
+
+} /* namespace vega */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * OutputBuffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef OUTPUTBUFFER_H_
+#define OUTPUTBUFFER_H_
+
+#include <ostream>
+#include <string>
+
+namespace vega {
+
+/**
+ * Fast formatting of numbers and text for the writers, shared by all the output formats.
+ *
+ * Characters are appended to a large buffer, which is written to the underlying stream with
+ * a single write() when it is full, and when the OutputBuffer is flushed or destroyed. The
+ * text is the same as the one written by the iostream operators it replaces: doubles use the
+ * precision of the underlying stream, as "%.<precision>g", fields are padded as with setw.
+ *
+ * Nothing must be written directly to the underlying stream while the buffer holds characters:
+ * call flush() first. Without underlying stream, the text is only kept in memory, see str().
+ */
+class OutputBuffer final {
+private:
+	static const size_t FLUSH_SIZE = 1 << 20;
+	std::ostream* out;
+	std::string buffer;
+	int precision;
+	/**
+	 * Appends the digits of value, with its sign, starting at destination. Returns the end.
+	 */
+	static char* formatInteger(long long value, char* destination);
+	/**
+	 * Writes the text of value, as "%.<precision>g" would, at destination (at least 32 chars).
+	 * Returns the length.
+	 */
+	static size_t formatDouble(double value, int precision, char* destination);
+	/**
+	 * Writes "%.<precision>g" of value at destination as a Nastran real: with a decimal point, and
+	 * a short exponent. The leading zero of "0.xxx" is dropped if the text is wider than width
+	 * (unless width is 0). Returns the length.
+	 */
+	static size_t formatNastranReal(double value, int precision, unsigned int width, char* destination);
+	void flushIfFull() {
+		if (out != nullptr && buffer.size() >= FLUSH_SIZE) {
+			flush();
+		}
+	}
+	void pad(size_t length, unsigned int width);
+public:
+	/**
+	 * In memory buffer, with the default precision of the streams.
+	 */
+	OutputBuffer();
+	/**
+	 * Buffer for out, with the precision of out.
+	 */
+	explicit OutputBuffer(std::ostream& out);
+	~OutputBuffer();
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	OutputBuffer& operator<<(char value);
+	OutputBuffer& operator<<(const char* value);
+	OutputBuffer& operator<<(const std::string& value);
+	OutputBuffer& operator<<(int value);
+	OutputBuffer& operator<<(long value);
+	OutputBuffer& operator<<(long long value);
+	OutputBuffer& operator<<(unsigned int value);
+	OutputBuffer& operator<<(unsigned long value);
+	OutputBuffer& operator<<(double value);
+
+	/**
+	 * Text right aligned in a field of width characters, as with setw(width).
+	 */
+	OutputBuffer& field(const std::string& value, unsigned int width);
+	/**
+	 * Text left aligned in a field of width characters, as with left << setw(width).
+	 */
+	OutputBuffer& leftField(const std::string& value, unsigned int width);
+	/**
+	 * Integer right aligned in a field of width characters, as with setw(width).
+	 */
+	OutputBuffer& field(long long value, unsigned int width);
+	/**
+	 * Integer written on exactly digits characters, padded with zeros, as with setfill('0') << setw(digits).
+	 */
+	OutputBuffer& zeroPadded(long long value, unsigned int digits);
+	/**
+	 * Real number for a Nastran field of width (8 or 16) characters, right aligned, or for a free
+	 * field if width is 0. The text always has a decimal point, and is the shortest one giving back
+	 * the same double, or, if it does not fit, the most precise one that fits in the field.
+	 */
+	OutputBuffer& nastranReal(double value, unsigned int width);
+
+	void setPrecision(int precision) {
+		this->precision = precision;
+	}
+	/**
+	 * Text written since the last flush.
+	 */
+	const std::string& str() const {
+		return buffer;
+	}
+	/**
+	 * Empty the buffer without writing it.
+	 */
+	void clear() {
+		buffer.clear();
+	}
+	/**
+	 * Write the buffered characters to the underlying stream, if any.
+	 */
+	void flush();
+};
+
+} /* namespace vega */
+
+#endif /* OUTPUTBUFFER_H_ */
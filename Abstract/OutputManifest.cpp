@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * OutputManifest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "OutputManifest.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace vega {
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+void ContentHash::addBytes(const unsigned char* bytes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        value ^= bytes[i];
+        value *= 1099511628211ULL;
+    }
+}
+
+ContentHash& ContentHash::add(long long value) {
+    // Little endian bytes, whatever the platform
+    unsigned char bytes[8];
+    const unsigned long long bits = static_cast<unsigned long long>(value);
+    for (unsigned int i = 0; i < 8; i++) {
+        bytes[i] = static_cast<unsigned char>(bits >> (8 * i));
+    }
+    addBytes(bytes, 8);
+    return *this;
+}
+
+ContentHash& ContentHash::add(int value) {
+    return add(static_cast<long long>(value));
+}
+
+ContentHash& ContentHash::add(double value) {
+    long long bits;
+    static_assert(sizeof(bits) == sizeof(value), "64 bits doubles expected");
+    memcpy(&bits, &value, sizeof(bits));
+    return add(bits);
+}
+
+ContentHash& ContentHash::add(const string& value) {
+    // The length separates consecutive strings: ("ab", "c") and ("a", "bc") differ
+    add(static_cast<long long>(value.size()));
+    return addCharacters(value.data(), value.size());
+}
+
+ContentHash& ContentHash::addCharacters(const char* characters, size_t count) {
+    addBytes(reinterpret_cast<const unsigned char*>(characters), count);
+    return *this;
+}
+
+ContentHashBuffer::int_type ContentHashBuffer::overflow(int_type character) {
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        const char c = traits_type::to_char_type(character);
+        hash.addCharacters(&c, 1);
+    }
+    return traits_type::not_eof(character);
+}
+
+streamsize ContentHashBuffer::xsputn(const char* characters, streamsize count) {
+    hash.addCharacters(characters, static_cast<size_t>(count));
+    return count;
+}
+
+OutputManifest::OutputManifest(const fs::path& manifestPath) :
+        manifestPath(manifestPath) {
+    ifstream in(manifestPath.string());
+    string fileName;
+    Entry entry;
+    while (in >> hex >> entry.hash >> dec >> entry.size >> ws
+            && getline(in, fileName)) {
+        entryByFileName[fileName] = entry;
+    }
+}
+
+bool OutputManifest::isUnchanged(const fs::path& file, uint64_t hash) const {
+    auto it = entryByFileName.find(file.filename().string());
+    if (it == entryByFileName.end() || it->second.hash != hash) {
+        return false;
+    }
+    boost::system::error_code error;
+    const uintmax_t size = fs::file_size(file, error);
+    return !error && size == it->second.size;
+}
+
+void OutputManifest::update(const fs::path& file, uint64_t hash) {
+    Entry& entry = entryByFileName[file.filename().string()];
+    entry.hash = hash;
+    entry.size = fs::file_size(file);
+}
+
+void OutputManifest::save() const {
+    ofstream out(manifestPath.string(), ios::out | ios::trunc);
+    if (!out.is_open()) {
+        throw ios::failure("Can't open file " + manifestPath.string() + " for writing.");
+    }
+    for (const auto& fileNameAndEntry : entryByFileName) {
+        const Entry& entry = fileNameAndEntry.second;
+        out << hex << entry.hash << dec << " " << entry.size << " " << fileNameAndEntry.first << endl;
+    }
+}
+
+} /* namespace vega */
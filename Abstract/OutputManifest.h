@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * OutputManifest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef OUTPUTMANIFEST_H_
+#define OUTPUTMANIFEST_H_
+
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <map>
+#include <streambuf>
+#include <string>
+
+namespace vega {
+
+/**
+ * Stable 64 bits hash (FNV-1a) of the data an output file is generated from. The value does not
+ * depend on the platform, nor on the run: it can be stored and compared between translations.
+ */
+class ContentHash final {
+private:
+	uint64_t value = 14695981039346656037ULL;
+	void addBytes(const unsigned char* bytes, size_t count);
+public:
+	ContentHash& add(int value);
+	ContentHash& add(long long value);
+	ContentHash& add(double value);
+	ContentHash& add(const std::string& value);
+	/**
+	 * Add the characters, without their count: consecutive calls hash as a single call.
+	 */
+	ContentHash& addCharacters(const char* characters, size_t count);
+	uint64_t getValue() const {
+		return value;
+	}
+};
+
+/**
+ * Stream buffer adding to a ContentHash the characters written to it: the hash of a text is
+ * computed without storing it.
+ */
+class ContentHashBuffer final : public std::streambuf {
+private:
+	ContentHash& hash;
+protected:
+	int_type overflow(int_type character) override;
+	std::streamsize xsputn(const char* characters, std::streamsize count) override;
+public:
+	explicit ContentHashBuffer(ContentHash& hash) :
+			hash(hash) {
+	}
+};
+
+/**
+ * Hashes of the output files written by the previous translation, stored in a sidecar file of the
+ * output directory. A writer skips the generation of a file when the hash of its data is the
+ * recorded one. The size of the file is recorded too, so that an interrupted or external writing
+ * is detected: the modification time, with its one second resolution, would miss a file rewritten
+ * in the same second.
+ */
+class OutputManifest final {
+private:
+	struct Entry {
+		uint64_t hash;
+		uintmax_t size;
+	};
+	const boost::filesystem::path manifestPath;
+	std::map<std::string, Entry> entryByFileName;
+public:
+	/**
+	 * Reads the manifest file, if any. An unreadable manifest is ignored: all the files are written.
+	 */
+	explicit OutputManifest(const boost::filesystem::path& manifestPath);
+	/**
+	 * True if file was written from data having this hash, and still has the size it was written with.
+	 */
+	bool isUnchanged(const boost::filesystem::path& file, uint64_t hash) const;
+	/**
+	 * Records that file has just been written from data having this hash.
+	 */
+	void update(const boost::filesystem::path& file, uint64_t hash);
+	void save() const;
+};
+
+} /* namespace vega */
+
+#endif /* OUTPUTMANIFEST_H_ */
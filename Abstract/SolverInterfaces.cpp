@@ -27,6 +27,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem.hpp>
 #include <stdio.h>
+#include <map>
 #if defined VDEBUG && defined __GNUC__ && !defined(_WIN32)
 #include <execinfo.h>
 #endif
@@ -130,6 +131,50 @@ const char* WritingException::what() const throw () {
 WritingException::~WritingException() throw () {
 }
 
+ParsingDiagnostic::ParsingDiagnostic(Severity severity, const string& message, const string& fileName,
+        int lineNumber, const string& keyword, int field) :
+    severity(severity), message(message), fileName(fileName), lineNumber(lineNumber), keyword(keyword), field(field) {
+}
+
+const int ParsingDiagnostic::UNKNOWN_FIELD;
+
+void ParsingDiagnostics::add(const ParsingDiagnostic& diagnostic) {
+    diagnostics.push_back(diagnostic);
+}
+
+int ParsingDiagnostics::count(ParsingDiagnostic::Severity severity, const string& keyword) const {
+    int result = 0;
+    for (const auto& diagnostic : diagnostics) {
+        if (diagnostic.severity == severity && (keyword.empty() || diagnostic.keyword == keyword)) {
+            result++;
+        }
+    }
+    return result;
+}
+
+void ParsingDiagnostics::clear() {
+    diagnostics.clear();
+}
+
+void ParsingDiagnostics::printSummary(ostream& out) const {
+    // errors and warnings count, by keyword
+    map<string, pair<int, int>> countsByKeyword;
+    for (const auto& diagnostic : diagnostics) {
+        auto& counts = countsByKeyword[diagnostic.keyword.empty() ? "(no keyword)" : diagnostic.keyword];
+        if (diagnostic.severity == ParsingDiagnostic::Severity::ERROR) {
+            counts.first++;
+        } else {
+            counts.second++;
+        }
+    }
+    out << "Parsing diagnostics: " << count(ParsingDiagnostic::Severity::ERROR) << " error(s), "
+            << count(ParsingDiagnostic::Severity::WARNING) << " warning(s)." << endl;
+    for (const auto& keywordAndCounts : countsByKeyword) {
+        out << "  " << keywordAndCounts.first << ": " << keywordAndCounts.second.first << " error(s), "
+                << keywordAndCounts.second.second << " warning(s)" << endl;
+    }
+}
+
 Tokenizer::Tokenizer(istream& stream, vega::LogLevel logLevel,  string fileName, vega::ConfigurationParameters::TranslationMode translationMode) :
     instrream(stream), logLevel(logLevel), fileName(fileName), translationMode(translationMode), lineNumber(0), currentKeyword(""){
 }
@@ -145,11 +190,12 @@ void Tokenizer::handleParsingError(const string& message) {
         exit(2);
     case ConfigurationParameters::TranslationMode::MESH_AT_LEAST:
         //model->onlyMesh = true;
-        cerr << ParsingMessageException(message, fileName, lineNumber, currentKeyword) << endl;
-        throw std::string("skipCommand");
-        break;
     case ConfigurationParameters::TranslationMode::BEST_EFFORT:
         cerr << ParsingMessageException(message, fileName, lineNumber, currentKeyword) << endl;
+        if (diagnostics != nullptr) {
+            diagnostics->add(ParsingDiagnostic(ParsingDiagnostic::Severity::ERROR, message, fileName,
+                    lineNumber, currentKeyword, getCurrentField()));
+        }
         throw std::string("skipCommand");
         break;
     default:
@@ -160,6 +206,10 @@ void Tokenizer::handleParsingError(const string& message) {
 
 void Tokenizer::handleParsingWarning(const string& message) {
     cerr << ParsingMessageWarning(message, fileName, lineNumber, currentKeyword);
+    if (diagnostics != nullptr) {
+        diagnostics->add(ParsingDiagnostic(ParsingDiagnostic::Severity::WARNING, message, fileName,
+                lineNumber, currentKeyword, getCurrentField()));
+    }
 }
 
 
@@ -170,6 +220,13 @@ Parser::Parser(){
 
 void Parser::handleParsingError(const string& message, Tokenizer& tok,
         shared_ptr<Model> model) {
+    collectParsingError(message, tok, model);
+    // Not in strict mode: the caller is expected to dismiss the problematic command
+    throw std::string("skipCommand");
+}
+
+void Parser::collectParsingError(const string& message, Tokenizer& tok,
+        shared_ptr<Model> model) {
 
     switch (translationMode) {
     case ConfigurationParameters::TranslationMode::MODE_STRICT:
@@ -177,11 +234,13 @@ void Parser::handleParsingError(const string& message, Tokenizer& tok,
     case ConfigurationParameters::TranslationMode::MESH_AT_LEAST:
         model->onlyMesh = true;
         cerr << ParsingMessageException(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
-        throw std::string("skipCommand");
+        diagnostics.add(ParsingDiagnostic(ParsingDiagnostic::Severity::ERROR, message, tok.fileName,
+                tok.lineNumber, tok.currentKeyword, tok.getCurrentField()));
         break;
     case ConfigurationParameters::TranslationMode::BEST_EFFORT:
         cerr << ParsingMessageException(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
-        throw std::string("skipCommand");
+        diagnostics.add(ParsingDiagnostic(ParsingDiagnostic::Severity::ERROR, message, tok.fileName,
+                tok.lineNumber, tok.currentKeyword, tok.getCurrentField()));
         break;
     default:
         cerr << "Unknown enum class in Translation mode, assuming MODE_STRICT" << endl;
@@ -193,6 +252,8 @@ void Parser::handleParsingWarning(const string& message, Tokenizer& tok,
         shared_ptr<Model> model) {
     UNUSEDV(model);
     cerr << ParsingMessageWarning(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
+    diagnostics.add(ParsingDiagnostic(ParsingDiagnostic::Severity::WARNING, message, tok.fileName,
+            tok.lineNumber, tok.currentKeyword, tok.getCurrentField()));
 }
 
 void Writer::handleWritingError(const string& message, const string& keyword, const string& file) {
@@ -42,6 +42,53 @@ public:
 };
 
 
+/**
+ * A problem found by the parsing of the input model.
+ */
+class ParsingDiagnostic final {
+public:
+	enum class Severity {
+		WARNING,
+		ERROR
+	};
+	static const int UNKNOWN_FIELD = -1;
+	ParsingDiagnostic(Severity severity, const std::string& message, const std::string& fileName,
+			int lineNumber, const std::string& keyword, int field = UNKNOWN_FIELD);
+	const Severity severity;
+	const std::string message;
+	const std::string fileName;
+	const int lineNumber;
+	const std::string keyword;
+	const int field;
+};
+
+/**
+ * Buffer of the diagnostics collected during a parse.
+ * In non strict modes, errors are collected here instead of interrupting the translation,
+ * and summarized by keyword at the end of the parse.
+ */
+class ParsingDiagnostics final {
+private:
+	std::vector<ParsingDiagnostic> diagnostics;
+public:
+	void add(const ParsingDiagnostic& diagnostic);
+	const std::vector<ParsingDiagnostic>& getDiagnostics() const {
+		return diagnostics;
+	}
+	/**
+	 * Number of diagnostics of the given severity, for all keywords or for a single one.
+	 */
+	int count(ParsingDiagnostic::Severity severity, const std::string& keyword = "") const;
+	bool empty() const {
+		return diagnostics.empty();
+	}
+	void clear();
+	/**
+	 * Print the number of errors and warnings by keyword.
+	 */
+	void printSummary(std::ostream& out) const;
+};
+
 /**
  * Base class for all Tokenizers.
  */
@@ -56,6 +103,7 @@ protected:
 	std::string fileName;    /**< Current fileName: only used for printout and error managment. **/
 	vega::ConfigurationParameters::TranslationMode translationMode;
 	int lineNumber;
+	ParsingDiagnostics* diagnostics = nullptr; /**< Where the errors are collected, if set. **/
 	std::string currentKeyword; /**< Current Keyword: only used for printout and error managment. **/
 
 public:
@@ -67,6 +115,12 @@ public:
 	inline int getLineNumber() const {return lineNumber;};
 	inline std::string getCurrentKeyword() const {return currentKeyword;};
 	void setCurrentKeyword(std::string cK) {currentKeyword=cK;};
+	void setLineNumber(int lN) {lineNumber=lN;};
+	void setDiagnostics(ParsingDiagnostics* d) {diagnostics=d;};
+	/**
+	 * Index of the last field read, ParsingDiagnostic::UNKNOWN_FIELD if the tokenizer has no fields.
+	 */
+	virtual int getCurrentField() const {return ParsingDiagnostic::UNKNOWN_FIELD;};
 
     /**
      * Generic handler for parsing exceptions.
@@ -94,12 +148,23 @@ protected:
 	Parser();
 public:
 	ConfigurationParameters::TranslationMode translationMode;
+	ParsingDiagnostics diagnostics; /**< Errors and warnings of the last parse. **/
 	/**
 	 * Read a model from a specific file format.
 	 *
 	 * configuration: a set of configuration parameters usually specified on the command line
 	 */
 	virtual std::shared_ptr<Model> parse(const ConfigurationParameters& configuration) = 0;
+	/**
+	 * Read only the mesh of the model, writing it to the MED file medFileName while it is read,
+	 * without keeping it in memory. Returns false, without writing anything, if the parser can't
+	 * stream this input: parse() must then be used.
+	 */
+	virtual bool streamMesh(const ConfigurationParameters& configuration, const std::string& medFileName) {
+		UNUSEDV(configuration);
+		UNUSEDV(medFileName);
+		return false;
+	}
 
     /**
      * Generic handler for parsing exceptions.
@@ -108,6 +173,13 @@ public:
      */
 	void handleParsingError(const std::string& message, Tokenizer& tok, std::shared_ptr<Model> model);
 
+	/**
+	 * Handler for parsing errors after which the parser knows how to go on by itself.
+	 * Throw a ParsingException in strict mode, otherwise only collect the error: no exception is
+	 * thrown and it's up to the caller to skip the problematic command.
+	 */
+	void collectParsingError(const std::string& message, Tokenizer& tok, std::shared_ptr<Model> model);
+
     /**
      * Generic handler for parsing exception.
      * Throw a ParsingException in strict mode, which shuts the program, and a string otherwise, which
@@ -166,6 +166,133 @@ void handler(int sig) {
     exit(1);
 }
 
+//__________ IntervalList
+
+IntervalList::const_iterator::const_iterator(const vector<Interval>* intervals, size_t index) :
+        intervals(intervals), index(index), current(index < intervals->size() ? (*intervals)[index].start : 0) {
+}
+
+IntervalList::const_iterator& IntervalList::const_iterator::operator++() {
+    const Interval& interval = (*intervals)[index];
+    if (current < interval.end) {
+        current += interval.step;
+    } else {
+        index++;
+        if (index < intervals->size()) {
+            current = (*intervals)[index].start;
+        }
+    }
+    return *this;
+}
+
+IntervalList::const_iterator IntervalList::const_iterator::operator++(int) {
+    const_iterator result = *this;
+    ++(*this);
+    return result;
+}
+
+void IntervalList::push_back(int value) {
+    addRange(value, value);
+}
+
+void IntervalList::addRange(int start, int end, int step) {
+    if (step <= 0) {
+        throw invalid_argument("Interval step must be positive: " + to_string(step));
+    }
+    if (end < start) {
+        return;
+    }
+    // Make the end reachable from start
+    end = static_cast<int>(start + ((static_cast<long>(end) - start) / step) * step);
+    if (!intervals.empty()) {
+        Interval& last = intervals.back();
+        const long next = static_cast<long>(last.end) + last.step;
+        if (next == start && (start == end || last.step == step)) {
+            last.end = end;
+            return;
+        }
+        if (last.start == last.end && start == end && start > last.end) {
+            // Two single values make an interval
+            last.step = start - last.end;
+            last.end = start;
+            return;
+        }
+    }
+    intervals.push_back({start, end, step});
+}
+
+void IntervalList::append(const IntervalList& other) {
+    for (const Interval& interval : other.intervals) {
+        addRange(interval.start, interval.end, interval.step);
+    }
+}
+
+void IntervalList::pop_back() {
+    if (intervals.empty()) {
+        throw logic_error("pop_back on an empty IntervalList");
+    }
+    Interval& last = intervals.back();
+    if (last.start == last.end) {
+        intervals.pop_back();
+    } else {
+        last.end -= last.step;
+    }
+}
+
+size_t IntervalList::size() const {
+    size_t result = 0;
+    for (const Interval& interval : intervals) {
+        result += static_cast<size_t>((static_cast<long>(interval.end) - interval.start) / interval.step) + 1;
+    }
+    return result;
+}
+
+int IntervalList::front() const {
+    if (intervals.empty()) {
+        throw logic_error("front on an empty IntervalList");
+    }
+    return intervals.front().start;
+}
+
+int IntervalList::back() const {
+    if (intervals.empty()) {
+        throw logic_error("back on an empty IntervalList");
+    }
+    return intervals.back().end;
+}
+
+IntervalList::const_iterator IntervalList::begin() const {
+    return const_iterator(&intervals, 0);
+}
+
+IntervalList::const_iterator IntervalList::end() const {
+    return const_iterator(&intervals, intervals.size());
+}
+
+const string Symbol::EMPTY_STRING;
+
+Symbol SymbolTable::intern(const string& text) {
+    if (text.empty()) {
+        return Symbol();
+    }
+    lock_guard<std::mutex> lock(mutex);
+    return Symbol(&*strings.insert(text).first);
+}
+
+Symbol SymbolTable::find(const string& text) const {
+    if (text.empty()) {
+        return Symbol();
+    }
+    lock_guard<std::mutex> lock(mutex);
+    const auto it = strings.find(text);
+    return it == strings.end() ? Symbol() : Symbol(&*it);
+}
+
+size_t SymbolTable::size() const {
+    lock_guard<std::mutex> lock(mutex);
+    return strings.size();
+}
+
 //__________ ValueOrReference
 
 } /* namespace vega */
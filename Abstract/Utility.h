@@ -15,9 +15,18 @@
 
 #include <climits>
 #include <string>
+#include <vector>
+#include <iterator>
 #include <cmath>
 #include <stdio.h>
 #include <cfloat>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+#include <mutex>
+#include <unordered_set>
 
 #if defined(__GNUC__)
 // Avoid tons of warnings with the following code
@@ -80,5 +89,182 @@ struct EnumClassHash
     }
 };
 
+/**
+ * A compact list of integers, stored as runs of (start, end, step) instead of
+ * one element per value. Used for example to keep the Nastran "THRU" and "BY"
+ * ranges without expanding them.
+ */
+class IntervalList final {
+public:
+	struct Interval {
+		int start;
+		int end; /**< Last value of the interval, always reachable from start **/
+		int step;
+	};
+	class const_iterator final: public std::iterator<std::forward_iterator_tag, int> {
+	private:
+		friend IntervalList;
+		const std::vector<Interval>* intervals;
+		size_t index;
+		int current;
+		const_iterator(const std::vector<Interval>* intervals, size_t index);
+	public:
+		const_iterator& operator++();
+		const_iterator operator++(int);
+		int operator*() const {
+			return current;
+		}
+		bool operator==(const const_iterator& rhs) const {
+			return index == rhs.index && (index == intervals->size() || current == rhs.current);
+		}
+		bool operator!=(const const_iterator& rhs) const {
+			return !(*this == rhs);
+		}
+	};
+private:
+	std::vector<Interval> intervals;
+public:
+	/**
+	 * Add a single value, merged with the last interval when it continues it.
+	 */
+	void push_back(int value);
+	/**
+	 * Add all the values from start to end (included if reachable) by step.
+	 * Throws invalid_argument if step is not positive.
+	 */
+	void addRange(int start, int end, int step = 1);
+	/**
+	 * Add all the intervals of another list, keeping their order.
+	 */
+	void append(const IntervalList& other);
+	/**
+	 * Remove the last value.
+	 */
+	void pop_back();
+	size_t size() const;
+	bool empty() const {
+		return intervals.empty();
+	}
+	int front() const;
+	int back() const;
+	const std::vector<Interval>& getIntervals() const {
+		return intervals;
+	}
+	const_iterator begin() const;
+	const_iterator end() const;
+};
+
+/**
+ * Split [0, count[ in contiguous chunks and call function(begin, end) on each of them, with one
+ * thread per chunk (at most hardware_concurrency), when count is large enough to be worth it.
+ * Returns the results of the chunks in chunk order, so that merging them is deterministic.
+ * The exception of the first failing chunk is rethrown in the calling thread.
+ */
+template<typename Result, typename Function>
+std::vector<Result> parallelChunks(size_t count, Function function, size_t minimumChunkSize = 4096) {
+	if (count < 2 * minimumChunkSize) {
+		return std::vector<Result>{function(static_cast<size_t>(0), count)};
+	}
+	// hardware_concurrency() may read system files: only once
+	static const size_t hardwareThreadCount = std::max(1u, std::thread::hardware_concurrency());
+	const size_t threadCount = std::min(hardwareThreadCount, count / minimumChunkSize);
+	if (threadCount <= 1) {
+		return std::vector<Result>{function(static_cast<size_t>(0), count)};
+	}
+	const size_t chunkSize = (count + threadCount - 1) / threadCount;
+	std::vector<Result> results(threadCount);
+	std::vector<std::exception_ptr> errors(threadCount);
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (size_t chunk = 0; chunk < threadCount; chunk++) {
+		threads.emplace_back([&, chunk]() {
+			try {
+				results[chunk] = function(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+			} catch (...) {
+				errors[chunk] = std::current_exception();
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	for (const auto& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+	return results;
+}
+
+/**
+ * A string interned in a SymbolTable: each distinct string is stored once in the table.
+ * Symbols of the same table are compared and hashed by identity, without reading their
+ * characters, and stay valid as long as their table.
+ */
+class Symbol final {
+private:
+	friend class SymbolTable;
+	friend struct SymbolHash;
+	static const std::string EMPTY_STRING;
+	const std::string* text;
+	explicit Symbol(const std::string* text) :
+			text(text) {
+	}
+public:
+	/**
+	 * The empty string, shared by all the tables.
+	 */
+	Symbol() :
+			text(&EMPTY_STRING) {
+	}
+	const std::string& str() const {
+		return *text;
+	}
+	bool empty() const {
+		return text->empty();
+	}
+	bool operator==(const Symbol& rhs) const {
+		return text == rhs.text;
+	}
+	bool operator!=(const Symbol& rhs) const {
+		return text != rhs.text;
+	}
+	/**
+	 * Alphabetical order, so that containers of symbols are iterated as containers of strings.
+	 */
+	bool operator<(const Symbol& rhs) const {
+		return text != rhs.text && *text < *rhs.text;
+	}
+};
+
+struct SymbolHash {
+	std::size_t operator()(const Symbol& symbol) const {
+		return std::hash<const std::string*>()(symbol.text);
+	}
+};
+
+/**
+ * Table of the interned strings of a model (group names, comments...). Interning may be
+ * done concurrently.
+ */
+class SymbolTable final {
+private:
+	std::unordered_set<std::string> strings; /**< Nodes are never moved: symbols can point to them **/
+	mutable std::mutex mutex;
+public:
+	SymbolTable() = default;
+	SymbolTable(const SymbolTable&) = delete;
+	SymbolTable& operator=(const SymbolTable&) = delete;
+	/**
+	 * Symbol of this string, added to the table if needed.
+	 */
+	Symbol intern(const std::string& text);
+	/**
+	 * Symbol of this string if it was already interned, empty Symbol otherwise. The table is not changed.
+	 */
+	Symbol find(const std::string& text) const;
+	size_t size() const;
+};
+
 } /* namespace vega */
 #endif /* UTILITY_H_ */
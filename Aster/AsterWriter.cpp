@@ -11,13 +11,17 @@
 #include "AsterWriter.h"
 #include "build_properties.h"
 #include "../Abstract/Model.h"
+#include "../Abstract/OutputManifest.h"
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <memory>
 #include <string>
 #include <fstream>
+#include <future>
+#include <sstream>
 #include <limits>
+#include <algorithm>
 
 #include <ciso646>
 
@@ -27,6 +31,9 @@ using namespace std;
 namespace vega {
 namespace aster {
 
+const string AsterWriter::NODE_LIST_COMMENT = "Node list of the .comm";
+const string AsterWriter::CELL_LIST_COMMENT = "Cell list of the .comm";
+
 AsterWriter::AsterWriter() {
 
 }
@@ -45,25 +52,54 @@ string AsterWriter::writeModel(const shared_ptr<vega::Model> model_ptr,
 		throw iostream::failure("Directory " + path + " don't exist.");
 	}
 
-  fs::path inputFile(asterModel.configuration.inputFile);
+	fs::path inputFile(asterModel.configuration.inputFile);
 	if (fs::exists(inputFile)) {
-		fs::copy_file(inputFile, fs::absolute(path) / inputFile.filename(), fs::copy_option::overwrite_if_exists);
+		copyToOutput(inputFile, fs::absolute(path), asterModel.configuration.linkInputFiles);
 	}
 
-  fs::path testFile = asterModel.configuration.resultFile;
+	fs::path testFile = asterModel.configuration.resultFile;
 	if (fs::exists(testFile)) {
-		fs::copy_file(testFile, fs::absolute(path) / testFile.filename(), fs::copy_option::overwrite_if_exists);
+		copyToOutput(testFile, fs::absolute(path), asterModel.configuration.linkInputFiles);
 	}
 
 	string exp_path = asterModel.getOutputFileName(".export");
 	string med_path = asterModel.getOutputFileName(".med");
 	string comm_path = asterModel.getOutputFileName(".comm");
 
-	model_ptr->mesh->writeMED(*model_ptr, med_path.c_str());
+	// The groups of the long node and cell lists of the .comm are added to the mesh first: the .comm
+	// only references them by their names, so it is formatted while the MED file is written in the
+	// background.
+	mesh = model_ptr->mesh;
+	maxInlineListSize = configuration.asterMaxInlineListSize;
+	findListGroups();
+	createListGroups(asterModel);
+
+	// In incremental mode, the MED file is only written if the mesh, or Vega, changed
+	unique_ptr<OutputManifest> manifest;
+	uint64_t meshHash = 0;
+	bool writeMesh = true;
+	if (configuration.incremental) {
+		manifest = unique_ptr<OutputManifest>(new OutputManifest(asterModel.getOutputFileName(".manifest")));
+		ContentHash hash;
+		hash.add(VEGA_VERSION_MAJOR).add(VEGA_VERSION_MINOR).add(VEGA_VERSION_PATCH).add(string(VEGA_VERSION_EXTRA));
+		hash.add(static_cast<long long>(mesh->contentHash()));
+		meshHash = hash.getValue();
+		writeMesh = !manifest->isUnchanged(med_path, meshHash);
+		if (!writeMesh && configuration.logLevel >= LogLevel::INFO) {
+			cout << "Mesh unchanged, " << med_path << " not written." << endl;
+		}
+	}
+	future<void> medWriting;
+	if (writeMesh) {
+		medWriting = async(launch::async, [&model_ptr, &med_path]() {
+			model_ptr->mesh->writeMED(*model_ptr, med_path.c_str());
+		});
+	}
 
-	ofstream comm_file_ofs;
-	//comm_file_ofs.setf(ios::scientific);
- 	comm_file_ofs.precision(DBL_DIG);
+	ostringstream comm;
+	//comm.setf(ios::scientific);
+	comm.precision(DBL_DIG);
+	this->writeComm(asterModel, comm);
 
 	ofstream exp_file_ofs;
 	exp_file_ofs.open(exp_path.c_str(), ios::trunc | ios::out);
@@ -74,17 +110,45 @@ string AsterWriter::writeModel(const shared_ptr<vega::Model> model_ptr,
 	this->writeExport(asterModel, exp_file_ofs);
 	exp_file_ofs.close();
 
+	ofstream comm_file_ofs;
 	comm_file_ofs.open(comm_path.c_str(), ios::out | ios::trunc);
 
 	if (!comm_file_ofs.is_open()) {
 		string message = string("Can't open file ") + comm_path + " for writing.";
 		throw ios::failure(message);
 	}
-	this->writeComm(asterModel, comm_file_ofs);
+	const string& commText = comm.str();
+	comm_file_ofs.write(commText.data(), static_cast<streamsize>(commText.size()));
 	comm_file_ofs.close();
+
+	if (writeMesh) {
+		medWriting.get();
+	}
+	if (manifest != nullptr) {
+		manifest->update(med_path, meshHash);
+		manifest->save();
+	}
 	return exp_path;
 }
 
+void AsterWriter::copyToOutput(const fs::path& file, const fs::path& directory, bool hardLink) {
+	const fs::path target = directory / file.filename();
+	if (fs::equivalent(fs::absolute(file).parent_path(), directory)) {
+		return;
+	}
+	// A hard link of a previous translation must be removed, not overwritten: it would overwrite the input too
+	boost::system::error_code error;
+	fs::remove(target, error);
+	if (hardLink) {
+		// Links between devices, or on some file systems, fall back to a real copy
+		fs::create_hard_link(file, target, error);
+		if (!error) {
+			return;
+		}
+	}
+	fs::copy_file(file, target, fs::copy_option::overwrite_if_exists);
+}
+
 void AsterWriter::writeExport(AsterModel &model, ostream& out) {
 	out << "P actions make_etude" << endl;
 	out << "P mem_aster 100.0" << endl;
@@ -392,25 +456,23 @@ void AsterWriter::writeLireMaillage(const AsterModel& asterModel, ostream& out)
 		if (not constraintSet.hasContacts()) {
 			continue;
 		}
-        const set<shared_ptr<Constraint>> zones = constraintSet.getConstraintsByType(
-				Constraint::Type::ZONE_CONTACT);
+        const auto& zones = constraintSet.getConstraintsByType<Constraint::Type::ZONE_CONTACT>();
         if (zones.empty()) {
             continue;
         }
         out << mail_name << "=MODI_MAILLAGE(reuse="<< mail_name << ",";
         out << "MAILLAGE=" << mail_name << "," << endl;
         // TODO LD should find a better solution
-        int firstNodePosition = *((*zones.begin())->nodePositions().begin());
+        int firstNodePosition = *(zones.front().get().nodePositions().begin());
         if (asterModel.model.mesh->findNode(firstNodePosition).dofs == DOFS::ALL_DOFS) {
             out << "         ORIE_PEAU_2D=(" << endl;
         } else {
             out << "         ORIE_PEAU_3D=(" << endl;
         }
-		for (shared_ptr<Constraint> constraint : zones) {
-		    shared_ptr<const ZoneContact> zone = dynamic_pointer_cast<const ZoneContact>(constraint);
-		    shared_ptr<const ContactBody> master = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone->master));
+		for (const ZoneContact& zone : zones) {
+		    shared_ptr<const ContactBody> master = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone.master));
 		    shared_ptr<const BoundarySurface> masterSurface = dynamic_pointer_cast<const BoundarySurface>(asterModel.model.find(master->boundary));
-		    shared_ptr<const ContactBody> slave = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone->slave));
+		    shared_ptr<const ContactBody> slave = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone.slave));
 		    shared_ptr<const BoundarySurface> slaveSurface = dynamic_pointer_cast<const BoundarySurface>(asterModel.model.find(slave->boundary));
             out << "                             _F(";
             writeCellContainer(*masterSurface, out);
@@ -429,18 +491,16 @@ void AsterWriter::writeLireMaillage(const AsterModel& asterModel, ostream& out)
 		if (not constraintSet.hasContacts()) {
 			continue;
 		}
-        const set<shared_ptr<Constraint>> surfaces = constraintSet.getConstraintsByType(
-				Constraint::Type::SURFACE_SLIDE_CONTACT);
+        const auto& surfaces = constraintSet.getConstraintsByType<Constraint::Type::SURFACE_SLIDE_CONTACT>();
         if (surfaces.empty()) {
             continue;
         }
         out << mail_name << "=MODI_MAILLAGE(reuse="<< mail_name << ",";
         out << "MAILLAGE=" << mail_name << "," << endl;
         out << "         ORIE_PEAU_3D=(" << endl;
-		for (shared_ptr<Constraint> constraint : surfaces) {
-		    shared_ptr<const SurfaceSlideContact> surface = dynamic_pointer_cast<const SurfaceSlideContact>(constraint);
-		    shared_ptr<const BoundaryElementFace> masterSurface = dynamic_pointer_cast<const BoundaryElementFace>(asterModel.model.find(surface->master));
-		    shared_ptr<const BoundaryElementFace> slaveSurface = dynamic_pointer_cast<const BoundaryElementFace>(asterModel.model.find(surface->slave));
+		for (const SurfaceSlideContact& surface : surfaces) {
+		    shared_ptr<const BoundaryElementFace> masterSurface = dynamic_pointer_cast<const BoundaryElementFace>(asterModel.model.find(surface.master));
+		    shared_ptr<const BoundaryElementFace> slaveSurface = dynamic_pointer_cast<const BoundaryElementFace>(asterModel.model.find(surface.slave));
             out << "                             _F(";
             out << "GROUP_MA=('"
                     << masterSurface->cellGroup->getName() << "', '"
@@ -629,13 +689,12 @@ void AsterWriter::writeMaterials(const AsterModel& asterModel, ostream& out) {
 		out << "                 );" << "# Original id:" << material->getOriginalId() << endl << endl;
 	}
 
-	vector<shared_ptr<ElementSet>> composites = asterModel.model.elementSets.filter(ElementSet::Type::COMPOSITE);
+	const auto& composites = asterModel.model.elementSets.filter<ElementSet::Type::COMPOSITE>();
     out << "                    # writing " << composites.size() << " composites" << endl;
-    for (shared_ptr<ElementSet> c : composites) {
-        shared_ptr<Composite> composite = dynamic_pointer_cast<Composite>(c);
-        out << "MC" << composite->getId() << "=DEFI_COMPOSITE(" << endl;
+    for (const Composite& composite : composites) {
+        out << "MC" << composite.getId() << "=DEFI_COMPOSITE(" << endl;
         out << "                 COUCHE=(" << endl;
-        for (auto& layer : composite->getLayers()) {
+        for (auto& layer : composite.getLayers()) {
             out << "                     _F(EPAIS=" << layer.getThickness() << ",  MATER=M" << layer.getMaterialId() << ", ORIENTATION=" << layer.getOrientation() << ")," << endl;
         }
         out << "                         )," << endl;
@@ -656,9 +715,8 @@ void AsterWriter::writeMaterials(const AsterModel& asterModel, ostream& out) {
             << endl;
       }
     }
-    for (shared_ptr<ElementSet> c : composites) {
-        shared_ptr<Composite> composite = dynamic_pointer_cast<Composite>(c);
-          out << "                          _F(MATER=MC" << composite ->getId() << ", GROUP_MA='" << composite->cellGroup->getName() << "')," << endl;
+    for (const Composite& composite : composites) {
+          out << "                          _F(MATER=MC" << composite.getId() << ", GROUP_MA='" << composite.cellGroup->getName() << "')," << endl;
     }
     out << "                          )," << endl;
     out << "                    );" << endl << endl;
@@ -670,30 +728,24 @@ void AsterWriter::writeAffeCaraElem(const AsterModel& asterModel, ostream& out)
 	if (asterModel.model.elementSets.size() > 0) {
 		out << "CAEL=AFFE_CARA_ELEM(MODELE=MODMECA," << endl;
 
-		vector<shared_ptr<ElementSet>> discrets_0d = asterModel.model.elementSets.filter(
-				ElementSet::Type::DISCRETE_0D);
-		vector<shared_ptr<ElementSet>> discrets_1d = asterModel.model.elementSets.filter(
-				ElementSet::Type::DISCRETE_1D);
-		vector<shared_ptr<ElementSet>> nodal_masses = asterModel.model.elementSets.filter(
-				ElementSet::Type::NODAL_MASS);
-		vector<shared_ptr<ElementSet>> scalar_springs = asterModel.model.elementSets.filter(
-				ElementSet::Type::SCALAR_SPRING);
-		vector<shared_ptr<ElementSet>> structural_segments = asterModel.model.elementSets.filter(
-				ElementSet::Type::STRUCTURAL_SEGMENT);
+		const auto& discrets_0d = asterModel.model.elementSets.filter<ElementSet::Type::DISCRETE_0D>();
+		const auto& discrets_1d = asterModel.model.elementSets.filter<ElementSet::Type::DISCRETE_1D>();
+		const auto& nodal_masses = asterModel.model.elementSets.filter<ElementSet::Type::NODAL_MASS>();
+		const auto& scalar_springs = asterModel.model.elementSets.filter<ElementSet::Type::SCALAR_SPRING>();
+		const auto& structural_segments = asterModel.model.elementSets.filter<ElementSet::Type::STRUCTURAL_SEGMENT>();
         auto numDiscrets = discrets_0d.size() + nodal_masses.size() + discrets_1d.size() + structural_segments.size() + scalar_springs.size();
 		out << "                    # writing " << numDiscrets << " discrets" << endl;
 		if (numDiscrets > 0) {
 			out << "                    DISCRET=(" << endl;
-			for (shared_ptr<ElementSet> discret : discrets_0d) {
-				if (discret->cellGroup != nullptr) {
+			for (const DiscretePoint& discret_0d : discrets_0d) {
+				if (discret_0d.cellGroup != nullptr) {
 					out << "                             _F(GROUP_MA='"
-							<< discret->cellGroup->getName() << "'," << endl;
-					shared_ptr<DiscretePoint> discret_0d = dynamic_pointer_cast<DiscretePoint>(discret);
-					if (discret_0d->hasRotations())
+							<< discret_0d.cellGroup->getName() << "'," << endl;
+					if (discret_0d.hasRotations())
 						out << "                                CARA='K_TR_D_N', VALE=(";
 					else
 						out << "                                CARA='K_T_D_N', VALE=(";
-					for (double rigi : discret_0d->asStiffnessVector())
+					for (double rigi : discret_0d.asStiffnessVector())
 						out << rigi << ",";
 					out << "),)," << endl;
 				} else
@@ -701,16 +753,15 @@ void AsterWriter::writeAffeCaraElem(const AsterModel& asterModel, ostream& out)
 							<< "                             # WARN Finite Element : DISCRETE_0D ignored because its GROUP_MA is empty."
 							<< endl;
 			}
-			for (shared_ptr<ElementSet> discret : discrets_1d) {
-				if (discret->cellGroup != nullptr) {
+			for (const DiscreteSegment& discret_1d : discrets_1d) {
+				if (discret_1d.cellGroup != nullptr) {
 					out << "                             _F(GROUP_MA='"
-							<< discret->cellGroup->getName() << "'," << endl;
-					shared_ptr<DiscreteSegment> discret_1d = dynamic_pointer_cast<DiscreteSegment>(discret);
-					if (discret_1d->hasRotations())
+							<< discret_1d.cellGroup->getName() << "'," << endl;
+					if (discret_1d.hasRotations())
 						out << "                                CARA='K_TR_L', VALE=(";
 					else
 						out << "                                CARA='K_T_L', VALE=(";
-					for (double rigi : discret_1d->asStiffnessVector())
+					for (double rigi : discret_1d.asStiffnessVector())
 						out << rigi << ",";
 					out << "),)," << endl;
 				} else
@@ -718,26 +769,25 @@ void AsterWriter::writeAffeCaraElem(const AsterModel& asterModel, ostream& out)
 							<< "                             # WARN Finite Element : DISCRETE_1D ignored because its GROUP_MA is empty."
 							<< endl;
 			}
-			for (shared_ptr<ElementSet> segment : structural_segments) {
-				if (segment->cellGroup != nullptr) {
-					shared_ptr<StructuralSegment> segment_1d = dynamic_pointer_cast<StructuralSegment>(segment);
+			for (const StructuralSegment& segment_1d : structural_segments) {
+				if (segment_1d.cellGroup != nullptr) {
 					out << "                             _F(GROUP_MA='"
-							<< segment_1d->cellGroup->getName() << "'," << endl;
-					if (segment_1d->hasRotations())
+							<< segment_1d.cellGroup->getName() << "'," << endl;
+					if (segment_1d.hasRotations())
 						out << "                                CARA='K_TR_L', VALE=(";
 					else
 						out << "                                CARA='K_T_L', VALE=(";
-					for (double rigi : segment_1d->asStiffnessVector())
+					for (double rigi : segment_1d.asStiffnessVector())
 						out << rigi << ",";
 					out << "),)," << endl;
 
 					out << "                             _F(GROUP_MA='"
-							<< segment_1d->cellGroup->getName() << "'," << endl;
-					if (segment_1d->hasRotations())
+							<< segment_1d.cellGroup->getName() << "'," << endl;
+					if (segment_1d.hasRotations())
 						out << "                                CARA='A_TR_L', VALE=(";
 					else
 						out << "                                CARA='A_T_L', VALE=(";
-					for (double rigi : segment_1d->asDampingVector())
+					for (double rigi : segment_1d.asDampingVector())
 						out << rigi << ",";
 					out << "),)," << endl;
 				} else
@@ -745,26 +795,25 @@ void AsterWriter::writeAffeCaraElem(const AsterModel& asterModel, ostream& out)
 							<< "                             # WARN Finite Element : DISCRETE_1D ignored because its GROUP_MA is empty."
 							<< endl;
 			}
-			for (shared_ptr<ElementSet> scalar_springset : scalar_springs) {
-				if (scalar_springset->cellGroup != nullptr) {
+			for (const ScalarSpring& spring : scalar_springs) {
+				if (spring.cellGroup != nullptr) {
 					out << "                             _F(GROUP_MA='"
-							<< scalar_springset->cellGroup->getName() << "'," << endl;
-					shared_ptr<ScalarSpring> spring = dynamic_pointer_cast<ScalarSpring>(scalar_springset);
-					if (spring->hasStiffness()) {
-                        if (spring->hasRotations())
+							<< spring.cellGroup->getName() << "'," << endl;
+					if (spring.hasStiffness()) {
+                        if (spring.hasRotations())
                             out << "                                CARA='K_TR_L', VALE=(";
                         else
                             out << "                                CARA='K_T_L', VALE=(";
-                        for (double rigi : spring->asStiffnessVector())
+                        for (double rigi : spring.asStiffnessVector())
                             out << rigi << ",";
                         out << "),";
                     }
-					if (spring->hasDamping()) {
-                        if (spring->hasRotations())
+					if (spring.hasDamping()) {
+                        if (spring.hasRotations())
                             out << "                                CARA='A_TR_L', VALE=(";
                         else
                             out << "                                CARA='A_T_L', VALE=(";
-                        for (double dampval : spring->asDampingVector())
+                        for (double dampval : spring.asDampingVector())
                             out << dampval << ",";
                         out << "),";
                     }
@@ -774,16 +823,15 @@ void AsterWriter::writeAffeCaraElem(const AsterModel& asterModel, ostream& out)
 							<< "                             # WARN Finite Element : DISCRETE_1D ignored because its GROUP_MA is empty."
 							<< endl;
 			}
-			for (shared_ptr<ElementSet> discret : nodal_masses) {
-				if (discret->cellGroup != nullptr) {
+			for (const NodalMass& nodalMass : nodal_masses) {
+				if (nodalMass.cellGroup != nullptr) {
 					out << "                             _F(GROUP_MA='"
-							<< discret->cellGroup->getName() << "'," << endl;
-					shared_ptr<NodalMass> nodalMass = dynamic_pointer_cast<NodalMass>(discret);
+							<< nodalMass.cellGroup->getName() << "'," << endl;
 					out << "                                CARA='M_TR_D_N',VALE=("
-							<< nodalMass->getMass() << "," << nodalMass->ixx << ","
-							<< nodalMass->iyy << "," << nodalMass->izz << "," << nodalMass->ixy
-							<< "," << nodalMass->iyz << "," << nodalMass->ixz << ","
-							<< nodalMass->ex << "," << nodalMass->ey << "," << nodalMass->ez
+							<< nodalMass.getMass() << "," << nodalMass.ixx << ","
+							<< nodalMass.iyy << "," << nodalMass.izz << "," << nodalMass.ixy
+							<< "," << nodalMass.iyz << "," << nodalMass.ixz << ","
+							<< nodalMass.ex << "," << nodalMass.ey << "," << nodalMass.ez
 							<< "),)," << endl;
 				} else
 					out
@@ -802,33 +850,32 @@ void AsterWriter::writeAffeCaraElem(const AsterModel& asterModel, ostream& out)
 			}
 			out << "                            )," << endl;
 		}
-		vector<shared_ptr<ElementSet>> shells = asterModel.model.elementSets.filter(ElementSet::Type::SHELL);
-		vector<shared_ptr<ElementSet>> composites = asterModel.model.elementSets.filter(ElementSet::Type::COMPOSITE);
+		const auto& shells = asterModel.model.elementSets.filter<ElementSet::Type::SHELL>();
+		const auto& composites = asterModel.model.elementSets.filter<ElementSet::Type::COMPOSITE>();
 		out << "                    # writing " << shells.size()+composites.size() << " shells (ou composites)" << endl;
 		if (shells.size() + +composites.size() > 0) {
 			calc_sigm = true;
 			out << "                    COQUE=(" << endl;
-			for (shared_ptr<ElementSet> shell : shells) {
-				if (shell->cellGroup != nullptr) {
-					out << "                           _F(GROUP_MA='" << shell->cellGroup->getName()
+			for (const Shell& shell : shells) {
+				if (shell.cellGroup != nullptr) {
+					out << "                           _F(GROUP_MA='" << shell.cellGroup->getName()
 							<< "'," << endl;
 					out << "                              EPAIS="
-							<< dynamic_pointer_cast<Shell>(shell)->thickness << "," << endl;
+							<< shell.thickness << "," << endl;
 					out << "                              VECTEUR=(0.9,0.1,0.2))," << endl;
 				} else
 					out
 							<< "                           # WARN Finite Element : COQUE ignored because its GROUP_MA is empty."
 							<< endl;
 			}
-			for (shared_ptr<ElementSet> c : composites) {
-                shared_ptr<Composite> composite = dynamic_pointer_cast<Composite>(c);
-				if (composite->cellGroup != nullptr) {
-					out << "                           _F(GROUP_MA='" << composite->cellGroup->getName()
+			for (const Composite& composite : composites) {
+				if (composite.cellGroup != nullptr) {
+					out << "                           _F(GROUP_MA='" << composite.cellGroup->getName()
 							<< "'," << endl;
 					out << "                              EPAIS="
-							<< composite->getTotalThickness() << "," << endl;
+							<< composite.getTotalThickness() << "," << endl;
 					out << "                              COQUE_NCOU="
-							<< composite->getLayers().size() << "," << endl;
+							<< composite.getLayers().size() << "," << endl;
 					out << "                              VECTEUR=(1.0,0.0,0.0))," << endl;
 				} else
 					out
@@ -1010,21 +1057,16 @@ void AsterWriter::writeDefiContact(const AsterModel& asterModel, ostream& out) {
 		if (not constraintSet.hasContacts()) {
 			continue;
 		}
-		const set<shared_ptr<Constraint>> gaps = constraintSet.getConstraintsByType(
-				Constraint::Type::GAP);
-        const set<shared_ptr<Constraint>> slides = constraintSet.getConstraintsByType(
-				Constraint::Type::SLIDE);
-        const set<shared_ptr<Constraint>> surfaces = constraintSet.getConstraintsByType(
-				Constraint::Type::SURFACE_CONTACT);
-        const set<shared_ptr<Constraint>> zones = constraintSet.getConstraintsByType(
-				Constraint::Type::ZONE_CONTACT);
-		for (shared_ptr<Constraint> constraint : gaps) {
-			shared_ptr<const Gap> gap = dynamic_pointer_cast<const Gap>(constraint);
+		const auto& gaps = constraintSet.getConstraintsByType<Constraint::Type::GAP>();
+        const auto& slides = constraintSet.getConstraintsByType<Constraint::Type::SLIDE>();
+        const auto& surfaces = constraintSet.getConstraintsByType<Constraint::Type::SURFACE_CONTACT>();
+        const auto& zones = constraintSet.getConstraintsByType<Constraint::Type::ZONE_CONTACT>();
+		for (const Gap& gap : gaps) {
 			int gapCount = 0;
-			for (shared_ptr<Gap::GapParticipation> gapParticipation : gap->getGaps()) {
+			for (shared_ptr<Gap::GapParticipation> gapParticipation : gap.getGaps()) {
 				gapCount++;
 				out << "C" << constraintSet.getId() << "I" << to_string(gapCount)
-						<< "=DEFI_CONSTANTE(VALE=" << gap->initial_gap_opening << ")" << endl;
+						<< "=DEFI_CONSTANTE(VALE=" << gap.initial_gap_opening << ")" << endl;
 				if (!is_zero(gapParticipation->direction.x())) {
 					out << "C" << constraintSet.getId() << "MX" << to_string(gapCount)
 							<< "=DEFI_CONSTANTE(VALE=" << gapParticipation->direction.x() << ")"
@@ -1054,10 +1096,9 @@ void AsterWriter::writeDefiContact(const AsterModel& asterModel, ostream& out) {
 		    out << "                   FORMULATION='CONTINUE'," << endl;
 		}
 		out << "                   ZONE=(" << endl;
-		for (shared_ptr<Constraint> constraint : gaps) {
-			shared_ptr<const Gap> gap = dynamic_pointer_cast<const Gap>(constraint);
+		for (const Gap& gap : gaps) {
 			int gapCount = 0;
-			for (shared_ptr<Gap::GapParticipation> gapParticipation : gap->getGaps()) {
+			for (shared_ptr<Gap::GapParticipation> gapParticipation : gap.getGaps()) {
 				gapCount++;
 				out << "                             _F(";
 				out << "NOEUD='"
@@ -1090,34 +1131,31 @@ void AsterWriter::writeDefiContact(const AsterModel& asterModel, ostream& out) {
 				out << ")," << endl;
 			}
 		}
-		for (shared_ptr<Constraint> constraint : slides) {
-		    shared_ptr<const SlideContact> slide = dynamic_pointer_cast<const SlideContact>(constraint);
+		for (const SlideContact& slide : slides) {
                 out << "                             _F(";
 				out << "GROUP_MA_MAIT='"
-						<< slide->masterCellGroup->getName()
+						<< slide.masterCellGroup->getName()
 						<< "',";
 				out << "GROUP_MA_ESCL='"
-						<< slide->slaveCellGroup->getName()
+						<< slide.slaveCellGroup->getName()
 						<< "',";
-                out << "COULOMB=" << slide->getFriction() << ",";
+                out << "COULOMB=" << slide.getFriction() << ",";
 				out << ")," << endl;
 		}
-		for (shared_ptr<Constraint> constraint : surfaces) {
-		    shared_ptr<const SurfaceContact> surface = dynamic_pointer_cast<const SurfaceContact>(constraint);
+		for (const SurfaceContact& surface : surfaces) {
                 out << "                             _F(";
 				out << "GROUP_MA_MAIT='"
-						<< surface->masterCellGroup->getName()
+						<< surface.masterCellGroup->getName()
 						<< "',";
 				out << "GROUP_MA_ESCL='"
-						<< surface->slaveCellGroup->getName()
+						<< surface.slaveCellGroup->getName()
 						<< "',";
 				out << ")," << endl;
 		}
-		for (shared_ptr<Constraint> constraint : zones) {
-		    shared_ptr<const ZoneContact> zone = dynamic_pointer_cast<const ZoneContact>(constraint);
-		    shared_ptr<const ContactBody> master = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone->master));
+		for (const ZoneContact& zone : zones) {
+		    shared_ptr<const ContactBody> master = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone.master));
 		    shared_ptr<const BoundarySurface> masterSurface = dynamic_pointer_cast<const BoundarySurface>(asterModel.model.find(master->boundary));
-		    shared_ptr<const ContactBody> slave = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone->slave));
+		    shared_ptr<const ContactBody> slave = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(zone.slave));
 		    shared_ptr<const BoundarySurface> slaveSurface = dynamic_pointer_cast<const BoundarySurface>(asterModel.model.find(slave->boundary));
             out << "                             _F(";
 
@@ -1141,33 +1179,32 @@ void AsterWriter::writeDefiContact(const AsterModel& asterModel, ostream& out) {
 void AsterWriter::writeSPC(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream&out) {
   UNUSEDV(asterModel);
-	const set<shared_ptr<Constraint>> spcs = cset.getConstraintsByType(Constraint::Type::SPC);
+	const auto& spcs = cset.getConstraintsByType<Constraint::Type::SPC>();
 	if (spcs.size() > 0) {
 		out << "                   DDL_IMPO=(" << endl;
-		for (shared_ptr<Constraint> constraint : spcs) {
-			shared_ptr<const SinglePointConstraint> spc = dynamic_pointer_cast<
-					const SinglePointConstraint>(constraint);
+		for (const SinglePointConstraint& spc : spcs) {
 			//FIXME: filter spcs with type function.
-			if (spc->hasReferences()) {
-				cerr << "SPC references not supported " << *spc << endl;
+			if (spc.hasReferences()) {
+				cerr << "SPC references not supported " << spc << endl;
 				out << " ************************" << endl << "SPC references not supported "
-						<< *spc
+						<< spc
 						<< endl;
 			} else {
 				out << "                             _F(";
-				if (spc->group == nullptr) {
-					out << "NOEUD=(";
-					for (int nodePosition : spc->nodePositions()) {
-						out << "'"
-								<< Node::MedName(nodePosition)
-								<< "', ";
+				if (spc.group == nullptr && spc.nodePositions().size() > maxInlineListSize) {
+					out << "GROUP_NO='" << getNodeListGroupName(spc.nodePositions()) << "',";
+				} else if (spc.group == nullptr) {
+					OutputBuffer buffer(out);
+					buffer << "NOEUD=(";
+					for (int nodePosition : spc.nodePositions()) {
+						buffer << '\'' << Node::MedName(nodePosition) << "', ";
 					}
-					out << "),";
+					buffer << "),";
 				} else {
-					out << "GROUP_NO='" << spc->group->getName() << "',";
+					out << "GROUP_NO='" << spc.group->getName() << "',";
 				}
 				//parameter 0 ignored
-				for (const DOF dof : spc->getDOFSForNode(0)) {
+				for (const DOF dof : spc.getDOFSForNode(0)) {
 					if (dof == DOF::DX)
 						out << "DX";
 					if (dof == DOF::DY)
@@ -1180,7 +1217,7 @@ void AsterWriter::writeSPC(const AsterModel& asterModel, const ConstraintSet& cs
 						out << "DRY";
 					if (dof == DOF::RZ)
 						out << "DRZ";
-					out << "=" << spc->getDoubleForDOF(dof) << ", ";
+					out << "=" << spc.getDoubleForDOF(dof) << ", ";
 				}
 				out << ")," << endl;
 			}
@@ -1192,15 +1229,13 @@ void AsterWriter::writeLIAISON_SOLIDE(const AsterModel& asterModel, const Constr
 		ostream& out) {
   UNUSEDV(asterModel);
 
-	const set<shared_ptr<Constraint>> rigidConstraints = cset.getConstraintsByType(
-			Constraint::Type::RIGID);
-	const set<shared_ptr<Constraint>> quasiRigidConstraints = cset.getConstraintsByType(
-			Constraint::Type::QUASI_RIGID);
-	vector<shared_ptr<Constraint>> constraints;
+	const auto& rigidConstraints = cset.getConstraintsByType<Constraint::Type::RIGID>();
+	const auto& quasiRigidConstraints = cset.getConstraintsByType<Constraint::Type::QUASI_RIGID>();
+	vector<reference_wrapper<const Constraint>> constraints;
 	constraints.reserve(rigidConstraints.size() + quasiRigidConstraints.size());
 	constraints.assign(rigidConstraints.begin(), rigidConstraints.end());
-	for (shared_ptr<Constraint> quasiRigidConstraint : quasiRigidConstraints) {
-		if ((dynamic_pointer_cast<QuasiRigidConstraint>(quasiRigidConstraint)->isCompletelyRigid())) {
+	for (const QuasiRigidConstraint& quasiRigidConstraint : quasiRigidConstraints) {
+		if (quasiRigidConstraint.isCompletelyRigid()) {
 			constraints.push_back(quasiRigidConstraint);
 		}
 	}
@@ -1208,12 +1243,19 @@ void AsterWriter::writeLIAISON_SOLIDE(const AsterModel& asterModel, const Constr
 
 	if (needLiaisonSolide) {
 		out << "                   LIAISON_SOLIDE=(" << endl;
-		for (auto constraintPtr : constraints) {
-			out << "                                   _F(NOEUD=(";
-			for (int node : constraintPtr->nodePositions()) {
-				out << "'" << Node::MedName(node) << "',";
+		for (const Constraint& constraint : constraints) {
+			const set<int>& nodePositions = constraint.nodePositions();
+			OutputBuffer buffer(out);
+			if (nodePositions.size() > maxInlineListSize) {
+				buffer << "                                   _F(GROUP_NO='" << getNodeListGroupName(nodePositions) << "',\n";
+			} else {
+				buffer << "                                   _F(NOEUD=(";
+				for (int node : nodePositions) {
+					buffer << '\'' << Node::MedName(node) << "',";
+				}
+				buffer << "),\n";
 			}
-			out << ")," << endl;
+			buffer.flush();
 			out << "                                      )," << endl;
 
 		}
@@ -1224,17 +1266,16 @@ void AsterWriter::writeLIAISON_SOLIDE(const AsterModel& asterModel, const Constr
 void AsterWriter::writeRBE3(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream& out) {
   UNUSEDV(asterModel);
-	const set<shared_ptr<Constraint>> constraints = cset.getConstraintsByType(Constraint::Type::RBE3);
+	const auto& constraints = cset.getConstraintsByType<Constraint::Type::RBE3>();
 	if (constraints.size() > 0) {
 		out << "                   LIAISON_RBE3=(" << endl;
-		for (auto constraint : constraints) {
-			shared_ptr<const RBE3> rbe3 = dynamic_pointer_cast<const RBE3>(constraint);
-			int masterNode = rbe3->getMaster();
+		for (const RBE3& rbe3 : constraints) {
+			int masterNode = rbe3.getMaster();
 			out << "                                 _F(NOEUD_MAIT='"
 					<< Node::MedName(masterNode) << "',"
 					<< endl;
 			out << "                                    DDL_MAIT=(";
-			DOFS dofs = rbe3->getDOFSForNode(masterNode);
+			DOFS dofs = rbe3.getDOFSForNode(masterNode);
 			if (dofs.contains(DOF::DX))
 				out << "'DX',";
 			if (dofs.contains(DOF::DY))
@@ -1248,7 +1289,7 @@ void AsterWriter::writeRBE3(const AsterModel& asterModel, const ConstraintSet& c
 			if (dofs.contains(DOF::RZ))
 				out << "'DRZ',";
 			out << ")," << endl;
-			set<int> slaveNodes = rbe3->getSlaves();
+			set<int> slaveNodes = rbe3.getSlaves();
 
 			out << "                                    NOEUD_ESCL=(";
 			for (int slaveNode : slaveNodes) {
@@ -1257,7 +1298,7 @@ void AsterWriter::writeRBE3(const AsterModel& asterModel, const ConstraintSet& c
 			out << ")," << endl;
 			out << "                                    DDL_ESCL=(";
 			for (int slaveNode : slaveNodes) {
-				DOFS slaveDofs = rbe3->getDOFSForNode(slaveNode);
+				DOFS slaveDofs = rbe3.getDOFSForNode(slaveNode);
 				int size = 0;
 				out << "'";
 				if (slaveDofs.contains(DOF::DX)) {
@@ -1293,7 +1334,7 @@ void AsterWriter::writeRBE3(const AsterModel& asterModel, const ConstraintSet& c
 			out << ")," << endl;
 			out << "                                    COEF_ESCL=(";
 			for (int slaveNode : slaveNodes) {
-				out << rbe3->getCoefForNode(slaveNode) << ",";
+				out << rbe3.getCoefForNode(slaveNode) << ",";
 			}
 			out << ")," << endl;
 			out << "                                    )," << endl;
@@ -1305,17 +1346,19 @@ void AsterWriter::writeRBE3(const AsterModel& asterModel, const ConstraintSet& c
 void AsterWriter::writeLMPC(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream& out) {
   UNUSEDV(asterModel);
-	const set<shared_ptr<Constraint>> lmpcs = cset.getConstraintsByType(Constraint::Type::LMPC);
+	// Written by id: the set order depends on memory addresses
+	auto lmpcs = cset.getConstraintsByType<Constraint::Type::LMPC>();
+	sort(lmpcs.begin(), lmpcs.end(), [](const LinearMultiplePointConstraint& a, const LinearMultiplePointConstraint& b) {
+		return a.getId() < b.getId();
+	});
 	if (lmpcs.size() > 0) {
 		out << "                   LIAISON_DDL=(" << endl;
-		for (shared_ptr<Constraint> constraint : lmpcs) {
-			shared_ptr<const LinearMultiplePointConstraint> lmpc = dynamic_pointer_cast<
-					const LinearMultiplePointConstraint>(constraint);
+		for (const LinearMultiplePointConstraint& lmpc : lmpcs) {
 			out << "                                _F(NOEUD=(";
-			set<int> nodes = lmpc->nodePositions();
+			set<int> nodes = lmpc.nodePositions();
 			for (int nodePosition : nodes) {
 				string nodeName = Node::MedName(nodePosition);
-				DOFS dofs = lmpc->getDOFSForNode(nodePosition);
+				DOFS dofs = lmpc.getDOFSForNode(nodePosition);
 				for (int i = 0; i < dofs.size(); i++) {
 					out << "'" << nodeName << "', ";
 				}
@@ -1323,7 +1366,7 @@ void AsterWriter::writeLMPC(const AsterModel& asterModel, const ConstraintSet& c
 			out << ")," << endl;
 			out << "                                   DDL=(";
 			for (int nodePosition : nodes) {
-				DOFS dofs = lmpc->getDOFSForNode(nodePosition);
+				DOFS dofs = lmpc.getDOFSForNode(nodePosition);
 				if (dofs.contains(DOF::DX))
 					out << "'DX', ";
 				if (dofs.contains(DOF::DY))
@@ -1340,14 +1383,14 @@ void AsterWriter::writeLMPC(const AsterModel& asterModel, const ConstraintSet& c
 			out << ")," << endl;
 			out << "                                   COEF_MULT=(";
 			for (int nodePosition : nodes) {
-			    DOFCoefs dofcoef = lmpc->getDoFCoefsForNode(nodePosition);
+			    DOFCoefs dofcoef = lmpc.getDoFCoefsForNode(nodePosition);
 				for (int i = 0; i < 6; i++) {
 					if (!is_zero(dofcoef[i]))
 						out << dofcoef[i] << ", ";
 				}
 			}
 			out << ")," << endl;
-			out << "                                   COEF_IMPO=" << lmpc->coef_impo << "),"
+			out << "                                   COEF_IMPO=" << lmpc.coef_impo << "),"
 					<< endl;
 		}
 		out << "                               )," << endl;
@@ -1355,14 +1398,13 @@ void AsterWriter::writeLMPC(const AsterModel& asterModel, const ConstraintSet& c
 }
 
 void AsterWriter::writeGravity(const LoadSet& loadSet, ostream& out) {
-	const set<shared_ptr<Loading>> gravities = loadSet.getLoadingsByType(Loading::Type::GRAVITY);
+	const auto& gravities = loadSet.getLoadingsByType<Loading::Type::GRAVITY>();
 	if (gravities.size() > 0) {
 		out << "                      PESANTEUR=(" << endl;
-		for (shared_ptr<Loading> loading : gravities) {
-			shared_ptr<Gravity> gravity = dynamic_pointer_cast<Gravity>(loading);
-			out << "                                 _F(GRAVITE=" << gravity->getAcceleration()
+		for (const Gravity& gravity : gravities) {
+			out << "                                 _F(GRAVITE=" << gravity.getAcceleration()
 					<< "," << endl;
-			VectorialValue direction = gravity->getDirection();
+			VectorialValue direction = gravity.getDirection();
 			out << "                                    DIRECTION=(" << direction.x() << ","
 					<< direction.y() << "," << direction.z() << "),)," << endl;
 		}
@@ -1371,17 +1413,16 @@ void AsterWriter::writeGravity(const LoadSet& loadSet, ostream& out) {
 }
 
 void AsterWriter::writeRotation(const LoadSet& loadSet, ostream& out) {
-	const set<shared_ptr<Loading>> rotations = loadSet.getLoadingsByType(Loading::Type::ROTATION);
+	const auto& rotations = loadSet.getLoadingsByType<Loading::Type::ROTATION>();
 	if (rotations.size() > 0) {
 		out << "                      ROTATION=(" << endl;
-		for (shared_ptr<Loading> loading : rotations) {
-			shared_ptr<Rotation> rotation = dynamic_pointer_cast<Rotation>(loading);
-			out << "                                 _F(VITESSE=" << rotation->getSpeed() << ","
+		for (const Rotation& rotation : rotations) {
+			out << "                                 _F(VITESSE=" << rotation.getSpeed() << ","
 					<< endl;
-			VectorialValue axis = rotation->getAxis();
+			VectorialValue axis = rotation.getAxis();
 			out << "                                    AXE=(" << axis.x() << "," << axis.y() << ","
 					<< axis.z() << ")," << endl;
-			VectorialValue center = rotation->getCenter();
+			VectorialValue center = rotation.getCenter();
 			out << "                                    CENTRE=(" << center.x() << "," << center.y()
 					<< "," << center.z() << ")";
 			out << ",)," << endl;
@@ -1392,14 +1433,13 @@ void AsterWriter::writeRotation(const LoadSet& loadSet, ostream& out) {
 
 void AsterWriter::writeNodalForce(const AsterModel& asterModel, const LoadSet& loadSet, ostream& out) {
   UNUSEDV(asterModel);
-	const set<shared_ptr<Loading>> nodalForces = loadSet.getLoadingsByType(Loading::Type::NODAL_FORCE);
+	const auto& nodalForces = loadSet.getLoadingsByType<Loading::Type::NODAL_FORCE>();
 	if (nodalForces.size() > 0) {
 		out << "                      FORCE_NODALE=(" << endl;
-		for (shared_ptr<Loading> loading : nodalForces) {
-			shared_ptr<NodalForce> nodal_force = dynamic_pointer_cast<NodalForce>(loading);
-			for(auto& nodePosition : nodal_force->nodePositions()) {
-                VectorialValue force = nodal_force->getForceInGlobalCS(nodePosition);
-                VectorialValue moment = nodal_force->getMomentInGlobalCS(nodePosition);
+		for (const NodalForce& nodal_force : nodalForces) {
+			for(auto& nodePosition : nodal_force.nodePositions()) {
+                VectorialValue force = nodal_force.getForceInGlobalCS(nodePosition);
+                VectorialValue moment = nodal_force.getMomentInGlobalCS(nodePosition);
                 out << "                                    _F(NOEUD='"
                         << Node::MedName(nodePosition) << "',";
                 if (!is_zero(force.x()))
@@ -1424,15 +1464,12 @@ void AsterWriter::writeNodalForce(const AsterModel& asterModel, const LoadSet& l
 
 void AsterWriter::writePression(const LoadSet& loadSet, ostream& out) {
 	return; // TODO : check if the cellContainer contain skin or shell elements
-	const set<shared_ptr<Loading>> loading = loadSet.getLoadingsByType(
-			Loading::Type::NORMAL_PRESSION_FACE);
+	const auto& loading = loadSet.getLoadingsByType<Loading::Type::NORMAL_PRESSION_FACE>();
 	if (loading.size() > 0) {
 		out << "           PRESS_REP=(" << endl;
-		for (shared_ptr<Loading> pressionFace : loading) {
-			shared_ptr<NormalPressionFace> normalPressionFace = dynamic_pointer_cast<
-					NormalPressionFace>(pressionFace);
-			out << "                         _F(PRES= " << normalPressionFace->intensity << endl;
-			writeCellContainer(*normalPressionFace, out);
+		for (const NormalPressionFace& normalPressionFace : loading) {
+			out << "                         _F(PRES= " << normalPressionFace.intensity << endl;
+			writeCellContainer(normalPressionFace, out);
 			out << "                         )," << endl;
 		}
 		out << "                      )," << endl;
@@ -1440,15 +1477,12 @@ void AsterWriter::writePression(const LoadSet& loadSet, ostream& out) {
 }
 
 void AsterWriter::writeForceCoque(const LoadSet& loadSet, ostream&out) {
-	const set<shared_ptr<Loading> > pressionFaces = loadSet.getLoadingsByType(
-			Loading::Type::NORMAL_PRESSION_FACE);
+	const auto& pressionFaces = loadSet.getLoadingsByType<Loading::Type::NORMAL_PRESSION_FACE>();
 	if (pressionFaces.size() > 0) {
 		out << "           FORCE_COQUE=(" << endl;
-		for (shared_ptr<Loading> pressionFace : pressionFaces) {
-			shared_ptr<NormalPressionFace> normalPressionFace = dynamic_pointer_cast<
-					NormalPressionFace>(pressionFace);
-			out << "                        _F(PRES=" << normalPressionFace->intensity << ",";
-			writeCellContainer(*normalPressionFace, out);
+		for (const NormalPressionFace& normalPressionFace : pressionFaces) {
+			out << "                        _F(PRES=" << normalPressionFace.intensity << ",";
+			writeCellContainer(normalPressionFace, out);
 			out << "                         )," << endl;
 		}
 		out << "            )," << endl;
@@ -1456,13 +1490,11 @@ void AsterWriter::writeForceCoque(const LoadSet& loadSet, ostream&out) {
 }
 
 void AsterWriter::writeForceLine(const LoadSet& loadset, ostream& out) {
-	const set<shared_ptr<Loading> > forcesLine = loadset.getLoadingsByType(Loading::Type::FORCE_LINE);
-	vector<shared_ptr<ForceLine>> forcesOnPoutres;
-	vector<shared_ptr<ForceLine>> forcesOnGeometry;
+	vector<reference_wrapper<const ForceLine>> forcesOnPoutres;
+	vector<reference_wrapper<const ForceLine>> forcesOnGeometry;
 
-	for (shared_ptr<Loading> loadingForceLine : forcesLine) {
-		shared_ptr<ForceLine> forceLine = dynamic_pointer_cast<ForceLine>(loadingForceLine);
-		if (forceLine->appliedToGeometry()) {
+	for (const ForceLine& forceLine : loadset.getLoadingsByType<Loading::Type::FORCE_LINE>()) {
+		if (forceLine.appliedToGeometry()) {
 			forcesOnGeometry.push_back(forceLine);
 		} else {
 			forcesOnPoutres.push_back(forceLine);
@@ -1470,9 +1502,9 @@ void AsterWriter::writeForceLine(const LoadSet& loadset, ostream& out) {
 	}
 	if (forcesOnPoutres.size() > 0) {
 		out << "           FORCE_POUTRE=(" << endl;
-		for (shared_ptr<ForceLine> forceLine : forcesOnPoutres) {
+		for (const ForceLine& forceLine : forcesOnPoutres) {
             out << "                   _F(";
-            switch(forceLine->dof.code) {
+            switch(forceLine.dof.code) {
             case DOF::Code::DX_CODE:
                 out << "FX";
                 break;
@@ -1494,8 +1526,8 @@ void AsterWriter::writeForceLine(const LoadSet& loadset, ostream& out) {
             default:
                 throw logic_error("DOF not yet handled");
             }
-            out << "=" << asternameByValue[forceLine->force->getReference()] << ",";
-            writeCellContainer(*forceLine, out);
+            out << "=" << asternameByValue[forceLine.force->getReference()] << ",";
+            writeCellContainer(forceLine, out);
             out << "          )," << endl;
 		}
 		out << "            )," << endl;
@@ -1508,16 +1540,14 @@ void AsterWriter::writeForceLine(const LoadSet& loadset, ostream& out) {
 
 }
 void AsterWriter::writeForceSurface(const LoadSet& loadSet, ostream&out) {
-	const set<shared_ptr<Loading> > forceSurfaces = loadSet.getLoadingsByType(
-			Loading::Type::FORCE_SURFACE);
+	const auto& forceSurfaces = loadSet.getLoadingsByType<Loading::Type::FORCE_SURFACE>();
 	if (forceSurfaces.size() > 0) {
 		out << "           FORCE_FACE=(" << endl;
-		for (auto& loading : forceSurfaces) {
-			shared_ptr<ForceSurface> forceSurface = dynamic_pointer_cast<ForceSurface>(loading);
-			VectorialValue force = forceSurface->getForce();
-			VectorialValue moment = forceSurface->getMoment();
+		for (const ForceSurface& forceSurface : forceSurfaces) {
+			VectorialValue force = forceSurface.getForce();
+			VectorialValue moment = forceSurface.getMoment();
 			out << "                       _F(";
-			writeCellContainer(*forceSurface, out);
+			writeCellContainer(forceSurface, out);
 			out << endl;
 			if (!is_equal(force.x(), 0))
 				out << "FX=" << force.x() << ",";
@@ -1539,30 +1569,187 @@ void AsterWriter::writeForceSurface(const LoadSet& loadSet, ostream&out) {
 
 void AsterWriter::writeCellContainer(const CellContainer& cellContainer, ostream& out) {
     int celem = 0;
-    if (cellContainer.hasCellGroups()) {
+    vector<string> groupNames;
+    for (auto& cellGroup : cellContainer.getCellGroups()) {
+      groupNames.push_back(cellGroup->getName());
+    }
+    vector<int> cellIds;
+    if (cellContainer.hasCells()) {
+      cellIds = cellContainer.getCellIds();
+      if (cellIds.size() > maxInlineListSize) {
+        groupNames.push_back(getCellListGroupName(cellIds));
+        cellIds.clear();
+      }
+    }
+    if (!groupNames.empty()) {
       out << "GROUP_MA=(";
-      for (auto& cellGroup : cellContainer.getCellGroups()) {
+      for (const string& groupName : groupNames) {
         celem++;
-        out << "'" << cellGroup->getName() << "',";
+        out << "'" << groupName << "',";
         if (celem % 6 == 0) {
           out << endl << "                             ";
         }
       }
       out << "),";
     }
-    if (cellContainer.hasCells()) {
-      out << "MAILLE=(";
-      for (Cell cell : cellContainer.getCells()) {
+    if (!cellIds.empty()) {
+      OutputBuffer buffer(out);
+      buffer << "MAILLE=(";
+      for (int cellId : cellIds) {
         celem++;
-        out << "'M" << cell.id << "',";
+        buffer << "'M" << cellId << "',";
         if (celem % 6 == 0) {
-          out << endl << "                             ";
+          buffer << "\n                             ";
         }
       }
-      out << "),";
+      buffer << "),";
     }
 }
 
+string AsterWriter::getNodeListGroupName(const set<int>& nodePositions) {
+	const vector<int> key(nodePositions.begin(), nodePositions.end());
+	auto it = groupNameByNodePositions.find(key);
+	if (it != groupNameByNodePositions.end()) {
+		return it->second;
+	}
+	if (listGroupsCreated) {
+		throw logic_error("Node list not found by createListGroups().");
+	}
+	const string name = newListGroupName();
+	shared_ptr<NodeGroup> nodeGroup = mesh->createNodeGroup(name, NodeGroup::NO_ORIGINAL_ID, NODE_LIST_COMMENT);
+	for (int nodePosition : nodePositions) {
+		nodeGroup->addNodeByPosition(nodePosition);
+	}
+	groupNameByNodePositions[key] = name;
+	return name;
+}
+
+string AsterWriter::getCellListGroupName(const vector<int>& cellIds) {
+	vector<int> key(cellIds);
+	sort(key.begin(), key.end());
+	auto it = groupNameByCellIds.find(key);
+	if (it != groupNameByCellIds.end()) {
+		return it->second;
+	}
+	if (listGroupsCreated) {
+		throw logic_error("Cell list not found by createListGroups().");
+	}
+	const string name = newListGroupName();
+	shared_ptr<CellGroup> cellGroup = mesh->createCellGroup(name, CellGroup::NO_ORIGINAL_ID, CELL_LIST_COMMENT);
+	for (int cellId : key) {
+		cellGroup->addCellId(cellId);
+	}
+	groupNameByCellIds[key] = name;
+	return name;
+}
+
+void AsterWriter::findListGroups() {
+	listGroupsCreated = false;
+	groupNameByNodePositions.clear();
+	groupNameByCellIds.clear();
+	for (const auto& nodeGroup : mesh->getNodeGroups()) {
+		if (nodeGroup->getComment() == NODE_LIST_COMMENT) {
+			const set<int>& nodePositions = nodeGroup->nodePositions();
+			groupNameByNodePositions[vector<int>(nodePositions.begin(), nodePositions.end())] = nodeGroup->getName();
+		}
+	}
+	for (const auto& cellGroup : mesh->getCellGroups()) {
+		if (cellGroup->getComment() == CELL_LIST_COMMENT) {
+			const set<int>& cellIds = cellGroup->getCellIds();
+			groupNameByCellIds[vector<int>(cellIds.begin(), cellIds.end())] = cellGroup->getName();
+		}
+	}
+}
+
+void AsterWriter::createCellListGroup(const CellContainer& cellContainer) {
+	if (cellContainer.hasCells()) {
+		const vector<int>& cellIds = cellContainer.getCellIds();
+		if (cellIds.size() > maxInlineListSize) {
+			getCellListGroupName(cellIds);
+		}
+	}
+}
+
+void AsterWriter::createListGroups(const AsterModel& asterModel) {
+	// Same order as writeComm(), which gives the same group names
+	for (const auto& constraintSet : asterModel.model.constraintSets) {
+		if (not constraintSet->hasContacts()) {
+			continue;
+		}
+		for (const ZoneContact& zone : constraintSet->getConstraintsByType<Constraint::Type::ZONE_CONTACT>()) {
+			for (const Reference<Target>& bodyReference : {zone.master, zone.slave}) {
+				shared_ptr<const ContactBody> body = dynamic_pointer_cast<const ContactBody>(asterModel.model.find(bodyReference));
+				createCellListGroup(*dynamic_pointer_cast<const BoundarySurface>(asterModel.model.find(body->boundary)));
+			}
+		}
+	}
+	for (const auto& material : asterModel.model.materials) {
+		createCellListGroup(material->getAssignment());
+	}
+	for (const auto& constraintSet : asterModel.model.constraintSets) {
+		bool contactOnly = true;
+		for (const auto& constraint : constraintSet->getConstraints()) {
+			if (not constraint->isContact()) {
+				contactOnly = false;
+				break;
+			}
+		}
+		if (contactOnly) {
+			continue;
+		}
+		for (const SinglePointConstraint& spc : constraintSet->getConstraintsByType<Constraint::Type::SPC>()) {
+			if (not spc.hasReferences() && spc.group == nullptr && spc.nodePositions().size() > maxInlineListSize) {
+				getNodeListGroupName(spc.nodePositions());
+			}
+		}
+		for (const Constraint& rigid : constraintSet->getConstraintsByType<Constraint::Type::RIGID>()) {
+			if (rigid.nodePositions().size() > maxInlineListSize) {
+				getNodeListGroupName(rigid.nodePositions());
+			}
+		}
+		for (const QuasiRigidConstraint& quasiRigid : constraintSet->getConstraintsByType<Constraint::Type::QUASI_RIGID>()) {
+			if (quasiRigid.isCompletelyRigid() && quasiRigid.nodePositions().size() > maxInlineListSize) {
+				getNodeListGroupName(quasiRigid.nodePositions());
+			}
+		}
+	}
+	for (const auto& loadSet : asterModel.model.loadSets) {
+		if (loadSet->type == LoadSet::Type::DLOAD || loadSet->getLoadings().size() == 0
+				|| loadSet->getLoadings().size() == loadSet->getLoadingsByType(Loading::Type::INITIAL_TEMPERATURE).size()) {
+			continue;
+		}
+		for (const NormalPressionFace& normalPressionFace : loadSet->getLoadingsByType<Loading::Type::NORMAL_PRESSION_FACE>()) {
+			createCellListGroup(normalPressionFace);
+		}
+		for (const ForceSurface& forceSurface : loadSet->getLoadingsByType<Loading::Type::FORCE_SURFACE>()) {
+			createCellListGroup(forceSurface);
+		}
+		for (const ForceLine& forceLine : loadSet->getLoadingsByType<Loading::Type::FORCE_LINE>()) {
+			if (not forceLine.appliedToGeometry()) {
+				createCellListGroup(forceLine);
+			}
+		}
+	}
+	listGroupsCreated = true;
+}
+
+string AsterWriter::newListGroupName() const {
+	static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	size_t number = groupNameByNodePositions.size() + groupNameByCellIds.size();
+	string name;
+	do {
+		string base36;
+		for (size_t n = ++number; n > 0; n /= 36) {
+			base36.insert(base36.begin(), digits[n % 36]);
+		}
+		if (base36.size() > 6) {
+			throw logic_error("Too many node and cell lists to write them as groups.");
+		}
+		name = "LS" + base36;
+	} while (mesh->findGroup(name) != nullptr);
+	return name;
+}
+
 shared_ptr<NonLinearStrategy> AsterWriter::getNonLinearStrategy(
 		NonLinearMecaStat& nonLinAnalysis) {
 	shared_ptr<NonLinearStrategy> nonLinearStrategy;
@@ -21,6 +21,7 @@
 #include "../Abstract/Model.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "../Abstract/OutputBuffer.h"
 
 namespace vega {
 namespace aster {
@@ -32,7 +33,20 @@ class AsterWriter final : public Writer{
 	std::map<Reference<LoadSet>, std::string> asternameByLoadSet;
 	std::map<Reference<ConstraintSet>, std::string> asternameByConstraintSet;
 	static constexpr double SMALLEST_RELATIVE_COMPARISON = 1e-7;
+	static const std::string NODE_LIST_COMMENT; /**< Comment of the node groups of the long lists */
+	static const std::string CELL_LIST_COMMENT; /**< Comment of the cell groups of the long lists */
+	size_t maxInlineListSize = 1000; /**< Longer node and cell lists are written as groups of the mesh */
+	std::shared_ptr<Mesh> mesh; /**< Mesh of the model being written, which receives the groups of the long lists */
+	std::map<std::vector<int>, std::string> groupNameByNodePositions;
+	std::map<std::vector<int>, std::string> groupNameByCellIds;
+	bool listGroupsCreated = false; /**< Once set, the mesh, being written, must not get new list groups */
 
+	/**
+	 * Put a copy of file in directory. With hardLink, a hard link when possible: it shares its
+	 * content with file.
+	 */
+	static void copyToOutput(const boost::filesystem::path& file, const boost::filesystem::path& directory,
+			bool hardLink = false);
 	void writeExport(AsterModel& model, std::ostream&);
 	void writeComm(const AsterModel& model, std::ostream&);
 	void writeLireMaillage(const AsterModel&, std::ostream&);
@@ -55,6 +69,29 @@ class AsterWriter final : public Writer{
 	void writeForceLine(const LoadSet&, std::ostream&);
 	void writeForceSurface(const LoadSet&, std::ostream&);
 	void writeCellContainer(const CellContainer& cellContainer, std::ostream&);
+	/**
+	 * Name of a group of the mesh holding exactly these nodes: created for the first list having
+	 * them, then reused by the identical lists. The .comm is parsed faster, and is smaller, when
+	 * long lists are replaced by groups.
+	 */
+	std::string getNodeListGroupName(const std::set<int>& nodePositions);
+	/**
+	 * Name of a group of the mesh holding exactly these cells, see getNodeListGroupName().
+	 */
+	std::string getCellListGroupName(const std::vector<int>& cellIds);
+	/**
+	 * Find the list groups created in the mesh by a previous writing, so that they are reused.
+	 */
+	void findListGroups();
+	/**
+	 * Add to the mesh the groups of all the long lists of the .comm, before the MED file is written.
+	 */
+	void createListGroups(const AsterModel&);
+	void createCellListGroup(const CellContainer& cellContainer);
+	/**
+	 * First free name LS<n> for a list group, n in base 36: at most 8 characters, as MED requires.
+	 */
+	std::string newListGroupName() const;
 	double writeAnalysis(const AsterModel&, Analysis& analysis, std::ostream&, double debut);
 	void writeAssemblage(const AsterModel&, Analysis& analysis, std::ostream&);
 	void writeDynamicExcitation(Analysis& analysis, std::ostream&);
@@ -20,8 +20,13 @@
 #include "../Systus/SystusWriter.h"
 #include "../Systus/SystusRunner.h"
 #include "../ResultReaders/ResultReadersFacade.h"
+#if defined(unix)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -75,26 +80,28 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
         const ConfigurationParameters& configuration, string& modelFileOut,
         const Solver& inputSolver) {
 
-    vega::SolverName outputSolver = configuration.outputSolver.getSolverName();
-    const auto& writerIterator = writersBySolverName.find(outputSolver);
-    if (writerIterator == writersBySolverName.end()) {
-        cerr << "Output format " << configuration.outputSolver << "not supported." << endl;
-        return ExitCode::INVALID_COMMAND_LINE;
-    }
-    shared_ptr<Writer> writer = writerIterator->second;
-
     const auto& parserIterator = parserBySolverName.find(inputSolver.getSolverName());
     if (parserIterator == parserBySolverName.end()) {
         cerr << "Input format " << inputSolver << "not supported." << endl;
         return ExitCode::INVALID_COMMAND_LINE;
     }
-
-    if (configuration.logLevel >= LogLevel::TRACE) {
-        cout << "Selected writer: " << *writer << endl;
+    if (writersBySolverName.find(configuration.outputSolver.getSolverName()) == writersBySolverName.end()) {
+        cerr << "Output format " << configuration.outputSolver << "not supported." << endl;
+        return ExitCode::INVALID_COMMAND_LINE;
     }
 
     // Parsing the input file
     shared_ptr<Parser> parser = parserIterator->second;
+    if (configuration.meshOnly && configuration.outputSolver.getSolverName() == SolverName::CODE_ASTER
+            && !configuration.runSolver) {
+        // Written directly to the MED file, when the parser can do it, without building the Model
+        const fs::path medPath = fs::absolute(configuration.outputPath)
+                / (fs::path(configuration.inputFile).stem().string() + ".med");
+        if (parser->streamMesh(configuration, medPath.string())) {
+            modelFileOut.append(medPath.string());
+            return ExitCode::OK;
+        }
+    }
     shared_ptr<Model> model = parser->parse(configuration);
 
     //adding assertions if result file is set in the model
@@ -104,6 +111,24 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
         resultReader->add_assertions(configuration, model);
     }
 
+    return writeStudy(configuration, model, modelFileOut);
+}
+
+VegaCommandLine::ExitCode VegaCommandLine::writeStudy(const ConfigurationParameters& configuration,
+        shared_ptr<Model> model, string& modelFileOut) {
+
+    vega::SolverName outputSolver = configuration.outputSolver.getSolverName();
+    const auto& writerIterator = writersBySolverName.find(outputSolver);
+    if (writerIterator == writersBySolverName.end()) {
+        cerr << "Output format " << configuration.outputSolver << "not supported." << endl;
+        return ExitCode::INVALID_COMMAND_LINE;
+    }
+    shared_ptr<Writer> writer = writerIterator->second;
+
+    if (configuration.logLevel >= LogLevel::TRACE) {
+        cout << "Selected writer: " << *writer << endl;
+    }
+
     model->finish();
     bool validationResult = model->validate();
     if (!validationResult
@@ -117,6 +142,78 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
     return ExitCode::OK;
 }
 
+VegaCommandLine::ExitCode VegaCommandLine::convertStudies(
+        const vector<ConfigurationParameters>& configurations, const Solver& inputSolver) {
+#if defined(unix)
+    for (const auto& configuration : configurations) {
+        if (writersBySolverName.find(configuration.outputSolver.getSolverName()) == writersBySolverName.end()) {
+            cerr << "Output format " << configuration.outputSolver << "not supported." << endl;
+            return ExitCode::INVALID_COMMAND_LINE;
+        }
+    }
+    const auto& parserIterator = parserBySolverName.find(inputSolver.getSolverName());
+    if (parserIterator == parserBySolverName.end()) {
+        cerr << "Input format " << inputSolver << "not supported." << endl;
+        return ExitCode::INVALID_COMMAND_LINE;
+    }
+
+    // The parsed model does not depend on the output solver, only its finish() does
+    const ConfigurationParameters& parseConfiguration = configurations.front();
+    shared_ptr<Parser> parser = parserIterator->second;
+    shared_ptr<Model> model = parser->parse(parseConfiguration);
+    shared_ptr<ResultReader> resultReader = result::ResultReadersFacade::getResultReader(
+            parseConfiguration);
+    if (resultReader) {
+        resultReader->add_assertions(parseConfiguration, model);
+    }
+
+    // Model can't be copied: every child gets a copy-on-write image of the parsed model,
+    // automatic ids counters included, and so writes exactly what a single output run writes.
+    cout.flush();
+    cerr.flush();
+    vector<pid_t> childPids;
+    for (const auto& configuration : configurations) {
+        pid_t childPid = fork();
+        if (childPid == 0) {
+            model->reconfigure(configuration.getModelConfiguration());
+            string modelFile;
+            ExitCode result = writeStudy(configuration, model, modelFile);
+            if (result == ExitCode::OK && configuration.runSolver) {
+                result = runSolver(configuration, modelFile);
+            }
+            cout.flush();
+            exit(static_cast<int>(result));
+        } else if (childPid < 0) {
+            cerr << "fork failed " << childPid << " for output format " << configuration.outputSolver << endl;
+            break;
+        }
+        childPids.push_back(childPid);
+    }
+
+    ExitCode result = childPids.size() == configurations.size() ? ExitCode::OK : ExitCode::FORK_FAILED;
+    for (size_t i = 0; i < childPids.size(); i++) {
+        int status = 0;
+        waitpid(childPids[i], &status, 0);
+        ExitCode childResult = ExitCode::CHILD_CRASHED;
+        if (WIFEXITED(status)) {
+            childResult = static_cast<ExitCode>(WEXITSTATUS(status));
+        }
+        if (childResult != ExitCode::OK) {
+            cerr << "Translation to " << configurations[i].outputSolver << " failed: "
+                    << exitCodeToString(childResult) << endl;
+            if (result == ExitCode::OK) {
+                result = childResult;
+            }
+        }
+    }
+    return result;
+#else
+    UNUSEDV(configurations);
+    UNUSEDV(inputSolver);
+    throw invalid_argument("Several output formats at once are only available on unix.");
+#endif
+}
+
 fs::path VegaCommandLine::normalize_path(string strpath) {
     if (strpath.front() == '"' || strpath.front() == '\'') {
         strpath.erase(0, 1); // erase the first character
@@ -125,7 +222,25 @@ fs::path VegaCommandLine::normalize_path(string strpath) {
     return fs::path(strpath).make_preferred();
 }
 
-ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::variables_map& vm) {
+vector<Solver> VegaCommandLine::readOutputSolvers(const po::variables_map& vm) {
+    vector<Solver> outputSolvers;
+    vector<string> outputFormats;
+    string outputFormat = vm["output-format"].as<string>();
+    boost::split(outputFormats, outputFormat, boost::is_any_of(","));
+    for (const string& format : outputFormats) {
+        const Solver solver = Solver::fromString(format);
+        for (const Solver& previousSolver : outputSolvers) {
+            if (previousSolver.getSolverName() == solver.getSolverName()) {
+                throw invalid_argument("Output format " + format + " is requested twice.");
+            }
+        }
+        outputSolvers.push_back(solver);
+    }
+    return outputSolvers;
+}
+
+ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::variables_map& vm,
+        const Solver& solver) {
     LogLevel logLevel = LogLevel::INFO;
     if (vm.count("verbosity")){
         string verbosity= vm["verbosity"].as<string>();
@@ -188,13 +303,7 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
     }
 
 
-    // Choice of output solver, and options related to it
-    Solver solver(SolverName::CODE_ASTER);
-    if (vm.count("output-format")) {
-        string outputSolver = vm["output-format"].as<string>();
-        solver = Solver::fromString(outputSolver);
-    }
-
+    // Options related to the output solver
     bool runSolver = false;
     if (vm.count("run-solver")) {
         runSolver = true;
@@ -290,9 +399,33 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
             throw invalid_argument("Systus Size of Matrix must be greater than 1.");
         }
     }
+    string systusSplitMatrix="order";
+    if (vm.count("systus.SplitMatrix")){
+        systusSplitMatrix = vm["systus.SplitMatrix"].as<string>();
+        set<string> availableSplitting { "order", "coupling" };
+        if (availableSplitting.find(systusSplitMatrix) == availableSplitting.end()) {
+            throw invalid_argument("Systus split matrix must be either 'order' (default) or 'coupling'");
+        }
+    }
 
 
 
+    string nastranOutputFormat = "short";
+    if (vm.count("nastran.format")) {
+        nastranOutputFormat = vm["nastran.format"].as<string>();
+        // Checked before parsing, by the writer which knows the formats
+        nastran::CardStream::formatByName(nastranOutputFormat);
+    }
+
+    size_t asterMaxInlineListSize = 1000;
+    if (vm.count("aster.MaxInlineList")) {
+        const int maxInlineList = vm["aster.MaxInlineList"].as<int>();
+        if (maxInlineList < 0) {
+            throw invalid_argument("Aster maximum size of inline lists must be positive.");
+        }
+        asterMaxInlineListSize = static_cast<size_t>(maxInlineList);
+    }
+
     // Default value is "auto", characterized by a void systusSubcases
     vector< vector<int> > systusSubcases;
     if (vm.count("systus.Subcase")){
@@ -342,7 +475,14 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
         cout << "\t Systus Output product: " << systusOutputProduct << endl;
         cout << "\t Systus Output Matrix: " << systusOutputMatrix << endl;
         cout << "\t Systus Size Matrix: " << systusSizeMatrix << endl;
+        cout << "\t Systus Split Matrix: " << systusSplitMatrix << endl;
         cout << "\t Systus Version: " << solverVersion << endl;
+        cout << "\t Nastran format: " << nastranOutputFormat << endl;
+        cout << "\t Aster maximum size of inline lists: " << asterMaxInlineListSize << endl;
+        cout << "\t Incremental output: " << (vm.count("incremental") > 0 ? "yes" : "no") << endl;
+        cout << "\t Link input files: " << (vm.count("link-input") > 0 ? "yes" : "no") << endl;
+        cout << "\t Pre-scan input: " << (vm.count("prescan") > 0 ? "yes" : "no") << endl;
+        cout << "\t Mesh only: " << (vm.count("mesh-only") > 0 ? "yes" : "no") << endl;
         for (size_t i = 0; i < systusSubcases.size(); ++i) {
            cout <<"\t Systus Subcase "<<(i+1)<<": ";
            for (size_t j = 0; j < systusSubcases[i].size(); ++j)
@@ -355,7 +495,10 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
             solverVersion, modelName, outputDir, logLevel, translationMode, testFnamePath,
             tolerance, runSolver, solverServer, solverCommand,
             systusRBE2TranslationMode, systusRBE2Rigidity, systusRBELagrangian, systusOptionAnalysis, systusOutputProduct,
-            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod);
+            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod, systusSplitMatrix,
+            vm.count("profile") > 0, nastranOutputFormat, vm.count("incremental") > 0,
+            vm.count("link-input") > 0, asterMaxInlineListSize, vm.count("prescan") > 0,
+            vm.count("mesh-only") > 0);
     return configuration;
 }
 
@@ -374,7 +517,7 @@ VegaCommandLine::ExitCode VegaCommandLine::runSolver(const ConfigurationParamete
 }
 
 void VegaCommandLine::printHelp(const po::options_description& visible) {
-    cout << endl << "vegapp [options] inputFile input-format output-format" << endl;
+    cout << endl << "vegapp [options] inputFile input-format output-format[,output-format...]" << endl;
     cout << visible << endl;
 }
 
@@ -442,6 +585,14 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
                 " otherwise it is translated only the mesh.") //
         ("strict,s", "Stops translation at the first "
                 "unrecognized keyword or parameter.")//
+        ("profile", "Print the time spent in each step of the model preparation.") //
+        ("incremental", "Do not write again the output files whose data did not change since "
+                "the previous translation in the output directory (the MED mesh of Code_Aster, the subcase ASC files of Systus).") //
+        ("link-input", "Hard link the input files into the output directory instead of copying them. "
+                "Editing the input or its link then changes both.") //
+        ("prescan", "Scan the input once before parsing it, to reserve the storage of large meshes.") //
+        ("mesh-only", "Translate only the mesh: the cards not needed by the mesh are skipped without being read. "
+                "For Code_Aster, the mesh is written to the MED file while it is read, when the input allows it.") //
         ("verbosity", po::value<string>(), "Verbosity of VEGA. From low to high: ERROR, WARN, INFO, DEBUG, TRACE"); //
 
         // Systus specific options
@@ -465,7 +616,24 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         ("systus.OutputMatrix",po::value<string>()->default_value("table"),
                 "Output of Matrix Elements (e.g Super Elements) to 'table' (default) or 'file'") //
         ("systus.SizeMatrix", po::value<int>(),
-                "Maximum size of Systus Matrix Elements: default 9 for table, 20 for file."); //
+                "Maximum size of Systus Matrix Elements: default 9 for table, 20 for file.") //
+        ("systus.SplitMatrix", po::value<string>()->default_value("order"),
+                "Splitting of oversized Matrix Elements: by node 'order' (default) or by node 'coupling', "
+                "which leaves fewer terms between the split matrices."); //
+
+        // Nastran specific options
+        po::options_description nastranOptions("Nastran specific options");
+        nastranOptions.add_options() //
+        ("nastran.format", po::value<string>()->default_value("short"),
+                "Fields of the bulk cards written by the Nastran writer: 'short' (default, 8 columns), "
+                "'large' (16 columns) or 'free' (comma separated)."); //
+
+        // Code_Aster specific options
+        po::options_description asterOptions("Code_Aster specific options");
+        asterOptions.add_options() //
+        ("aster.MaxInlineList", po::value<int>()->default_value(1000),
+                "Node and cell lists of the command file longer than this are written as groups "
+                "of the mesh (default 1000)."); //
 
 
         // Hidden options, will be allowed both on command line and
@@ -476,13 +644,15 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         ("input-format", po::value<string>()->default_value("NASTRAN"),
                 "input format. Allowed formats are NASTRAN, ")("output-format",
                 po::value<string>()->default_value("ASTER"),
-                "output format. Allowed formats are ASTER, SYSTUS");
+                "output format. Allowed formats are ASTER, SYSTUS, NASTRAN, or a comma separated list of them "
+                "to parse the input once and write each of them, at the same time, in a sub directory "
+                "of the output directory.");
 
         po::options_description cmdline_options;
-        cmdline_options.add(commandLine).add(generic).add(systusOptions).add(hidden);
+        cmdline_options.add(commandLine).add(generic).add(systusOptions).add(nastranOptions).add(asterOptions).add(hidden);
 
         po::options_description config_file_options;
-        config_file_options.add(generic).add(systusOptions).add(hidden);
+        config_file_options.add(generic).add(systusOptions).add(nastranOptions).add(asterOptions).add(hidden);
 
         po::positional_options_description p;
         p.add("input-file", 1);
@@ -490,7 +660,7 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         p.add("output-format", 1);
 
         po::options_description visible("Options");
-        visible.add(commandLine).add(generic).add(systusOptions);
+        visible.add(commandLine).add(generic).add(systusOptions).add(nastranOptions).add(asterOptions);
 
         po::variables_map vm;
         store(po::command_line_parser(ac, av).options(cmdline_options).positional(p).run(), vm);
@@ -535,7 +705,21 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         }
 
 
-        const ConfigurationParameters configuration = readCommandLineParameters(vm);
+        vector<ConfigurationParameters> configurations;
+        const vector<Solver> outputSolvers = readOutputSolvers(vm);
+        for (const Solver& outputSolver : outputSolvers) {
+            ConfigurationParameters outputConfiguration = readCommandLineParameters(vm, outputSolver);
+            if (outputSolvers.size() > 1) {
+                // Writers may use the same file names (e.g. the Aster copy of the input file):
+                // every output solver gets its own sub directory.
+                ostringstream solverName;
+                solverName << outputSolver;
+                outputConfiguration.outputPath = (fs::path(outputConfiguration.outputPath)
+                        / boost::to_lower_copy(solverName.str())).string();
+            }
+            configurations.push_back(outputConfiguration);
+        }
+        const ConfigurationParameters& configuration = configurations.front();
         logLevel = configuration.logLevel;
         if (configuration.resultFile.string().size() >= 1) {
             if (!fs::exists(configuration.resultFile)) {
@@ -548,12 +732,14 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
             return ExitCode::NO_INPUT_FILE;
         }
 
-        if (!fs::exists(configuration.outputPath)) {
-            bool create = fs::create_directories(configuration.outputPath);
-            if (!create) {
-                cerr << "Output Directory " + configuration.outputPath + " can't be created."
-                        << endl;
-                return ExitCode::OUTPUT_DIR_NOT_CREATED;
+        for (const auto& outputConfiguration : configurations) {
+            if (!fs::exists(outputConfiguration.outputPath)) {
+                bool create = fs::create_directories(outputConfiguration.outputPath);
+                if (!create) {
+                    cerr << "Output Directory " + outputConfiguration.outputPath + " can't be created."
+                            << endl;
+                    return ExitCode::OUTPUT_DIR_NOT_CREATED;
+                }
             }
         }
 
@@ -562,10 +748,14 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
             string inputSolverString = vm["input-format"].as<string>();
             inputFormat = Solver::fromString(inputSolverString);
         }
-        string modelFile;
-        result = convertStudy(configuration, modelFile, inputFormat);
-        if (result == ExitCode::OK && configuration.runSolver) {
-            result = runSolver(configuration, modelFile);
+        if (configurations.size() > 1) {
+            result = convertStudies(configurations, inputFormat);
+        } else {
+            string modelFile;
+            result = convertStudy(configuration, modelFile, inputFormat);
+            if (result == ExitCode::OK && configuration.runSolver) {
+                result = runSolver(configuration, modelFile);
+            }
         }
     } catch (invalid_argument &e) {
         if (logLevel >= LogLevel::DEBUG) {
@@ -51,9 +51,24 @@ public:
 private:
     static std::unordered_map<ExitCode, std::string, EnumClassHash> failureReason_by_ExitCode;
 
-    ConfigurationParameters readCommandLineParameters(const po::variables_map& vm);
+    ConfigurationParameters readCommandLineParameters(const po::variables_map& vm, const Solver& outputSolver);
+    /**
+     * Output solvers of the comma separated output-format option.
+     */
+    static std::vector<Solver> readOutputSolvers(const po::variables_map& vm);
     ExitCode convertStudy(const ConfigurationParameters& configuration, std::string& modelFileOut,
             const Solver& inputSolver);
+    /**
+     * Parse the input once, then finish and write the model for every configuration
+     * (one by output solver) at the same time, each in a forked copy of the process.
+     */
+    ExitCode convertStudies(const std::vector<ConfigurationParameters>& configurations,
+            const Solver& inputSolver);
+    /**
+     * Finish, validate and write a parsed model.
+     */
+    ExitCode writeStudy(const ConfigurationParameters& configuration, std::shared_ptr<Model> model,
+            std::string& modelFileOut);
     ExitCode runSolver(const ConfigurationParameters& configuration, std::string modelFile);
     static void printHelp(const po::options_description& visible);
     static void printHeader();
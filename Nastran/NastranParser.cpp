@@ -350,41 +350,215 @@ NastranParser::parseElementFPtr NastranParser::findCmdParser(string keyword) con
     }
 }
 
+const unordered_map<string, CellType::Code> NastranParser::CELLTYPE_CODE_BY_ELEMENT_KEYWORD =
+        {
+                { "CBAR", CellType::Code::SEG2_CODE },
+                { "CBEAM", CellType::Code::SEG2_CODE },
+                { "CBUSH", CellType::Code::SEG2_CODE },
+                { "CDAMP1", CellType::Code::SEG2_CODE },
+                { "CELAS1", CellType::Code::SEG2_CODE },
+                { "CELAS2", CellType::Code::SEG2_CODE },
+                { "CELAS4", CellType::Code::SEG2_CODE },
+                { "CGAP", CellType::Code::SEG2_CODE },
+                { "CHEXA", CellType::Code::HEXA8_CODE },
+                { "CMASS2", CellType::Code::SEG2_CODE },
+                { "CPENTA", CellType::Code::PENTA6_CODE },
+                { "CPYRAM", CellType::Code::PYRA5_CODE },
+                { "CQUAD", CellType::Code::QUAD4_CODE },
+                { "CQUAD4", CellType::Code::QUAD4_CODE },
+                { "CQUAD8", CellType::Code::QUAD8_CODE },
+                { "CQUADR", CellType::Code::QUAD4_CODE },
+                { "CROD", CellType::Code::SEG2_CODE },
+                { "CTETRA", CellType::Code::TETRA4_CODE },
+                { "CTRIA3", CellType::Code::TRI3_CODE },
+                { "CTRIA6", CellType::Code::TRI6_CODE },
+                { "CTRIAR", CellType::Code::TRI3_CODE }
+        };
+
+void NastranParser::prescanBULKSection(const fs::path& filePath, BulkStatistics& statistics, bool inBulk) const {
+    ifstream istream(filePath.string());
+    string line;
+    string keyword;
+    while (getline(istream, line)) {
+        if (line.empty() || line[0] == '$') {
+            continue;
+        }
+        if (!inBulk) {
+            string upperLine = alg::to_upper_copy(line);
+            inBulk = upperLine.find("BEGIN") != string::npos && upperLine.find("BULK") != string::npos;
+            continue;
+        }
+        // Same field rules as the tokenizer: tabulations stand for the spaces up to the next field
+        const NastranTokenizer::LineType lineType = NastranTokenizer::getLineType(line);
+        if (lineType != NastranTokenizer::LineType::FREE_FORMAT) {
+            NastranTokenizer::replaceTabs(line, lineType == NastranTokenizer::LineType::LONG_FORMAT);
+        }
+        const bool isContinuation = line[0] == '+' || line[0] == '*' || line[0] == ','
+                || trim_copy(line.substr(0, 8)).empty();
+        if (isContinuation) {
+            if ((keyword == "SPC1" || keyword == "SET1" || keyword == "SET3")
+                    && alg::to_upper_copy(line).find("THRU") != string::npos) {
+                statistics.thruCount++;
+            }
+            continue;
+        }
+        vector<string> fields;
+        if (lineType == NastranTokenizer::LineType::FREE_FORMAT) {
+            alg::split(fields, line, alg::is_any_of(","));
+        } else {
+            fields.push_back(line.substr(0, 8));
+            if (line.size() > 8) {
+                fields.push_back(line.substr(8, lineType == NastranTokenizer::LineType::LONG_FORMAT ? 16 : 8));
+            }
+        }
+        keyword = alg::to_upper_copy(trim_copy(fields[0]));
+        if (!keyword.empty() && keyword.back() == '*') {
+            keyword.pop_back();
+        }
+        if (keyword == "ENDDATA") {
+            break;
+        }
+        if (!keyword.empty()) {
+            statistics.keywords.insert(alg::starts_with(keyword, "INCLUDE") ? "INCLUDE" : keyword);
+        }
+        if (alg::starts_with(keyword, "INCLUDE")) {
+            string fileName = trim_copy(line.substr(7));
+            alg::trim_if(fileName, alg::is_any_of("'"));
+            const fs::path includePath = filePath.parent_path() / fileName;
+            if (fs::exists(includePath)) {
+                prescanBULKSection(includePath, statistics, true);
+            }
+            continue;
+        }
+        if ((keyword == "SPC1" || keyword == "SET1" || keyword == "SET3")
+                && alg::to_upper_copy(line).find("THRU") != string::npos) {
+            statistics.thruCount++;
+        }
+        if (fields.size() < 2) {
+            continue;
+        }
+        const auto& cellTypeIt = CELLTYPE_CODE_BY_ELEMENT_KEYWORD.find(keyword);
+        if (keyword != "GRID" && cellTypeIt == CELLTYPE_CODE_BY_ELEMENT_KEYWORD.end()) {
+            continue;
+        }
+        const string idField = trim_copy(fields[1]);
+        char* end = nullptr;
+        const long id = strtol(idField.c_str(), &end, 10);
+        if (idField.empty() || *end != '\0' || id < INT_MIN || id > INT_MAX) {
+            // Invalid ids are reported by the real parsing
+            continue;
+        }
+        if (keyword == "GRID") {
+            statistics.gridCount++;
+            if (statistics.keepGridIds) {
+                statistics.gridIds.push_back(static_cast<int>(id));
+            }
+            statistics.minGridId = min(statistics.minGridId, static_cast<int>(id));
+            statistics.maxGridId = max(statistics.maxGridId, static_cast<int>(id));
+        } else {
+            statistics.elementCount++;
+            statistics.countByElementKeyword[keyword]++;
+            statistics.cellCountByType[cellTypeIt->second]++;
+            statistics.minElementId = min(statistics.minElementId, static_cast<int>(id));
+            statistics.maxElementId = max(statistics.maxElementId, static_cast<int>(id));
+        }
+    }
+    istream.close();
+}
+
 void NastranParser::parseBULKSection(NastranTokenizer &tok, shared_ptr<Model> model) {
 
     while (tok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_KEYWORD) {
-        string keyword = tok.nextString(true,"");
-        tok.setCurrentKeyword(keyword);
-        try{
-            auto parser = findCmdParser(keyword);
-            if (parser != nullptr) {
-                (this->*parser)(tok, model);
+        parseBULKCard(tok, model);
+        tok.nextLine();
+    }
 
-            } else if (IGNORED_KEYWORDS.find(keyword) != IGNORED_KEYWORDS.end()) {
-                if (model->configuration.logLevel >= LogLevel::TRACE) {
-                    cout << "Keyword " << keyword << " ignored." << endl;
-                }
-                tok.skipToNextKeyword();
+}
 
-            } else if (!keyword.empty()) {
-                handleParsingError(string("Unknown keyword."), tok, model);
-                tok.skipToNextKeyword();
+void NastranParser::parseBULKCard(NastranTokenizer &tok, shared_ptr<Model> model) {
+    string keyword = tok.nextString(true,"");
+    tok.setCurrentKeyword(keyword);
+    try{
+        auto parser = findCmdParser(keyword);
+        if (tok.isCurrentCardDeferred()) {
+            if (meshOnly) {
+                skippedCardCount++;
+            } else {
+                deferredCards.push_back(tok.currentRawCard);
             }
 
-            //Warning if there are unparsed fields. Skip the empty ones
-            if (!tok.isEmptyUntilNextKeyword()) {
-                string message(string("Parsing of line not complete:[") + tok.remainingTextUntilNextKeyword()+"]");
-                handleParsingError(message, tok, model);
+        } else if (parser != nullptr) {
+            (this->*parser)(tok, model);
+
+        } else if (IGNORED_KEYWORDS.find(keyword) != IGNORED_KEYWORDS.end()) {
+            if (model->configuration.logLevel >= LogLevel::TRACE) {
+                cout << "Keyword " << keyword << " ignored." << endl;
             }
+            tok.skipToNextKeyword();
 
-        } catch (std::string&) {
-            // Parsing errors are catched by VegaCommandLine.
-            // If we are not in strict mode, we dismiss this command and continue, hoping for the best.
+        } else if (!keyword.empty()) {
+            // Frequent on industrial decks: collected without unwinding, the card is simply skipped
+            collectParsingError(string("Unknown keyword."), tok, model);
             tok.skipToNextKeyword();
         }
-        tok.nextLine();
+
+        //Warning if there are unparsed fields. Skip the empty ones
+        if (!tok.isEmptyUntilNextKeyword()) {
+            string message(string("Parsing of line not complete:[") + tok.remainingTextUntilNextKeyword()+"]");
+            collectParsingError(message, tok, model);
+            tok.skipToNextKeyword();
+        }
+
+    } catch (std::string&) {
+        // Parsing errors are catched by VegaCommandLine.
+        // If we are not in strict mode, we dismiss this command and continue, hoping for the best.
+        tok.skipToNextKeyword();
     }
+}
 
+void NastranParser::parseDeferredCards(shared_ptr<Model> model) {
+    // One stream per file, whatever the number of cards: they are read in input order, mostly without seeking
+    struct DeferredCardFile {
+        ifstream istream;
+        NastranTokenizer tok;
+        DeferredCardFile(const string& fileName, LogLevel logLevel,
+                ConfigurationParameters::TranslationMode translationMode) :
+                istream(fileName, ios::binary), tok(istream, logLevel, fileName, translationMode) {
+        }
+    };
+    map<string, unique_ptr<DeferredCardFile>> deferredCardFileByName;
+    int parsedCount = 0;
+    int skippedCount = 0;
+    set<string> ignoredMatrixNames;
+    for (const auto& rawCard : deferredCards) {
+        if (rawCard.keyword == "DMIG" && directMatrixByName.find(rawCard.name) == directMatrixByName.end()
+                && rawCard.name != "UACCEL" && rawCard.name != "CDSHUT") {
+            // If the matrix doesn't exist, it means it's not used by the model.
+            // It's often the case on industrial cases, when various matrices are written in the same file, but only one is used.
+            if (ignoredMatrixNames.insert(rawCard.name).second) {
+                cerr << ParsingMessageWarning("Matrix " + rawCard.name + " is not used by the model and ignored.",
+                        rawCard.fileName, rawCard.lineNumber + 1, rawCard.keyword) << endl;
+            }
+            skippedCount++;
+            continue;
+        }
+        unique_ptr<DeferredCardFile>& deferredCardFile = deferredCardFileByName[rawCard.fileName];
+        if (deferredCardFile == nullptr) {
+            deferredCardFile.reset(new DeferredCardFile(rawCard.fileName, this->logLevel, this->translationMode));
+            deferredCardFile->tok.setDiagnostics(&diagnostics);
+            deferredCardFile->tok.bulkSection();
+        }
+        NastranTokenizer& tok = deferredCardFile->tok;
+        tok.readCardAt(rawCard.begin, rawCard.lineNumber);
+        if (tok.nextSymbolType == NastranTokenizer::SymbolType::SYMBOL_KEYWORD) {
+            parseBULKCard(tok, model);
+        }
+        parsedCount++;
+    }
+    if (model->configuration.logLevel >= LogLevel::DEBUG && !deferredCards.empty()) {
+        cout << "Deferred cards: " << parsedCount << " parsed, " << skippedCount << " never decoded." << endl;
+    }
+    deferredCards.clear();
 }
 
 fs::path NastranParser::findModelFile(const string& filename) {
@@ -398,6 +572,9 @@ fs::path NastranParser::findModelFile(const string& filename) {
 shared_ptr<Model> NastranParser::parse(const ConfigurationParameters& configuration) {
     this->translationMode = configuration.translationMode;
     this->logLevel = configuration.logLevel;
+    this->meshOnly = configuration.meshOnly;
+    this->skippedCardCount = 0;
+    this->diagnostics.clear();
 
     const string filename = configuration.inputFile;
 
@@ -409,19 +586,53 @@ shared_ptr<Model> NastranParser::parse(const ConfigurationParameters& configurat
     const string inputFilePathStr = inputFilePath.string();
     ifstream istream(inputFilePathStr);
     NastranTokenizer tok = NastranTokenizer(istream, logLevel, inputFilePath.string(), this->translationMode);
+    tok.setDiagnostics(&diagnostics);
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing Executive section." << endl;
     }
     parseExecutiveSection(tok, model, executive_section_context);
 
+    if (configuration.prescan && meshStream == nullptr) {
+        BulkStatistics statistics;
+        prescanBULKSection(inputFilePath, statistics, false);
+        if (model->configuration.logLevel >= LogLevel::DEBUG) {
+            cout << "BULK pre-scan: " << statistics.gridCount << " GRID (ids " << statistics.minGridId
+                    << " to " << statistics.maxGridId << "), " << statistics.elementCount << " elements (ids "
+                    << statistics.minElementId << " to " << statistics.maxElementId << "), "
+                    << statistics.thruCount << " THRU ranges in SPC1/SET." << endl;
+            for (const auto& countByKeyword : statistics.countByElementKeyword) {
+                cout << "    " << countByKeyword.first << ": " << countByKeyword.second << endl;
+            }
+        }
+        model->mesh->reserveNodes(statistics.gridCount, statistics.minGridId, statistics.maxGridId);
+        model->mesh->reserveCells(statistics.cellCountByType, statistics.minElementId, statistics.maxElementId);
+    }
+
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing BULK section." << endl;
     }
+    deferredKeywords = { "DMIG" };
+    if (meshOnly) {
+        model->onlyMesh = true;
+        for (const auto& parserByKeyword : PARSE_FUNCTION_BY_KEYWORD) {
+            if (GEOMETRY_KEYWORDS.find(parserByKeyword.first) == GEOMETRY_KEYWORDS.end()) {
+                deferredKeywords.insert(parserByKeyword.first);
+            }
+        }
+    }
+    tok.setDeferredKeywords(deferredKeywords);
     tok.bulkSection();
     parseBULKSection(tok, model);
     istream.close();
+    parseDeferredCards(model);
+    if (meshOnly && model->configuration.logLevel >= LogLevel::INFO) {
+        cout << "Mesh only translation: " << skippedCardCount << " cards not needed by the mesh skipped." << endl;
+    }
 
+    if (!diagnostics.empty() && model->configuration.logLevel >= LogLevel::INFO) {
+        diagnostics.printSummary(cout);
+    }
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing finished." << endl;
     }
@@ -429,6 +640,40 @@ shared_ptr<Model> NastranParser::parse(const ConfigurationParameters& configurat
     return model;
 }
 
+bool NastranParser::streamMesh(const ConfigurationParameters& configuration, const string& medFileName) {
+    if (!configuration.meshOnly) {
+        return false;
+    }
+    const fs::path inputFilePath = findModelFile(configuration.inputFile);
+    BulkStatistics statistics;
+    statistics.keepGridIds = true;
+    prescanBULKSection(inputFilePath, statistics, false);
+    for (const string& keyword : statistics.keywords) {
+        if (GEOMETRY_KEYWORDS.find(keyword) != GEOMETRY_KEYWORDS.end()
+                && STREAMED_KEYWORDS.find(keyword) == STREAMED_KEYWORDS.end()) {
+            if (configuration.logLevel >= LogLevel::INFO) {
+                cout << "Mesh not streamed: " << keyword << " cards need the whole mesh." << endl;
+            }
+            return false;
+        }
+    }
+    if (configuration.logLevel >= LogLevel::INFO) {
+        cout << "Streaming the mesh to " << medFileName << endl;
+    }
+    meshStream = unique_ptr<MeshStream>(new MeshStream(medFileName, inputFilePath.filename().string(),
+            statistics.gridIds, configuration.logLevel));
+    vector<int>().swap(statistics.gridIds);
+    try {
+        shared_ptr<Model> model = parse(configuration);
+        meshStream->close(*model->mesh);
+    } catch (...) {
+        meshStream = nullptr;
+        throw;
+    }
+    meshStream = nullptr;
+    return true;
+}
+
 string NastranParser::defaultAnalysis() const {
     return ""; // instead of "101": see github #15
 }
@@ -737,19 +982,22 @@ void NastranParser::parseBCBODY(NastranTokenizer& tok, shared_ptr<Model> model)
 
 void NastranParser::parseBCGRID(NastranTokenizer& tok, shared_ptr<Model> model) {
     int id = tok.nextInt();
-    BoundaryNodeCloud nodecloud(*model, tok.nextInts(), id);
+    const IntervalList& nodeIds = tok.nextInts();
+    BoundaryNodeCloud nodecloud(*model, list<int>(nodeIds.begin(), nodeIds.end()), id);
     model->add(nodecloud);
 }
 
 void NastranParser::parseBLSEG(NastranTokenizer& tok, shared_ptr<Model> model) {
     int id = tok.nextInt();
-    BoundaryNodeLine nodeline(*model, tok.nextInts(), id);
+    const IntervalList& nodeIds = tok.nextInts();
+    BoundaryNodeLine nodeline(*model, list<int>(nodeIds.begin(), nodeIds.end()), id);
     model->add(nodeline);
 }
 
 void NastranParser::parseBSSEG(NastranTokenizer& tok, shared_ptr<Model> model) {
     int id = tok.nextInt();
-    BoundaryNodeSurface surface{*model, tok.nextInts(), id};
+    const IntervalList& nodeIds = tok.nextInts();
+    BoundaryNodeSurface surface{*model, list<int>(nodeIds.begin(), nodeIds.end()), id};
     model->add(surface);
 }
 
@@ -757,8 +1005,7 @@ void NastranParser::parseBSURF(NastranTokenizer& tok, shared_ptr<Model> model) {
     int id = tok.nextInt();
     string gname = string("BSURF_") + to_string(id);
     auto gsurf = model->mesh->createCellGroup(gname, CellGroup::NO_ORIGINAL_ID, "BSURF");
-    const auto& cellids = tok.nextInts();
-    gsurf->cellIds.insert(cellids.begin(), cellids.end());
+    gsurf->addCellIds(tok.nextInts());
     BoundarySurface surface{*model, id};
     surface.add(*gsurf);
     model->add(surface);
@@ -1088,14 +1335,16 @@ void NastranParser::parseDMIG(NastranTokenizer& tok, shared_ptr<Model> model) {
     int cj = tok.nextInt();
     DOF dofj = *(DOFS::nastranCodeToDOFS(cj).begin());
     tok.skip(1);
+    vector<tuple<int, DOF, double>> components;
     while (tok.isNextInt()) {
         int g1 = tok.nextInt();
         int c1 = tok.nextInt();
         DOF dof1 = *(DOFS::nastranCodeToDOFS(c1).begin());
         double a1 = tok.nextDouble();
         tok.nextDouble(true, 0.0);
-        matrix->addComponent(gj, dofj, g1, dof1, a1);
+        components.push_back(make_tuple(g1, dof1, a1));
     }
+    matrix->addComponents(gj, dofj, components);
 }
 
 void NastranParser::parseDPHASE(NastranTokenizer& tok, shared_ptr<Model> model) {
@@ -1350,6 +1599,8 @@ void NastranParser::parseInclude(NastranTokenizer& tok, shared_ptr<Model> model)
     if (fs::exists(includePath)) {
         ifstream istream(includePathStr);
         NastranTokenizer tok2 = NastranTokenizer(istream, this->logLevel, includePathStr, this->translationMode);
+        tok2.setDeferredKeywords(deferredKeywords);
+        tok2.setDiagnostics(&diagnostics);
         tok2.bulkSection();
         tok2.nextLine();
         parseBULKSection(tok2, model);
@@ -2697,14 +2948,10 @@ void NastranParser::parseSET3(NastranTokenizer& tok, shared_ptr<Model> model) {
 
     if (des == "GRID") {
         shared_ptr<NodeGroup> nodeGroup = model->mesh->findOrCreateNodeGroup(name,NodeGroup::NO_ORIGINAL_ID,"SET");
-        while (tok.isNextInt()) {
-            nodeGroup->addNodeId(tok.nextInt());
-        }
+        nodeGroup->addNodeIds(tok.nextInts());
     } else if (des == "ELEM") {
         shared_ptr<CellGroup> cellGroup = model->mesh->createCellGroup(name,CellGroup::NO_ORIGINAL_ID,"SET");
-        while (tok.isNextInt()) {
-            cellGroup->addCellId(tok.nextInt());
-        }
+        cellGroup->addCellIds(tok.nextInts());
     } else {
         throw logic_error("Unsupported DES value in SET3");
     }
@@ -2767,10 +3014,10 @@ void NastranParser::parseSPC1(NastranTokenizer& tok, shared_ptr<Model> model) {
     shared_ptr<NodeGroup> spcNodeGroup = model->mesh->findOrCreateNodeGroup(name,NodeGroup::NO_ORIGINAL_ID,"SPC1");
 
     // Parsing Nodes
-    for(int gridId : tok.nextInts()) {
-        spcNodeGroup->addNodeId(gridId);
-        spc.addNodeId(gridId);
-    }
+    const IntervalList& gridIds = tok.nextInts();
+    spcNodeGroup->addNodeIds(gridIds);
+    // The group has reserved the nodes: the constraint keeps the intervals as they are
+    spc.addNodeIds(gridIds);
 
     // Adding the constraint to the model
     model->add(spc);
@@ -26,6 +26,7 @@
 
 #include <boost/filesystem.hpp>
 #include "../Abstract/Model.h"
+#include "../Abstract/MeshStream.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "NastranTokenizer.h"
 
@@ -64,7 +65,34 @@ private:
             Analysis::NO_ORIGINAL_ID);
 
     fs::path findModelFile(const std::string& filename);
+
+    /**
+     * Cell type expected for each element keyword, used only for pre-allocation (higher
+     * order variants are counted as their linear counterpart).
+     */
+    static const std::unordered_map<std::string, CellType::Code> CELLTYPE_CODE_BY_ELEMENT_KEYWORD;
     void parseBULKSection(NastranTokenizer &tok, std::shared_ptr<Model> model1);
+    /**
+     * Parse the card the tokenizer is on, without reading the next one.
+     */
+    void parseBULKCard(NastranTokenizer &tok, std::shared_ptr<Model> model);
+
+    /**
+     * Keywords of the cards which are only located during the BULK parsing, and parsed
+     * at its end if needed (see NastranTokenizer::setDeferredKeywords). With a mesh only
+     * translation, they are the cards not needed by the mesh, which are simply skipped.
+     */
+    std::set<std::string> deferredKeywords;
+    std::vector<NastranTokenizer::RawCard> deferredCards;
+    bool meshOnly = false;
+    int skippedCardCount = 0;
+    std::unique_ptr<MeshStream> meshStream; /**< Where the mesh goes, instead of the Model, in streamMesh() **/
+    /**
+     * Parse the cards kept raw during the BULK section, in their input order, reading each
+     * file through a single stream. DMIG cards are parsed only if their matrix is used by the
+     * case control.
+     */
+    void parseDeferredCards(std::shared_ptr<Model> model);
 
     void parseExecutiveSection(NastranTokenizer& tok, std::shared_ptr<Model> model, std::map<std::string, std::string>& context);
     /**Renumbers the nodes
@@ -754,6 +782,11 @@ private:
      *  The name of the group is then "COMMAND_property_id".
      */
     std::shared_ptr<CellGroup> getOrCreateCellGroup(int property_id, std::shared_ptr<Model> model, const std::string & command="CGVEGA");//in NastranParser_geometry.cpp
+    /**
+     * Add the Cell to the mesh and to the CellGroup of the property_id, or to the meshStream if set.
+     */
+    void addCellWithProperty(int cell_id, int property_id, const CellType& cellType, const std::vector<int>& nodeIds,
+            NastranTokenizer& tok, std::shared_ptr<Model> model);//in NastranParser_geometry.cpp
 
     /**
      * Parse and build an Orientation referentiel.
@@ -787,6 +820,24 @@ private:
         "TOPVAR", //  Topological Design Variable
     };
 
+    // Keywords of the cards which can be written to a MeshStream, see streamMesh()
+    std::set<std::string> STREAMED_KEYWORDS = {
+        "CHEXA", "CORD2C", "CORD2R", "CPENTA", "CPYRAM", "CQUAD", "CQUAD4", "CQUAD8", "CQUADR",
+        "CROD", "CTETRA", "CTRIA3", "CTRIA6", "CTRIAR",
+        "GRDSET", "GRID",
+        "INCLUDE",
+    };
+
+    // Keywords needed to build the mesh. With a mesh only translation, the other cards are skipped.
+    std::set<std::string> GEOMETRY_KEYWORDS = {
+        "CBAR", "CBEAM", "CBUSH", "CDAMP1", "CELAS1", "CELAS2", "CELAS4", "CGAP", "CHEXA",
+        "CMASS2", "CONM2", "CORD1R", "CORD2C", "CORD2R", "CPENTA", "CPYRAM", "CQUAD", "CQUAD4",
+        "CQUAD8", "CQUADR", "CROD", "CTETRA", "CTRIA3", "CTRIA6", "CTRIAR",
+        "GRDSET", "GRID",
+        "INCLUDE",
+        "SPOINT",
+    };
+
     // See chapter 5 of the Nastran Quick Reference guide
     // Please keep alphabetical order for a better readibility
     std::set<std::string> IGNORED_PARAMS = {
@@ -800,9 +851,34 @@ private:
         "TINY"     // Printout command
     };
 public:
+    /**
+     * Counters gathered by a quick first pass over the BULK section, used to pre-allocate
+     * the mesh storage before the actual parsing (see ConfigurationParameters::prescan).
+     */
+    class BulkStatistics {
+    public:
+        int gridCount = 0;
+        int minGridId = INT_MAX;
+        int maxGridId = INT_MIN;
+        int elementCount = 0;
+        int minElementId = INT_MAX;
+        int maxElementId = INT_MIN;
+        int thruCount = 0; /**< Number of THRU ranges found in SPC1 and SETx cards **/
+        std::map<std::string, int> countByElementKeyword;
+        std::map<CellType::Code, int> cellCountByType;
+        std::set<std::string> keywords; /**< Keywords of all the cards found **/
+        bool keepGridIds = false; /**< If true, gridIds is filled **/
+        std::vector<int> gridIds; /**< Ids of the GRID cards, in input order **/
+    };
+    /**
+     * Scan the BULK section (following INCLUDEs) reading only the keyword and the first id field
+     * of each card. If inBulk is false, lines are skipped until BEGIN BULK.
+     */
+    void prescanBULKSection(const fs::path& filePath, BulkStatistics& statistics, bool inBulk) const;
     NastranParser();
     virtual ~NastranParser();
     std::shared_ptr<Model> parse(const ConfigurationParameters& configuration) override;
+    bool streamMesh(const ConfigurationParameters& configuration, const std::string& medFileName) override;
 };
 
 }
@@ -83,7 +83,9 @@ void NastranParser::parseGRID(NastranTokenizer& tok, shared_ptr<Model> model) {
     string scp;
     if (cp != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
         cpos = model->mesh->findOrReserveCoordinateSystem(cp);
-        scp=" in CS"+to_string(cp)+"_"+to_string(cpos);
+        if (this->logLevel >= LogLevel::TRACE) {
+            scp=" in CS"+to_string(cp)+"_"+to_string(cpos);
+        }
     }
 
     double x1 = tok.nextDouble(true, 0.0);
@@ -96,9 +98,19 @@ void NastranParser::parseGRID(NastranTokenizer& tok, shared_ptr<Model> model) {
     string scd="";
     if (cd != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
         cdos = model->mesh->findOrReserveCoordinateSystem(cd);
-        scd=", DISP in CS"+to_string(cd)+"_"+to_string(cdos);
+        if (this->logLevel >= LogLevel::TRACE) {
+            scd=", DISP in CS"+to_string(cd)+"_"+to_string(cdos);
+        }
+    }
+    if (meshStream == nullptr) {
+        model->mesh->addNode(id, x1, x2, x3, cpos, cdos);
+    } else {
+        try {
+            meshStream->addNode(id, x1, x2, x3, cpos);
+        } catch (invalid_argument& e) {
+            handleParsingError(e.what(), tok, model);
+        }
     }
-    model->mesh->addNode(id, x1, x2, x3, cpos, cdos);
 
     int ps = tok.nextInt(true, grdSet.ps);
     if (ps) {
@@ -119,17 +131,31 @@ void NastranParser::addProperty(int property_id, int cell_id, shared_ptr<Model>
     cellGroup->addCellId(cell_id);
 }
 
+void NastranParser::addCellWithProperty(int cell_id, int property_id, const CellType& cellType,
+        const vector<int>& nodeIds, NastranTokenizer& tok, shared_ptr<Model> model) {
+    if (meshStream == nullptr) {
+        model->mesh->addCell(cell_id, cellType, nodeIds);
+        addProperty(property_id, cell_id, model);
+        return;
+    }
+    try {
+        meshStream->addCell(cellType, nodeIds, getOrCreateCellGroup(property_id, model));
+    } catch (invalid_argument& e) {
+        handleParsingError(e.what(), tok, model);
+    }
+}
+
 shared_ptr<CellGroup> NastranParser::getOrCreateCellGroup(int property_id, shared_ptr<Model> model, const string & command) {
     shared_ptr<CellGroup> cellGroup = dynamic_pointer_cast<CellGroup>(model->mesh->findGroup(property_id));
 
-    string cellGroupName= command + string("_") + lexical_cast<string>(property_id);
+    // The name is only built when needed, not for each element of an existing group
     if (cellGroup == nullptr){
-        cellGroup = model->mesh->createCellGroup(cellGroupName, property_id, command);
+        cellGroup = model->mesh->createCellGroup(command + "_" + to_string(property_id), property_id, command);
     }
     else{
         // If the Group already exists, and if it was not already done, we enforce the name and comment of the Group
-        if ((command != "CGVEGA") && (cellGroup->getName().substr(0,6)=="CGVEGA")){
-            model->mesh->renameGroup(cellGroup->getName(), cellGroupName, command);
+        if ((command != "CGVEGA") && (cellGroup->getName().compare(0, 6, "CGVEGA") == 0)){
+            model->mesh->renameGroup(cellGroup->getName(), command + "_" + to_string(property_id), command);
         }
     }
     return cellGroup;
@@ -465,8 +491,7 @@ void NastranParser::parseElem(NastranTokenizer& tok, shared_ptr<Model> model,
         for (unsigned int i2 = 0; i2 < cellType.numNodes; i2++)
             medConnect[nastran2medNodeConnect[i2]] = nastranConnect[i2];
     }
-    model->mesh->addCell(cell_id, cellType, medConnect);
-    addProperty(property_id, cell_id, model);
+    addCellWithProperty(cell_id, property_id, cellType, medConnect, tok, model);
 }
 
 void NastranParser::parseCGAP(NastranTokenizer& tok, shared_ptr<Model> model) {
@@ -542,8 +567,7 @@ void NastranParser::parseCROD(NastranTokenizer& tok, shared_ptr<Model> model) {
     CellType cellType = CellType::SEG2;
     vector<int> nodeIds;
     nodeIds += point1, point2;
-    model->mesh->addCell(cell_id, cellType, nodeIds);
-    addProperty(property_id, cell_id, model);
+    addCellWithProperty(cell_id, property_id, cellType, nodeIds, tok, model);
 }
 
 void NastranParser::parseCTETRA(NastranTokenizer& tok, shared_ptr<Model> model) {
@@ -658,8 +682,7 @@ void NastranParser::parseShellElem(NastranTokenizer& tok, shared_ptr<Model> mode
         handleParsingWarning(msg, tok, model);
     }
 
-    model->mesh->addCell(cell_id, cellType, nodeIds);
-    addProperty(property_id, cell_id, model);
+    addCellWithProperty(cell_id, property_id, cellType, nodeIds, tok, model);
 
 }
 
@@ -14,6 +14,7 @@
 #include <boost/lexical_cast.hpp>
 #include <iostream>
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <fstream>
@@ -104,6 +105,8 @@ bool NastranTokenizer::readLineSkipComment(string& line) {
 	bool eof = true;
 	while (getline(this->instrream, line)) {
 		lineNumber += 1;
+		// The newline is not in the line, unless the last line of the file has none
+		readOffset += static_cast<streamoff>(line.size()) + (this->instrream.eof() ? 0 : 1);
 		if (!line.empty() and !all_of(line.begin(), line.end(), [](int c) {return isblank(c);})
 				and line[0] != '$') {
 			boost::iterator_range<string::iterator> middle_dollar = boost::find_first(line, "$");
@@ -272,7 +275,10 @@ void NastranTokenizer::nextLine() {
 //enough in 99% of lines
 	currentLineVector.reserve(128);
 	currentField = 0;
+	currentCardDeferred = false;
 
+	const streamoff cardBegin = readOffset;
+	const int cardLineNumber = this->lineNumber;
 	bool iseof = readLineSkipComment(this->currentLine);
 	if (!iseof) {
 		switch (currentSection) {
@@ -281,6 +287,38 @@ void NastranTokenizer::nextLine() {
 			split(currentLineVector, this->currentLine, boost::is_any_of("\t\\= "), boost::algorithm::token_compress_on);
 			break;
 		case SectionType::SECTION_BULK:
+			if (!deferredKeywords.empty()) {
+				// Only the keyword is read here: the other lines are split once, by parseBulkSectionLine
+				size_t keywordEnd = 0;
+				while (keywordEnd < currentLine.size() && keywordEnd < SFSIZE
+						&& strchr(", \t*", currentLine[keywordEnd]) == nullptr) {
+					keywordEnd++;
+				}
+				const string keyword = boost::to_upper_copy(currentLine.substr(0, keywordEnd));
+				if (deferredKeywords.find(keyword) != deferredKeywords.end()) {
+					vector<string> fields;
+					if (getLineType(currentLine) == LineType::FREE_FORMAT) {
+						split(fields, currentLine, boost::is_any_of(","));
+					} else {
+						string line = currentLine;
+						replaceTabs(line, getLineType(line) == LineType::LONG_FORMAT);
+						fields.push_back(line.substr(0, SFSIZE));
+						if (line.size() > SFSIZE) {
+							fields.push_back(line.substr(SFSIZE,
+									getLineType(line) == LineType::LONG_FORMAT ? LFSIZE : SFSIZE));
+						}
+					}
+					skipRawContinuations(currentLine);
+					currentRawCard.fileName = this->fileName;
+					currentRawCard.begin = cardBegin;
+					currentRawCard.lineNumber = cardLineNumber;
+					currentRawCard.keyword = keyword;
+					currentRawCard.name = fields.size() > 1 ? boost::to_upper_copy(trim_copy(fields[1])) : "";
+					currentLineVector.push_back(keyword);
+					currentCardDeferred = true;
+					break;
+				}
+			}
 			parseBulkSectionLine(this->currentLine);
 			break;
 		default:
@@ -338,7 +376,7 @@ void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, con
 		if (!iseof) {
 			splitFixedFormat(line2, longFormat, false);
 		} else {
-			throw "Continuation Expected: Line N " + to_string(this->lineNumber);
+			handleParsingError("Continuation expected.");
 		}
 	} else {
 		/** Test for automatic continuation : we allow tabulation
@@ -374,7 +412,7 @@ string NastranTokenizer::nextString(bool returnDefaultIfNotFoundOrBlank, string
 
 void NastranTokenizer::skip(int fields) {
 	if (this->nextSymbolType == SymbolType::SYMBOL_EOF) {
-		throw "Attempt to read past the end of file. Line:" + this->lineNumber;
+		handleParsingError("Attempt to read past the end of file.");
 	}
 
 	this->currentField = min(static_cast<unsigned int>(this->currentLineVector.size()),
@@ -421,8 +459,8 @@ int NastranTokenizer::nextInt(bool returnDefaultIfNotFoundOrBlank, int defaultVa
 	return result;
 }
 
-const list<int> NastranTokenizer::nextInts() {
-	list<int> result;
+const IntervalList NastranTokenizer::nextInts() {
+	IntervalList result;
 	while(isNextInt() or isNextTHRU()) {
         if (isNextInt()) {
             result.push_back(nextInt());
@@ -439,10 +477,12 @@ const list<int> NastranTokenizer::nextInts() {
             if (isNextBY()) {
                 skip(1);
                 step = nextInt();
+                if (step <= 0) {
+                    handleParsingError("Invalid BY step " + to_string(step));
+                }
             }
-            for(int i=start+1;i<=endint;i+=step) {
-                result.push_back(i);
-            }
+            // The range is kept as an interval, it is never expanded here
+            result.addRange(start + 1, endint, step);
         }
 	}
 	return result;
@@ -491,6 +531,46 @@ vector<string> NastranTokenizer::currentDataLine() const {
 	return currentLineVector;
 }
 
+void NastranTokenizer::setDeferredKeywords(const set<string>& keywords) {
+	this->deferredKeywords = keywords;
+}
+
+void NastranTokenizer::readCardAt(streamoff offset, int cardLineNumber) {
+	// Consecutive cards are read without seeking, keeping the stream buffer
+	if (offset != readOffset || !this->instrream.good()) {
+		this->instrream.clear();
+		this->instrream.seekg(offset);
+		readOffset = offset;
+	}
+	this->lineNumber = cardLineNumber;
+	nextLine();
+}
+
+void NastranTokenizer::skipRawContinuations(const string& firstLine) {
+	// Same continuation rules as splitFixedFormat and splitFreeFormat
+	string line = firstLine;
+	bool continuation = true;
+	while (continuation) {
+		LineType lineType = getLineType(line);
+		char c = static_cast<char>(this->instrream.peek());
+		if (lineType == LineType::FREE_FORMAT) {
+			vector<string> fields;
+			split(fields, line, boost::is_any_of(","));
+			continuation = c == ',' || c == '+' || c == '*';
+			for (size_t fieldIndex = 1; fieldIndex < fields.size() && !continuation; fieldIndex += 8) {
+				continuation = trim_copy(fields[fieldIndex])[0] == '+';
+			}
+		} else {
+			replaceTabs(line, lineType == LineType::LONG_FORMAT);
+			continuation = c == ' ' || c == '+' || c == '*' || c == '\t'
+					|| (line.size() > 72 && !trim_copy(line.substr(72, SFSIZE)).empty());
+		}
+		if (continuation) {
+			continuation = !readLineSkipComment(line);
+		}
+	}
+}
+
 const string NastranTokenizer::currentRawDataLine() const {
 	return this->currentLine;
 }
@@ -27,6 +27,7 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <set>
 #include <iostream>
 #include <limits>
 #include "../Abstract/ConfigurationParameters.h"
@@ -44,6 +45,8 @@ public:
         SHORT_FORMAT,
         LONG_FORMAT
     };
+    static NastranTokenizer::LineType getLineType(const std::string& line); /**< Determine the LineType of the line.**/
+    static void replaceTabs(std::string &line, bool longFormat); /**< Replace all tabulation by the needed number of space. **/
 private:
     static const int SFSIZE = 8; /**< Short field size **/
     static const int LFSIZE = 16;/**< Long field size **/
@@ -52,12 +55,20 @@ private:
     std::vector<std::string> currentLineVector;
     std::string currentLine;
 
-    NastranTokenizer::LineType getLineType(const std::string& line); /**< Determine the LineType of the line.**/
-    void replaceTabs(std::string &line, bool longFormat); /**< Replace all tabulation by the needed number of space. **/
-
     void splitFixedFormat(std::string& line, bool longFormat, bool firstLine);
 
+    std::set<std::string> deferredKeywords;
+    bool currentCardDeferred = false;
+    /**
+     * Bytes read from the stream so far, counted while reading rather than asked to the stream.
+     */
+    std::streamoff readOffset = 0;
+
     bool readLineSkipComment(std::string& line);
+    /**
+     * Read the continuation lines of a card without splitting them into fields.
+     */
+    void skipRawContinuations(const std::string& firstLine);
     void splitFreeFormat(std::string line, bool firstLine);
     void parseBulkSectionLine(std::string line);
     void parseParameters();
@@ -81,8 +92,21 @@ public:
     };
 
 
+    /**
+     * Location of a card kept unparsed in the input file, see setDeferredKeywords().
+     */
+    class RawCard {
+    public:
+        std::string fileName;
+        std::streamoff begin;
+        int lineNumber; /**< Line number just before the card **/
+        std::string keyword;
+        std::string name; /**< First field after the keyword (e.g. the DMIG matrix name) **/
+    };
+
     SectionType currentSection;
     SymbolType nextSymbolType;
+    RawCard currentRawCard;
 
     NastranTokenizer(std::istream& stream, vega::LogLevel logLevel = vega::LogLevel::INFO,
             const std::string fileName = "UNKNOWN",
@@ -112,7 +136,10 @@ public:
      * @return
      */
     int nextInt(bool returnDefaultIfNotFoundOrBlank = false, int defaultValue = Globals::UNAVAILABLE_INT);
-    const std::list<int> nextInts();
+    /**
+     * Read a list of integers, keeping the THRU and BY ranges as intervals.
+     */
+    const IntervalList nextInts();
     const std::list<double> nextDoubles();
     bool isNextInt();
     bool isNextTHRU();
@@ -169,6 +196,27 @@ public:
      */
     void nextLine();
 
+    /**
+     * In BULK section, cards with these keywords are not split into fields: the tokenizer
+     * only returns their keyword and records their location in currentRawCard, so that
+     * they can be parsed later from the file, or never.
+     */
+    void setDeferredKeywords(const std::set<std::string>& keywords);
+    /**
+     * True if the current card was read as a raw card (see setDeferredKeywords).
+     */
+    bool isCurrentCardDeferred() const {
+        return currentCardDeferred;
+    }
+    /**
+     * Reads the card starting at offset in the stream, a RawCard location, as nextLine() does.
+     * The stream is not moved when the card follows the one read last.
+     */
+    void readCardAt(std::streamoff offset, int cardLineNumber);
+    int getCurrentField() const override {
+        return static_cast<int>(currentField) - 1;
+    }
+
 };
 
 } /* namespace nastran */
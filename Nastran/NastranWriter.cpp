@@ -20,8 +20,6 @@
 
 #include <ciso646>
 #include "NastranWriter.h"
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/format.hpp>
 
 namespace fs = boost::filesystem;
 using namespace std;
@@ -29,63 +27,131 @@ using namespace std;
 namespace vega {
 namespace nastran {
 
-ostream &operator<<(ostream &out, const Line& line) {
-	out << left << setw(8);
-	out << line.keyword;
-	int fieldCount = 0;
-	for(const auto& field : line.fields) {
-		fieldCount++;
-		if (fieldCount % line.fieldNum == 0) {
-			out << endl;
-			out << setw(line.fieldLength) << "";
+CardStream::CardStream(FieldFormat format) :
+		format(format) {
+}
+
+CardStream::CardStream(ostream& out, FieldFormat format) :
+		buffer(out), format(format) {
+}
+
+FieldFormat CardStream::formatByName(const string& name) {
+	if (name == "short") {
+		return FieldFormat::SHORT;
+	} else if (name == "large") {
+		return FieldFormat::LARGE;
+	} else if (name == "free") {
+		return FieldFormat::FREE;
+	}
+	throw invalid_argument("Nastran format must be either short (default), large or free, not " + name);
+}
+
+CardStream& CardStream::card(const string& keyword) {
+	fieldCount = 0;
+	switch (format) {
+	case FieldFormat::SHORT:
+		buffer.leftField(keyword, 8);
+		break;
+	case FieldFormat::LARGE:
+		buffer.leftField(keyword + "*", 8);
+		break;
+	case FieldFormat::FREE:
+		buffer << keyword;
+		break;
+	default:
+		throw logic_error("Unknown Nastran field format");
+	}
+	return *this;
+}
+
+void CardStream::nextField() {
+	// Eight fields on each line, four in large format, then a continuation line
+	const unsigned int fieldNum = format == FieldFormat::LARGE ? 4 : 8;
+	if (fieldCount > 0 && fieldCount % fieldNum == 0) {
+		switch (format) {
+		case FieldFormat::SHORT:
+			buffer << "\n        ";
+			break;
+		case FieldFormat::LARGE:
+			buffer << "\n*       ";
+			break;
+		case FieldFormat::FREE:
+			buffer << '\n';
+			break;
+		default:
+			throw logic_error("Unknown Nastran field format");
 		}
-		out << field;
 	}
-	out << endl;
-	return out;
+	fieldCount++;
+	if (format == FieldFormat::FREE) {
+		buffer << ',';
+	}
 }
 
-Line::Line(string _keyword) : keyword(_keyword) {
-	if (boost::algorithm::ends_with(keyword, "*")) {
-		fieldLength = 16;
-		fieldNum = 4;
+CardStream& CardStream::add() {
+	nextField();
+	if (format != FieldFormat::FREE) {
+		buffer.field(string(), format == FieldFormat::LARGE ? 16 : 8);
+	}
+	return *this;
+}
+
+CardStream& CardStream::add(double value) {
+	nextField();
+	buffer.nastranReal(value, format == FieldFormat::FREE ? 0 : format == FieldFormat::LARGE ? 16 : 8);
+	return *this;
+}
+
+CardStream& CardStream::add(const string& value) {
+	nextField();
+	if (format == FieldFormat::FREE) {
+		buffer << value;
+	} else {
+		buffer.field(value, format == FieldFormat::LARGE ? 16 : 8);
+	}
+	return *this;
+}
+
+CardStream& CardStream::add(int value) {
+	nextField();
+	if (format == FieldFormat::FREE) {
+		buffer << value;
 	} else {
-		fieldLength = 8;
-		fieldNum = 8;
+		buffer.field(value, format == FieldFormat::LARGE ? 16 : 8);
 	}
+	return *this;
+}
+
+ostream &operator<<(ostream &out, const Line& line) {
+	// One write for the whole card
+	const string& card = line.fields.str();
+	out.write(card.data(), static_cast<streamsize>(card.size()));
+	out.put('\n');
+	return out;
+}
+
+Line::Line(string keyword, FieldFormat format) :
+		fields(format) {
+	fields.card(keyword);
 }
 
 Line& Line::add() {
-	this->add(string());
+	fields.add();
 	return *this;
 }
 
 Line& Line::add(double value) {
-	std::ostringstream strs;
-	strs << boost::format("%8.7g") % value;
-	string gnum = strs.str();
-	strs.str("");
-	strs.clear();
-	if (gnum.length() <= fieldLength) {
-		strs << internal << setw(this->fieldLength) << gnum;
-	} else {
-		strs << internal << setw(this->fieldLength) << boost::format("%4.2e") % value;
-	}
-	this->fields.push_back(strs.str());
+	fields.add(value);
 	return *this;
 }
 
 Line& Line::add(string value) {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	fields.add(value);
 	return *this;
 }
 
 Line& Line::add(int value) {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	fields.add(value);
 	return *this;
 }
 
@@ -175,18 +241,21 @@ void NastranWriter::writeSOL(const shared_ptr<vega::Model>& model, ofstream& out
 
 void NastranWriter::writeCells(const shared_ptr<vega::Model>& model, ofstream& out) const
 		{
+	// Cards are written straight from the connectivity of the mesh, without Cell nor Line objects
+	CardStream cards(out, format);
 	for (const auto& elementSet : model->elementSets) {
 		if (elementSet->isDiscrete() || elementSet->isMatrixElement()) {
 			continue;
 		}
-		shared_ptr<CellGroup> cellGroup = elementSet->cellGroup;
-		for (const Cell& cell : cellGroup->getCells()) {
+		const int propertyId = elementSet->bestId();
+		model->mesh->visitCells(elementSet->cellGroup->getCellIds(),
+				[&elementSet, &cards, propertyId](int cellId, const CellType& type, const vector<int>& nodeIds) {
 			string keyword;
 			if (elementSet->isBeam()) {
 				keyword = "CBEAM";
 			} else
 			if (elementSet->isShell()) {
-				switch (cell.type.code) {
+				switch (type.code) {
 				case CellType::Code::TRI3_CODE:
 					keyword = "CTRIA3";
 					break;
@@ -204,7 +273,7 @@ void NastranWriter::writeCells(const shared_ptr<vega::Model>& model, ofstream& o
 				}
 			} else
 			if (elementSet->type == ElementSet::Type::CONTINUUM) {
-				switch (cell.type.code) {
+				switch (type.code) {
 				case CellType::Code::HEXA8_CODE:
                 case CellType::Code::HEXA20_CODE:
 					keyword = "CHEXA";
@@ -218,26 +287,31 @@ void NastranWriter::writeCells(const shared_ptr<vega::Model>& model, ofstream& o
 				}
 			}
 
-			out << Line(keyword).add(cell.id).add(elementSet->bestId()).add(cell.nodeIds);
-		}
+			cards.card(keyword).add(cellId).add(propertyId);
+			for (int nodeId : nodeIds) {
+				cards.add(nodeId);
+			}
+			cards.end();
+		});
 	}
 }
 
 void NastranWriter::writeNodes(const shared_ptr<vega::Model>& model, ofstream& out) const
 		{
-	for (Node node : model->mesh->nodes) {
+	CardStream cards(out, format);
+	for (const Node& node : model->mesh->nodes) {
 	    if (node.positionCS!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
 	        cerr << "Warning in GRID "<<node.id<<" CP not supported and dismissed."<<endl;
         if (node.displacementCS!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
             cerr << "Warning in GRID "<<node.id<<" CD not supported and dismissed."<<endl;
-		out << Line("GRID").add(node.id).add().add(node.lx).add(node.ly).add(node.lz);
+		cards.card("GRID").add(node.id).add().add(node.lx).add(node.ly).add(node.lz).end();
 	}
 }
 
 void NastranWriter::writeMaterials(const shared_ptr<vega::Model>& model, ofstream& out) const
 		{
 	for (const auto& material : model->materials) {
-		Line mat1("MAT1");
+		Line mat1("MAT1", format);
 		mat1.add(material->bestId());
 		const shared_ptr<Nature> enature = material->findNature(Nature::NatureType::NATURE_ELASTIC);
 		if (enature) {
@@ -257,32 +331,26 @@ void NastranWriter::writeMaterials(const shared_ptr<vega::Model>& model, ofstrea
 void NastranWriter::writeConstraints(const shared_ptr<vega::Model>& model, ofstream& out) const
 		{
 	for (const auto& constraintSet : model->constraintSets) {
-		const set<shared_ptr<Constraint> >& spcs = constraintSet->getConstraintsByType(
-				Constraint::Type::SPC);
+		const auto& spcs = constraintSet->getConstraintsByType<Constraint::Type::SPC>();
 		if (spcs.size() > 0) {
-			for (shared_ptr<Constraint> constraint : spcs) {
-				shared_ptr<const SinglePointConstraint> spc = dynamic_pointer_cast<
-						const SinglePointConstraint>(constraint);
-				for (int nodePosition : spc->nodePositions()) {
+			for (const SinglePointConstraint& spc : spcs) {
+				for (int nodePosition : spc.nodePositions()) {
 					const int nodeId = model->mesh->findNodeId(nodePosition);
 					out
-							<< Line("SPC1").add(constraintSet->bestId()).add(
-									spc->getDOFSForNode(nodePosition)).add(nodeId);
+							<< Line("SPC1", format).add(constraintSet->bestId()).add(
+									spc.getDOFSForNode(nodePosition)).add(nodeId);
 				}
 			}
 		}
-		const set<shared_ptr<Constraint> >& rigidConstraints = constraintSet->getConstraintsByType(
-				Constraint::Type::RIGID);
+		const auto& rigidConstraints = constraintSet->getConstraintsByType<Constraint::Type::RIGID>();
 		if (rigidConstraints.size() > 0) {
-			for (shared_ptr<Constraint> constraint : rigidConstraints) {
-				shared_ptr<const RigidConstraint> rigid =
-						dynamic_pointer_cast<const RigidConstraint>(constraint);
-				Line rbe2("RBE2");
+			for (const RigidConstraint& rigid : rigidConstraints) {
+				Line rbe2("RBE2", format);
 				rbe2.add(constraintSet->bestId());
-				const int masterId = model->mesh->findNodeId(rigid->getMaster());
+				const int masterId = model->mesh->findNodeId(rigid.getMaster());
 				rbe2.add(masterId);
 				rbe2.add(DOFS::ALL_DOFS);
-				for (int slavePosition : rigid->getSlaves()) {
+				for (int slavePosition : rigid.getSlaves()) {
 					const int slaveId = model->mesh->findNodeId(slavePosition);
 					rbe2.add(slaveId);
 				}
@@ -295,53 +363,50 @@ void NastranWriter::writeConstraints(const shared_ptr<vega::Model>& model, ofstr
 void NastranWriter::writeLoadings(const shared_ptr<vega::Model>& model, ofstream& out) const
 		{
 	for (const auto& loadingSet : model->loadSets) {
-		const set<shared_ptr<Loading> > gravities = loadingSet->getLoadingsByType(Loading::Type::GRAVITY);
+		const auto& gravities = loadingSet->getLoadingsByType<Loading::Type::GRAVITY>();
 		if (gravities.size() > 0) {
-			for (shared_ptr<Loading> loading : gravities) {
-				shared_ptr<const Gravity> gravity = dynamic_pointer_cast<const Gravity>(loading);
-				Line grav("GRAV");
+			for (const Gravity& gravity : gravities) {
+				Line grav("GRAV", format);
 				grav.add(loadingSet->bestId());
-				if (gravity->hasCoordinateSystem()) {
-					grav.add(gravity->coordinate_system_id);
+				if (gravity.hasCoordinateSystem()) {
+					grav.add(gravity.coordinate_system_id);
 				} else {
 					grav.add(0);
 				}
-				grav.add(gravity->getAcceleration());
-				grav.add(gravity->getDirection());
+				grav.add(gravity.getAcceleration());
+				grav.add(gravity.getDirection());
 				out << grav;
 			}
 		}
 
-		const set<shared_ptr<Loading> > forceSurfaces = loadingSet->getLoadingsByType(
-				Loading::Type::FORCE_SURFACE);
+		const auto& forceSurfaces = loadingSet->getLoadingsByType<Loading::Type::FORCE_SURFACE>();
 		if (forceSurfaces.size() > 0) {
-			for (shared_ptr<Loading> loading : forceSurfaces) {
-				shared_ptr<ForceSurface> forceSurface = dynamic_pointer_cast<ForceSurface>(loading);
-				Line pload4("PLOAD4");
+			for (const ForceSurface& forceSurface : forceSurfaces) {
+				Line pload4("PLOAD4", format);
 				pload4.add(loadingSet->bestId());
-				vector<Cell> cells = forceSurface->getCells();
+				vector<Cell> cells = forceSurface.getCells();
 				if (cells.size() == 1) {
 					pload4.add(cells[0].id);
 				} else {
 					throw logic_error("Unimplemented multiple cells in PLOAD4");
 				}
-				pload4.add(forceSurface->getForce().norm());
+				pload4.add(forceSurface.getForce().norm());
 				pload4.add(0.0);
 				pload4.add(0.0);
 				pload4.add(0.0);
-				if (!forceSurface->getMoment().iszero()) {
+				if (!forceSurface.getMoment().iszero()) {
 					throw logic_error("Unimplemented moment in PLOAD4");
 				}
 				// TODO LD must recalculate two opposite nodes... hack
-				pload4.add(forceSurface->getApplicationFace()[0]);
-				pload4.add(forceSurface->getApplicationFace()[2]);
-				if (forceSurface->hasCoordinateSystem()) {
-					shared_ptr<CoordinateSystem> coordinateSystem = model->mesh->getCoordinateSystem(forceSurface->coordinate_system_id);
+				pload4.add(forceSurface.getApplicationFace()[0]);
+				pload4.add(forceSurface.getApplicationFace()[2]);
+				if (forceSurface.hasCoordinateSystem()) {
+					shared_ptr<CoordinateSystem> coordinateSystem = model->mesh->getCoordinateSystem(forceSurface.coordinate_system_id);
 					pload4.add(coordinateSystem->bestId());
-					pload4.add(coordinateSystem->vectorToGlobal(forceSurface->getForce().normalized()));
+					pload4.add(coordinateSystem->vectorToGlobal(forceSurface.getForce().normalized()));
 				} else {
 					pload4.add(0);
-					pload4.add(forceSurface->getForce().normalized());
+					pload4.add(forceSurface.getForce().normalized());
 				}
 			}
 		}
@@ -357,7 +422,7 @@ void NastranWriter::writeRuler(ofstream& out) const
 void NastranWriter::writeElements(const shared_ptr<vega::Model>& model, ofstream& out) const
 		{
 	for (shared_ptr<Beam> beam : model->getBeams()) {
-		Line pbeam("PBEAM");
+		Line pbeam("PBEAM", format);
 		pbeam.add(beam->bestId());
 		pbeam.add(beam->material->bestId());
 		pbeam.add(beam->getAreaCrossSection());
@@ -367,16 +432,16 @@ void NastranWriter::writeElements(const shared_ptr<vega::Model>& model, ofstream
 		pbeam.add(beam->getTorsionalConstant());
 		out << pbeam;
 	}
-	for (shared_ptr<ElementSet> shell : model->elementSets.filter(ElementSet::Type::SHELL)) {
-		Line pshell("PSHELL");
-		pshell.add(shell->bestId());
-		pshell.add(shell->material->bestId());
+	for (const Shell& shell : model->elementSets.filter<ElementSet::Type::SHELL>()) {
+		Line pshell("PSHELL", format);
+		pshell.add(shell.bestId());
+		pshell.add(shell.material->bestId());
 		out << pshell;
 	}
-	for (shared_ptr<ElementSet> continuum : model->elementSets.filter(ElementSet::Type::CONTINUUM)) {
-		Line psolid("PSOLID");
-		psolid.add(continuum->bestId());
-		psolid.add(continuum->material->bestId());
+	for (const Continuum& continuum : model->elementSets.filter<ElementSet::Type::CONTINUUM>()) {
+		Line psolid("PSOLID", format);
+		psolid.add(continuum.bestId());
+		psolid.add(continuum.material->bestId());
 		out << psolid;
 	}
 }
@@ -389,6 +454,7 @@ string NastranWriter::writeModel(const shared_ptr<vega::Model> model,
 		throw iostream::failure("Directory " + outputPath + " don't exist.");
 	}
 
+	format = CardStream::formatByName(configuration.nastranOutputFormat);
 	string datPath = getDatFilename(model, outputPath);
 	ofstream out;
 	out.precision(DBL_DIG);
@@ -422,15 +488,15 @@ string NastranWriter::writeModel(const shared_ptr<vega::Model> model,
 		switch (coordinateSystem->type) {
 			case CoordinateSystem::Type::CARTESIAN:
 				// TODO LD complete
-				out << Line("CORD2R").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
+				out << Line("CORD2R", format).add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
 				break;
 			case CoordinateSystem::Type::SPHERICAL:
 				// TODO LD complete
-				out << Line("CORD2S").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
+				out << Line("CORD2S", format).add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
 				break;
 			case CoordinateSystem::Type::CYLINDRICAL:
 				// TODO LD complete
-				out << Line("CORD2C").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
+				out << Line("CORD2C", format).add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
 				break;
 			case CoordinateSystem::Type::ORIENTATION:
 				// Nothing to do here: it will be handled by CBEAM, CBAR etc.
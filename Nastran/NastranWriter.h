@@ -20,19 +20,73 @@
 #include "../Abstract/Model.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "../Abstract/OutputBuffer.h"
 
 namespace vega {
 namespace nastran {
 
+/**
+ * Layout of the fields of the bulk cards: short (8 columns), large (16 columns, keyword followed
+ * by '*') or free (comma separated).
+ */
+enum class FieldFormat {
+	SHORT,
+	LARGE,
+	FREE
+};
+
+/**
+ * Cards written field by field, with their continuation lines, either in memory or straight
+ * to an output stream.
+ */
+class CardStream final {
+private:
+	OutputBuffer buffer;
+	const FieldFormat format;
+	unsigned int fieldCount = 0;
+	/**
+	 * Starts a continuation line when the current one is full.
+	 */
+	void nextField();
+public:
+	/**
+	 * Card kept in memory, see str().
+	 */
+	explicit CardStream(FieldFormat format);
+	CardStream(std::ostream& out, FieldFormat format);
+	/**
+	 * Format named short, large or free, as given on the command line.
+	 * Throws invalid_argument for any other name.
+	 */
+	static FieldFormat formatByName(const std::string& name);
+	/**
+	 * Starts a new card.
+	 */
+	CardStream& card(const std::string& keyword);
+	CardStream& add();
+	CardStream& add(double);
+	CardStream& add(const std::string&);
+	CardStream& add(int);
+	/**
+	 * Ends the current card.
+	 */
+	void end() {
+		buffer << '\n';
+	}
+	const std::string& str() const {
+		return buffer.str();
+	}
+	void flush() {
+		buffer.flush();
+	}
+};
+
 class Line {
 private:
 	friend std::ostream &operator<<(std::ostream &out, const Line& line);
-	unsigned int fieldLength = 0;
-	unsigned int fieldNum = 0;
-	const std::string keyword = "";
-	std::vector<std::string> fields;
+	CardStream fields;
 public:
-	Line(std::string);
+	Line(std::string, FieldFormat format = FieldFormat::SHORT);
 	Line& add();
 	Line& add(double);
 	Line& add(std::string);
@@ -51,6 +105,7 @@ public:
 	std::string writeModel(const std::shared_ptr<Model> model_ptr, const ConfigurationParameters&) override;
     const std::string toString() const override;
 private:
+	FieldFormat format = FieldFormat::SHORT;
 	std::string getDatFilename(const std::shared_ptr<vega::Model>& model, const std::string& outputPath) const;
 	void writeSOL(const std::shared_ptr<vega::Model>& model, std::ofstream& out) const;
 	void writeCells(const std::shared_ptr<vega::Model>& model, std::ofstream& out) const;
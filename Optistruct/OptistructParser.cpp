@@ -115,18 +115,14 @@ void OptistructParser::parseSET(nastran::NastranTokenizer& tok, shared_ptr<Model
     if (type == "GRID") {
         shared_ptr<NodeGroup> nodeGroup = model->mesh->findOrCreateNodeGroup(name,NodeGroup::NO_ORIGINAL_ID,"SET");
         while(!tok.isEmptyUntilNextKeyword()) {
-            for (auto& id : tok.nextInts()) {
-                nodeGroup->addNodeId(id);
-            }
+            nodeGroup->addNodeIds(tok.nextInts());
             tok.skipToNotEmpty();
         }
         tok.skipToNextKeyword();
     } else if (type == "ELEM") {
         shared_ptr<CellGroup> cellGroup = model->mesh->createCellGroup(name,CellGroup::NO_ORIGINAL_ID,"SET");
         while(!tok.isEmptyUntilNextKeyword()) {
-            for (auto& id : tok.nextInts()) {
-                cellGroup->addCellId(id);
-            }
+            cellGroup->addCellIds(tok.nextInts());
             tok.skipToNotEmpty();
         }
         tok.skipToNextKeyword();
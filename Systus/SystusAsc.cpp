@@ -94,34 +94,37 @@ void SystusMatrix::setValue(int i, int j, int dofi, int dofj, double value){
 // A lot of fields are filled with 0, because we don't know what to put here
 // Nonetheless, it seems to work fine this way
 // TODO: Complete the writer
-ostream& operator<<(ostream& os, const SystusMatrix & sm)
-{
-  os << "0"<<endl;  // Size of matrix ?
-  os << sm.id <<endl;  //
-  os << sm.nbNodes <<endl;  //
-  os << sm.nbNodes <<endl;  //
-  os << sm.size <<endl;  //
-  os << "0"<<endl;  //
-  os << "0"<<endl;  //
+void SystusMatrix::write(OutputBuffer& out) const{
+  out << "0\n";  // Size of matrix ?
+  out << id << '\n';  //
+  out << nbNodes << '\n';  //
+  out << nbNodes << '\n';  //
+  out << size << '\n';  //
+  out << "0\n";  //
+  out << "0\n";  //
 
   // Nodes
-  for (int i=1; i<=sm.nbNodes;i++)
-      os << i <<endl;
+  for (int i=1; i<=nbNodes;i++)
+      out << i << '\n';
 
   // Matrix elements. All dofs of SM(i,j) are written in one line
   systus_ascid_t ioff=0;
-  systus_ascid_t sizeM = sm.nbDOFS*sm.nbDOFS;
-  for (int i=0; i<sm.nbNodes; i++){
-      for (int j=0; j<sm.nbNodes; j++){
+  systus_ascid_t sizeM = nbDOFS*nbDOFS;
+  for (int i=0; i<nbNodes; i++){
+      for (int j=0; j<nbNodes; j++){
           for (systus_ascid_t k=0; k<sizeM; k++){
-              os << sm.values[k +ioff]<<" ";
+              out << values[k +ioff] << ' ';
           }
-          os << endl;
+          out << '\n';
           ioff+= sizeM;
       }
   }
+}
 
-  //os << "0"<<endl;
+ostream& operator<<(ostream& os, const SystusMatrix & sm)
+{
+  OutputBuffer buffer(os);
+  sm.write(buffer);
   return os;
 }
 
@@ -151,22 +154,24 @@ vector<SystusMatrix>::size_type SystusMatrices::size() const {
 // TODO: Complete the writer
 ostream& operator<<(ostream& os, const SystusMatrices & sms)
 {
+  OutputBuffer buffer(os);
   for (int i=1 ; i<12; i++)
-      os << "0"<<endl;  // Useless parameters ?
-  os << sms.nbDOFS << endl;
+      buffer << "0\n";  // Useless parameters ?
+  buffer << sms.nbDOFS << '\n';
   for (int i=13 ; i<22; i++)
-      os << "0"<<endl;  // Useless parameters ?
+      buffer << "0\n";  // Useless parameters ?
 
-  for (systus_ascid_t i=0; i< sms.matrices.size(); i++)
-      os << sms.matrices[i];
+  for (const SystusMatrix& matrix : sms.matrices)
+      matrix.write(buffer);
 
   // End of file
-  os << SystusMatrix(0,0,0) <<endl;  //
+  SystusMatrix(0,0,0).write(buffer);
+  buffer << '\n';
   return os;
 }
 
 
-
+
 string SystusOptionToString(SystusOption sO, SystusSubOption ssO){
     string s1 = SystusOptiontoString.find(sO)->second;
     string s2 = SystusSubOptiontoString.find(ssO)->second;
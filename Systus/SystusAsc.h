@@ -26,11 +26,13 @@
 #ifndef SYSTUSASC_H_
 #define SYSTUSASC_H_
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <string>
 #include <iostream>
 #include "../Abstract/Dof.h"
+#include "../Abstract/OutputBuffer.h"
 
 
 namespace vega {
@@ -86,6 +88,10 @@ public:
     virtual ~SystusMatrix();
 
     void setValue(int i, int j, int dofi, int dofj, double value);
+    /**
+     * Print a SystusMatrix to the output buffer, values taken straight from the values vector.
+     */
+    void write(OutputBuffer& out) const;
     /**
      * Print a SystusMatrix to the output stream.
      */
@@ -119,6 +125,55 @@ public:
 };
 
 
+/**
+ * Values indexed by node position, for the few nodes of the mesh which have one (a sparse set).
+ * Access and insertion take constant time: the memory is one integer by node of the mesh, plus
+ * the values.
+ */
+template<typename T>
+class NodePositionMap{
+private:
+    std::vector<int> indexByPosition; /**< 1 + index of the position in positions, 0 if it has no value **/
+    std::vector<int> positions;
+    std::vector<T> values;
+public:
+    /**
+     * Remove all values, and prepare for node positions in [0, nodeCount[.
+     */
+    void reset(int nodeCount){
+        indexByPosition.assign(static_cast<size_t>(nodeCount), 0);
+        positions.clear();
+        values.clear();
+    }
+    void clear(){
+        reset(0);
+    }
+    /**
+     * Value of the node position, default constructed if it had none.
+     */
+    T& operator[](int position){
+        int& index = indexByPosition[static_cast<size_t>(position)];
+        if (index == 0){
+            positions.push_back(position);
+            values.emplace_back();
+            index = static_cast<int>(positions.size());
+        }
+        return values[static_cast<size_t>(index - 1)];
+    }
+    const T& at(int position) const{
+        return values[static_cast<size_t>(indexByPosition[static_cast<size_t>(position)] - 1)];
+    }
+    /**
+     * Node positions which have a value, in increasing order.
+     */
+    std::vector<int> sortedPositions() const{
+        std::vector<int> sorted(positions);
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+};
+
+
 enum class SystusOption : int {
     SHELL = 3,
     CONTINUOUS = 4
@@ -139,7 +194,7 @@ static const std::map<SystusSubOption, std::string> SystusSubOptiontoString = {
 std::string SystusOptionToString(SystusOption sO, SystusSubOption ssO);
 std::ostream& operator<<(std::ostream& os, const SystusOption & sO);
 std::ostream& operator<<(std::ostream& os, const SystusSubOption & ssO);
-
+
 } // namespace systus
 } // namespace vega
 #endif /* SYSTUSASC_H_ */
@@ -28,6 +28,7 @@
 #include <memory>
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include "SystusWriter.h"
 #include "SystusAsc.h"
@@ -278,9 +279,7 @@ CartesianCoordinateSystem SystusWriter::buildElementDefaultReferentiel(const Sys
 
 }
 
-int SystusWriter::auto_part_id = 99999999;
-
-int SystusWriter::getPartId(const string partName, set<int> & usedPartId) {
+int SystusWriter::getPartId(const string partName, set<int> & usedPartId, SystusSubcase& subcase) {
 
     int partId;
 
@@ -290,15 +289,15 @@ int SystusWriter::getPartId(const string partName, set<int> & usedPartId) {
         try{
             partId = std::stoi(partName.substr(pos+1));
         }catch(...){
-            partId = auto_part_id--;
+            partId = subcase.auto_part_id--;
         }
     }else{
-        partId = auto_part_id--;
+        partId = subcase.auto_part_id--;
     }
 
     // If the Part Id is unavailable, we find another one.
     while (usedPartId.find(partId)!= usedPartId.end()){
-        partId = auto_part_id--;
+        partId = subcase.auto_part_id--;
     }
 
     usedPartId.insert(partId);
@@ -395,14 +394,55 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
     getSystusInformations(systusModel, configuration);
     generateRBEs(systusModel, configuration);
     generateSubcases(systusModel, configuration);
+    this->clear();
+    this->translateInvariants(systusModel);
+
+    /* Matrices are the same for all subcases: their files are written once */
+    this->writeMatrixFiles(systusModel);
+
+    if (configuration.incremental) {
+        manifest = unique_ptr<OutputManifest>(new OutputManifest(systusModel.getOutputFileName(".manifest")));
+    }
+
+    /* Subcases are independent: each one is translated in its own SystusSubcase,
+     * reading the invariant translation, on its own thread. */
+    parallelChunks<bool>(systusSubcases.size(), [&](size_t begin, size_t end) {
+        for (size_t idSubcase = begin; idSubcase < end; idSubcase++) {
+            writeSubcase(systusModel, configuration, static_cast<int>(idSubcase));
+        }
+        return true;
+    }, 1);
+    if (manifest != nullptr) {
+        manifest->save();
+        manifest.reset();
+    }
+
+    if (configuration.systusOutputProduct=="systus"){
+        for (unsigned idSubcase = 0; idSubcase< systusSubcases.size(); idSubcase++){
+            dat_file_ofs << "READ " << systusModel.getName() << "_SC" << to_string(idSubcase+1) << ".DAT" << endl;
+        }
+        dat_file_ofs.close();
+    }
+    return dat_path;
+}
 
-    for (unsigned idSubcase = 0; idSubcase< systusSubcases.size(); idSubcase++){
+void SystusWriter::writeSubcase(const SystusModel& systusModel, const ConfigurationParameters& configuration,
+        const int idSubcase) {
 
-        /* Translation and filling of a lots of things */
-        this->translate(systusModel, idSubcase);
+    /* Translation and filling of a lots of things */
+    SystusSubcase subcase;
+    this->translate(systusModel, idSubcase, subcase);
 
-        /* ASCI file */
-        string asc_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1)+ "_DATA1.ASC");
+    /* ASCI file */
+    string asc_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1)+ "_DATA1.ASC");
+    uint64_t ascHash = 0;
+    bool writeAscFile = true;
+    if (manifest != nullptr) {
+        ascHash = hashAsc(systusModel, configuration, idSubcase, subcase);
+        lock_guard<mutex> lock(manifestMutex);
+        writeAscFile = !manifest->isUnchanged(asc_path, ascHash);
+    }
+    if (writeAscFile) {
         ofstream asc_file_ofs;
         asc_file_ofs.precision(DBL_DIG);
         asc_file_ofs.open(asc_path.c_str(), ios::trunc | ios::out);
@@ -410,34 +450,28 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
             string message = string("Can't open file ") + asc_path + " for writing.";
             throw ios::failure(message);
         }
-        this->writeAsc(systusModel, configuration, idSubcase, asc_file_ofs);
+        this->writeAsc(systusModel, configuration, idSubcase, subcase, asc_file_ofs);
         asc_file_ofs.close();
-
-        /* Write some matrix files, if needed */
-        this->writeMatrixFiles(systusModel, idSubcase);
-
-        /* Analysis file */
-        ofstream analyse_file_ofs;
-        analyse_file_ofs.precision(DBL_DIG);
-        string analyse_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + ".DAT");
-        analyse_file_ofs.open(analyse_path.c_str(), ios::trunc);
-
-        if (!analyse_file_ofs.is_open()) {
-            string message = string("Can't open file ") + analyse_path + " for writing.";
-            throw ios::failure(message);
-        }
-        this->writeDat(systusModel, configuration, idSubcase, analyse_file_ofs);
-        analyse_file_ofs.close();
-
-        if (configuration.systusOutputProduct=="systus"){
-            dat_file_ofs << "READ " << systusModel.getName() << "_SC" << to_string(idSubcase+1) << ".DAT" << endl;
+        if (manifest != nullptr) {
+            lock_guard<mutex> lock(manifestMutex);
+            manifest->update(asc_path, ascHash);
         }
+    } else if (configuration.logLevel >= LogLevel::INFO) {
+        cout << "Subcase " << idSubcase + 1 << " unchanged, " << asc_path << " not written." << endl;
     }
 
-    if (configuration.systusOutputProduct=="systus"){
-        dat_file_ofs.close();
+    /* Analysis file */
+    ofstream analyse_file_ofs;
+    analyse_file_ofs.precision(DBL_DIG);
+    string analyse_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + ".DAT");
+    analyse_file_ofs.open(analyse_path.c_str(), ios::trunc);
+
+    if (!analyse_file_ofs.is_open()) {
+        string message = string("Can't open file ") + analyse_path + " for writing.";
+        throw ios::failure(message);
     }
-    return dat_path;
+    this->writeDat(systusModel, configuration, idSubcase, subcase, analyse_file_ofs);
+    analyse_file_ofs.close();
 }
 
 void SystusWriter::getSystusAutomaticOption(const SystusModel& systusModel, SystusOption & autoSystusOption, SystusSubOption & autoSystusSubOption) {
@@ -709,10 +743,11 @@ void SystusWriter::generateRBEs(const SystusModel& systusModel,
                 }
                 rigidNature.setLagrangian(configuration.systusRBELagrangian);
             }else{
+               // The rigid material may be shared by several element sets: their rigidity is kept apart
                if (is_equal(configuration.systusRBE2Rigidity, Globals::UNAVAILABLE_DOUBLE)){
-                   rigidNature.setRigidity(generateRbarRigidity(systusModel, rbars));
+                   rigidityByElementSet[elementSet->getId()] = generateRbarRigidity(systusModel, rbars);
                }else{
-                   rigidNature.setRigidity(configuration.systusRBE2Rigidity);
+                   rigidityByElementSet[elementSet->getId()] = configuration.systusRBE2Rigidity;
                }
             }
 
@@ -873,10 +908,11 @@ void SystusWriter::generateRBEs(const SystusModel& systusModel,
                 }
                 rigidNature.setLagrangian(configuration.systusRBELagrangian);
             }else{
+               // The rigid material may be shared by several element sets: their rigidity is kept apart
                if (is_equal(configuration.systusRBE2Rigidity, Globals::UNAVAILABLE_DOUBLE)){
-                   rigidNature.setRigidity(generateLmpcRigidity(systusModel, lmpc));
+                   rigidityByElementSet[elementSet->getId()] = generateLmpcRigidity(systusModel, lmpc);
                }else{
-                   rigidNature.setRigidity(configuration.systusRBE2Rigidity);
+                   rigidityByElementSet[elementSet->getId()] = configuration.systusRBE2Rigidity;
                }
             }
 
@@ -1038,7 +1074,7 @@ void SystusWriter::generateSubcases(const SystusModel& systusModel,
 }
 
 // Select the Loads of the current analysis and give them a local Systus number.
-void SystusWriter::fillLoads(const SystusModel& systusModel, const int idSubcase){
+void SystusWriter::fillLoads(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase){
 
     int idSystusLoad=1;
 
@@ -1052,30 +1088,30 @@ void SystusWriter::fillLoads(const SystusModel& systusModel, const int idSubcase
             cerr << "Warning in Filling Loads : wrong analysis number ("<< analysisId[i]<<") Analysis dismissed"<<endl;
             break;
         }
-        localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]= {};
+        subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]= {};
         const vector<shared_ptr<LoadSet>> analysisLoadSets = analysis->getLoadSets();
         int idSystusLoadByAnalysis=0;
         for (const auto& loadSet : analysisLoadSets) {
-            localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][loadSet->getId()]= idSystusLoad;
+            subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][loadSet->getId()]= idSystusLoad;
 
             // Title of Loadset is of the form AnalysisName_lLoadId.
             // It is limited to 80 characters
             string suffixe = "_LOAD"+to_string(loadSet->bestId());
-            localLoadingListName[idSystusLoad]= analysis->getLabel().substr(0, 80 - suffixe.length())+ suffixe;
+            subcase.localLoadingListName[idSystusLoad]= analysis->getLabel().substr(0, 80 - suffixe.length())+ suffixe;
             idSystusLoad++;
             idSystusLoadByAnalysis++;
         }
 
         // We need at least one loadset by analysis
         if (idSystusLoadByAnalysis==0){
-            localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][0]= idSystusLoad;
-            localLoadingListName[idSystusLoad]= analysis->getLabel().substr(0, 80);
+            subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][0]= idSystusLoad;
+            subcase.localLoadingListName[idSystusLoad]= analysis->getLabel().substr(0, 80);
             idSystusLoad++;
         }
     }
 }
 
-void SystusWriter::writeNodalForce(const SystusModel& systusModel, shared_ptr<NodalForce> nodalForce, const int idLoadCase, systus_ascid_t& vectorId) {
+void SystusWriter::writeNodalForce(const SystusModel& systusModel, shared_ptr<NodalForce> nodalForce, const int idLoadCase, systus_ascid_t& vectorId, SystusSubcase& subcase) {
 
     for(auto& nodePosition : nodalForce->nodePositions()) {
         const VectorialValue& force = nodalForce->getForceInGlobalCS(nodePosition);
@@ -1099,8 +1135,8 @@ void SystusWriter::writeNodalForce(const SystusModel& systusModel, shared_ptr<No
             vec.push_back(moment.z()); normvec=max(normvec, abs(moment.z()));
         }
         if (!is_zero(normvec)){
-            vectors[vectorId]=vec;
-            loadingVectorsIdByLocalLoadingByNodePosition[nodePosition][idLoadCase].push_back(vectorId);
+            subcase.vectors[vectorId]=vec;
+            subcase.loadingVectorsIdByLocalLoadingByNodePosition[nodePosition][idLoadCase].push_back(vectorId);
             vectorId++;
         }
         // Rigid Body Element in option 3D.
@@ -1121,8 +1157,8 @@ void SystusWriter::writeNodalForce(const SystusModel& systusModel, shared_ptr<No
                 vec.push_back(moment.y()); normvec=max(normvec, abs(moment.y()));
                 vec.push_back(moment.z()); normvec=max(normvec, abs(moment.z()));
                 if (!is_zero(normvec)){
-                    vectors[vectorId]=vec;
-                    loadingVectorsIdByLocalLoadingByNodePosition[rotNodePosition][idLoadCase].push_back(vectorId);
+                    subcase.vectors[vectorId]=vec;
+                    subcase.loadingVectorsIdByLocalLoadingByNodePosition[rotNodePosition][idLoadCase].push_back(vectorId);
                     vectorId++;
                 }
             }
@@ -1130,10 +1166,10 @@ void SystusWriter::writeNodalForce(const SystusModel& systusModel, shared_ptr<No
     }
 }
 
-void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int idSubcase){
+void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase){
 
     // First available vector
-    systus_ascid_t vectorId= vectors.size()+1;
+    systus_ascid_t vectorId= subcase.vectors.size()+1;
 
     // All analysis to do
     const vector<int> analysisId = systusSubcases[idSubcase];
@@ -1152,14 +1188,14 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
         // It's not mandatory, providing you can match the loading to its set of (node, vector).
         // But, it's easier this way ;)
         for (const auto& loadset : analysis->getLoadSets()){
-            const int idLoadCase = localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][loadset->getId()];
-            loadingVectorIdByLocalLoading[idLoadCase]=0;
+            const int idLoadCase = subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][loadset->getId()];
+            subcase.loadingVectorIdByLocalLoading[idLoadCase]=0;
             for (const auto& loading : loadset->getLoadings()) {
 
                 switch (loading->type) {
                 case Loading::Type::NODAL_FORCE: {
                     shared_ptr<NodalForce> nodalForce = dynamic_pointer_cast<NodalForce>(loading);
-                    writeNodalForce(systusModel, nodalForce, idLoadCase, vectorId);
+                    writeNodalForce(systusModel, nodalForce, idLoadCase, vectorId, subcase);
                     break;
                 }
 
@@ -1180,11 +1216,11 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                     vec.push_back(0);
                     vec.push_back(acceleration.z()); normvec=max(normvec, abs(acceleration.z()));
                     if (!is_zero(normvec)){
-                        if (loadingVectorIdByLocalLoading[idLoadCase]!=0){
+                        if (subcase.loadingVectorIdByLocalLoading[idLoadCase]!=0){
                             handleWritingWarning("GRAVITY already defined for this loadcase. Dismissing load "+ to_string(gravity->bestId()) );
                         }else{
-                            vectors[vectorId]=vec;
-                            loadingVectorIdByLocalLoading[idLoadCase]= vectorId;
+                            subcase.vectors[vectorId]=vec;
+                            subcase.loadingVectorIdByLocalLoading[idLoadCase]= vectorId;
                             vectorId++;
                         }
                     }
@@ -1234,7 +1270,7 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                         }
 
                         shared_ptr<NodalForce> nodalForce = dynamic_pointer_cast<NodalForce>(dLoading);
-                        writeNodalForce(systusModel, nodalForce, idLoadCase, vectorId);
+                        writeNodalForce(systusModel, nodalForce, idLoadCase, vectorId, subcase);
                     }
 
                     break;
@@ -1251,10 +1287,10 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
 }
 
 
-void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const int idSubcase){
+void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase){
 
     // First available vector
-    auto vectorId = vectors.size()+1;
+    auto vectorId = subcase.vectors.size()+1;
 
     // All analysis to do
     const vector<int> analysisId = systusSubcases[idSubcase];
@@ -1295,10 +1331,10 @@ void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const
                         }
 
                         if (!is_zero(normvec)){
-                            vectors[vectorId]=vec;
-                            for (const auto& it : localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]){
+                            subcase.vectors[vectorId]=vec;
+                            for (const auto& it : subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]){
                                 for (int nodePosition : constraint->nodePositions()){
-                                    constraintVectorsIdByLocalLoadingByNodePosition[nodePosition][it.second].push_back(vectorId);
+                                    subcase.constraintVectorsIdByLocalLoadingByNodePosition[nodePosition][it.second].push_back(vectorId);
                                 }
                             }
                             vectorId++;
@@ -1329,11 +1365,11 @@ void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const
                                     const auto & it = rotationNodeIdByTranslationNodeId.find(nid);
                                     if (it!=rotationNodeIdByTranslationNodeId.end()){
                                         int rotNodePosition= systusModel.model->mesh->findNodePosition(it->second);
-                                        for (const auto & it2 : localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]){
-                                            constraintVectorsIdByLocalLoadingByNodePosition[rotNodePosition][it2.second].push_back(vectorId);
+                                        for (const auto & it2 : subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]){
+                                            subcase.constraintVectorsIdByLocalLoadingByNodePosition[rotNodePosition][it2.second].push_back(vectorId);
                                         }
                                         if (firstTime){
-                                            vectors[vectorId]=vec;
+                                            subcase.vectors[vectorId]=vec;
                                             vectorId++;
                                             firstTime = false;
                                         }
@@ -1361,13 +1397,9 @@ void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const
 }
 
 
-void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const int idSubcase){
-
-    UNUSEDV(idSubcase);
+void SystusWriter::fillCoordinateSystemVectors(const SystusModel& systusModel, SystusInvariants& invariants){
 
-    // First available vector
-    systus_ascid_t vectorId = vectors.size()+1;
-    map<int, systus_ascid_t> localVectorIdByCoordinateSystemPos;
+    map<int, size_t> vectorByCoordinateSystemPos;
 
     // Add vectors for Node Coordinate System
     // Remark: Element Coordinate System are not translated as vectors
@@ -1376,9 +1408,9 @@ void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const
         if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
 
             // Trick for not doing the Cartesian coordinate systems all over again;
-            auto it = localVectorIdByCoordinateSystemPos.find(node.displacementCS);
-            if (it != localVectorIdByCoordinateSystemPos.end()){
-                localVectorIdByNodePosition[node.position] = it->second;
+            auto it = vectorByCoordinateSystemPos.find(node.displacementCS);
+            if (it != vectorByCoordinateSystemPos.end()){
+                invariants.coordinateSystemVectorByNodePosition.push_back({node.position, it->second});
                 continue;
             }
 
@@ -1396,7 +1428,7 @@ void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const
                 vec.push_back(angles.x());
                 vec.push_back(angles.y());
                 vec.push_back(angles.z());
-                localVectorIdByCoordinateSystemPos[node.displacementCS]=vectorId;
+                vectorByCoordinateSystemPos[node.displacementCS]=invariants.coordinateSystemVectors.size();
                 break;
             }
             // Element orientation : it depends of the kind of elements.
@@ -1418,9 +1450,10 @@ void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const
             // Cylyndrical orientation : we create a vector by point
             case CoordinateSystem::Type::CYLINDRICAL:{
                 const Node& nNode = mesh->findNode(node.position);
-                shared_ptr<CylindricalCoordinateSystem> ccs = dynamic_pointer_cast<CylindricalCoordinateSystem>(cs);
-                ccs->updateLocalBase(VectorialValue(nNode.x, nNode.y, nNode.z));
-                const VectorialValue& angles = ccs->getLocalEulerAnglesIntrinsicZYX(); // (PSI, THETA, PHI)
+                // The local base is updated on a copy: the model is shared by the subcase writers
+                CylindricalCoordinateSystem ccs(*dynamic_pointer_cast<CylindricalCoordinateSystem>(cs));
+                ccs.updateLocalBase(VectorialValue(nNode.x, nNode.y, nNode.z));
+                const VectorialValue& angles = ccs.getLocalEulerAnglesIntrinsicZYX(); // (PSI, THETA, PHI)
                 vec.push_back(0);
                 vec.push_back(0);
                 vec.push_back(0);
@@ -1449,25 +1482,36 @@ void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const
                 vec.push_back(0.0);
             }
             }
-            vectors[vectorId]=vec;
-            localVectorIdByNodePosition[node.position]=vectorId;
-            vectorId++;
+            invariants.coordinateSystemVectorByNodePosition.push_back({node.position, invariants.coordinateSystemVectors.size()});
+            invariants.coordinateSystemVectors.push_back(vec);
         }
     }
 }
 
+void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase){
+
+    UNUSEDV(systusModel);
+    UNUSEDV(idSubcase);
+
+    // First available vector: the coordinate system vectors are written after those of the subcase
+    const systus_ascid_t firstVectorId = subcase.vectors.size()+1;
+    for (const auto& it : invariants->coordinateSystemVectorByNodePosition) {
+        subcase.localVectorIdByNodePosition[static_cast<size_t>(it.first)] = firstVectorId + it.second;
+    }
+}
+
 // Fill the vectors field with Vectors relative to Loadings and Castings
 //TODO: add all vectors in this function
-void SystusWriter::fillVectors(const SystusModel& systusModel, const int idSubcase){
+void SystusWriter::fillVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase){
 
     // Work
-    fillLoadingsVectors(systusModel, idSubcase);
-    fillConstraintsVectors(systusModel, idSubcase);
-    fillCoordinatesVectors(systusModel, idSubcase);
+    fillLoadingsVectors(systusModel, idSubcase, subcase);
+    fillConstraintsVectors(systusModel, idSubcase, subcase);
+    fillCoordinatesVectors(systusModel, idSubcase, subcase);
 }
 
 
-void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const int idLoadcase){
+void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const int idLoadcase, SystusSubcase& subcase){
 
     const shared_ptr<Mesh> mesh = systusModel.model->mesh;
 
@@ -1496,12 +1540,8 @@ void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const in
 
                     // We compute the Degree Of Freedom of the node (see ASC Manual)
                     DOFS constrained = constraint->getDOFSForNode(nodePosition);
-                    if (constraintByNodePosition.find(nodePosition) == constraintByNodePosition.end()){
-                        constraintByNodePosition[nodePosition] = char(constrained) & dofCode;
-                    }else{
-                        constraintByNodePosition[nodePosition] = (char(constrained) & dofCode)
-                                            | constraintByNodePosition[nodePosition];
-                    }
+                    subcase.constraintByNodePosition[nodePosition] = (char(constrained) & dofCode)
+                                        | subcase.constraintByNodePosition[nodePosition];
 
                     // Rigid Body Element in option 3D.
                     // We report the constraints from the master node to the master rotational node.
@@ -1511,12 +1551,8 @@ void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const in
                         if (it != rotationNodeIdByTranslationNodeId.end()){
                             DOFS constrainedRot(constrained.contains(DOF::RX),constrained.contains(DOF::RY),constrained.contains(DOF::RZ));
                             int rotNodePosition= mesh->findNodePosition(it->second);
-                            if (constraintByNodePosition.find(rotNodePosition) == constraintByNodePosition.end()){
-                                constraintByNodePosition[rotNodePosition] = char(constrainedRot) & dofCode;
-                            }else{
-                                constraintByNodePosition[rotNodePosition] = (char(constrainedRot) & dofCode)
-                                                    | constraintByNodePosition[rotNodePosition];
-                            }
+                            subcase.constraintByNodePosition[rotNodePosition] = (char(constrainedRot) & dofCode)
+                                                | subcase.constraintByNodePosition[rotNodePosition];
                         }
                     }
                 }
@@ -1537,7 +1573,7 @@ void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const in
 }
 
 
-void SystusWriter::fillLists(const SystusModel& systusModel, const int idSubcase) {
+void SystusWriter::fillLists(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase) {
 
     // Suppressing warnings. Technically, we don't need these variables. We
     // keep them to remember that this function relies heavily on lists built before.
@@ -1549,36 +1585,36 @@ void SystusWriter::fillLists(const SystusModel& systusModel, const int idSubcase
     int idSystusList=1;
 
     // Building lists for Loading on nodes
-    for (const auto& it : loadingVectorsIdByLocalLoadingByNodePosition){
-        loadingListIdByNodePosition[it.first] = idSystusList;
+    for (int nodePosition : subcase.loadingVectorsIdByLocalLoadingByNodePosition.sortedPositions()){
+        subcase.loadingListIdByNodePosition[nodePosition] = idSystusList;
         vector<systus_ascid_t> sl;
-        for (const auto & it2 : it.second){
+        for (const auto & it2 : subcase.loadingVectorsIdByLocalLoadingByNodePosition.at(nodePosition)){
             for (const systus_ascid_t vectorId : it2.second){
                 sl.push_back(it2.first);
                 sl.push_back(vectorId);
             }
         }
-        lists[idSystusList]= sl;
+        subcase.lists[idSystusList]= sl;
         idSystusList++;
     }
 
     // Building lists for Constraints on nodes
-    for (const auto& it : constraintVectorsIdByLocalLoadingByNodePosition){
-        constraintListIdByNodePosition[it.first] = idSystusList;
+    for (int nodePosition : subcase.constraintVectorsIdByLocalLoadingByNodePosition.sortedPositions()){
+        subcase.constraintListIdByNodePosition[nodePosition] = idSystusList;
         vector<systus_ascid_t> sl;
-        for (const auto & it2 : it.second){
+        for (const auto & it2 : subcase.constraintVectorsIdByLocalLoadingByNodePosition.at(nodePosition)){
             for (const systus_ascid_t vectorId : it2.second){
                 sl.push_back(it2.first);
                 sl.push_back(vectorId);
             }
         }
-        lists[idSystusList]= sl;
+        subcase.lists[idSystusList]= sl;
         idSystusList++;
     }
 }
 
 
-void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcase) {
+void SystusWriter::fillElementSetTables(const SystusModel& systusModel, SystusInvariants& invariants) {
 
 
     if (systusModel.configuration.systusOutputMatrix=="table"){
@@ -1620,7 +1656,7 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 if (pairDOF.first != pairDOF.second){
                     systus_ascid_t tId2=0;
                     if (ss->hasStiffness()){
-                        systus_ascid_t tId= tables.size()+1;
+                        systus_ascid_t tId= invariants.tables.size()+1;
                         SystusTable aTable = SystusTable(tId, SystusTableLabel::TL_STANDARD, 0);
                         const double stiffness = ss->getStiffness();
 
@@ -1636,11 +1672,11 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                         dofCode = 10*DOFToInt(pairDOF.first) + DOFToInt(pairDOF.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(-stiffness);
-                        tables.push_back(aTable);
+                        invariants.tables.push_back(aTable);
                         tId2+=tId;
                     }
                     if (ss->hasDamping()){
-                        systus_ascid_t tId= tables.size()+1;
+                        systus_ascid_t tId= invariants.tables.size()+1;
                         SystusTable aTable = SystusTable(tId, SystusTableLabel::TL_STANDARD, 0);
                         const double damping = ss->getDamping();
 
@@ -1656,10 +1692,10 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                         dofCode = 10*DOFToInt(pairDOF.first) + DOFToInt(pairDOF.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(-damping);
-                        tables.push_back(aTable);
+                        invariants.tables.push_back(aTable);
                         tId2+=tId*10000;
                     }
-                    tableByElementSet[elementSet->getId()]=tId2;
+                    invariants.tableByElementSet[elementSet->getId()]=tId2;
                 }
                 break;
             }
@@ -1672,7 +1708,7 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
             //   - Damping  : XX0000
             case ElementSet::Type::STIFFNESS_MATRIX:{
                 shared_ptr<StiffnessMatrix> sm = dynamic_pointer_cast<StiffnessMatrix>(elementSet);
-                systus_ascid_t tId= tables.size()+1;
+                systus_ascid_t tId= invariants.tables.size()+1;
                 SystusTable aTable = SystusTable(tId, SystusTableLabel::TL_STANDARD, 0);
 
                 //Numbering the node internally to the element
@@ -1684,22 +1720,21 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 }
 
                 // Building the table
-                for (const auto np : sm->nodePairs()){
-                    int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = sm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
-                        int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
+                sm->getBlocks().forEachBlock([&](const DOFBlock& block) {
+                    int pairCode = positionToSytusNumber[block.rowNodePosition]*1000 + positionToSytusNumber[block.columnNodePosition]*100;
+                    block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                        int dofCode = 10*DOFToInt(dof1) + DOFToInt(dof2);
                         aTable.add(pairCode+dofCode);
-                        aTable.add(dof.second);
-                    }
-                }
-                tables.push_back(aTable);
-                tableByElementSet[elementSet->getId()]=tId;
+                        aTable.add(value);
+                    });
+                });
+                invariants.tables.push_back(aTable);
+                invariants.tableByElementSet[elementSet->getId()]=tId;
                 break;
             }
             case ElementSet::Type::MASS_MATRIX:{
                 shared_ptr<MassMatrix> mm = dynamic_pointer_cast<MassMatrix>(elementSet);
-                systus_ascid_t tId= tables.size()+1;
+                systus_ascid_t tId= invariants.tables.size()+1;
                 SystusTable aTable = SystusTable(tId, SystusTableLabel::TL_STANDARD, 0);
 
                 //Numbering the node internally to the element
@@ -1711,22 +1746,21 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 }
 
                 // Building the table
-                for (const auto np : mm->nodePairs()){
-                    int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = mm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
-                        int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
+                mm->getBlocks().forEachBlock([&](const DOFBlock& block) {
+                    int pairCode = positionToSytusNumber[block.rowNodePosition]*1000 + positionToSytusNumber[block.columnNodePosition]*100;
+                    block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                        int dofCode = 10*DOFToInt(dof1) + DOFToInt(dof2);
                         aTable.add(pairCode+dofCode);
-                        aTable.add(dof.second);
-                    }
-                }
-                tables.push_back(aTable);
-                tableByElementSet[elementSet->getId()]=tId*100;
+                        aTable.add(value);
+                    });
+                });
+                invariants.tables.push_back(aTable);
+                invariants.tableByElementSet[elementSet->getId()]=tId*100;
                 break;
             }
             case ElementSet::Type::DAMPING_MATRIX:{
                 shared_ptr<DampingMatrix> dm = dynamic_pointer_cast<DampingMatrix>(elementSet);
-                systus_ascid_t tId= tables.size()+1;
+                systus_ascid_t tId= invariants.tables.size()+1;
                 SystusTable aTable = SystusTable(tId, SystusTableLabel::TL_STANDARD, 0);
 
                 //Numbering the node internally to the element
@@ -1738,17 +1772,16 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 }
 
                 // Building the table
-                for (const auto np : dm->nodePairs()){
-                    int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = dm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
-                        int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
+                dm->getBlocks().forEachBlock([&](const DOFBlock& block) {
+                    int pairCode = positionToSytusNumber[block.rowNodePosition]*1000 + positionToSytusNumber[block.columnNodePosition]*100;
+                    block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                        int dofCode = 10*DOFToInt(dof1) + DOFToInt(dof2);
                         aTable.add(pairCode+dofCode);
-                        aTable.add(dof.second);
-                    }
-                }
-                tables.push_back(aTable);
-                tableByElementSet[elementSet->getId()]=tId*10000;
+                        aTable.add(value);
+                    });
+                });
+                invariants.tables.push_back(aTable);
+                invariants.tableByElementSet[elementSet->getId()]=tId*10000;
                 break;
             }
 
@@ -1758,6 +1791,9 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
             }
         }
     }
+}
+
+void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase) {
 
     // Build tables for linear multipoint constraints
     for (const auto& elementSet : systusModel.model->elementSets) {
@@ -1793,15 +1829,15 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 continue;
             }
             // The Table for Lmpc is simply the list of coef by dof by nodes
-            systus_ascid_t tId= tables.size()+1;
+            systus_ascid_t tId= invariants->tables.size()+subcase.tables.size()+1;
             SystusTable aTable = SystusTable(tId, SystusTableLabel::TL_STANDARD, 0);
             for (DOFCoefs dofCoefs : lmpc->dofCoefs){
                 for (int i =0; i< nbDOFS; i++){
                     aTable.add(dofCoefs[i]);
                 }
             }
-            tables.push_back(aTable);
-            tableByElementSet[elementSet->getId()]=tId;
+            subcase.tables.push_back(aTable);
+            subcase.tableByElementSet[elementSet->getId()]=tId;
             break;
         }
 
@@ -1825,7 +1861,7 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
             }
 
             for (const auto& loadset : analysis->getLoadSets()){
-                const int idLoadCase = localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][loadset->getId()];
+                const int idLoadCase = subcase.localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()][loadset->getId()];
                 for (const auto& loading : loadset->getLoadings()) {
 
                     switch (loading->type){
@@ -1846,15 +1882,15 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                         }
 
                         shared_ptr<FunctionTable> aTable = dE->getFunctionTableB();
-                        int tId= static_cast<int>(tables.size())+1;
+                        int tId= static_cast<int>(invariants->tables.size()+subcase.tables.size())+1;
                         SystusTable aSystusTable = SystusTable(tId);
                         //TODO: Test the units of the table ?
                         for (auto it = aTable->getBeginValuesXY(); it != aTable->getEndValuesXY(); it++){
                             aSystusTable.add(it->first);
                             aSystusTable.add(it->second);
                         }
-                        tables.push_back(aSystusTable);
-                        tableByLoadcase[idLoadCase]= tId;
+                        subcase.tables.push_back(aSystusTable);
+                        subcase.tableByLoadcase[idLoadCase]= tId;
 
                         break;
                     }
@@ -1871,16 +1907,11 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
 
 
 
-void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubcase){
-
-    // Suppressing warnings. Technically, we don't need these variables. We
-    // keep them to remember that only one kind of matrix  are translated yet,
-    // and we don't know what the others will need.
-    UNUSEDV(idSubcase);
+void SystusWriter::fillMatrices(const SystusModel& systusModel, SystusInvariants& invariants){
 
-    dampingMatrices.nbDOFS=nbDOFS;
-    massMatrices.nbDOFS=nbDOFS;
-    stiffnessMatrices.nbDOFS=nbDOFS;
+    invariants.dampingMatrices.nbDOFS=nbDOFS;
+    invariants.massMatrices.nbDOFS=nbDOFS;
+    invariants.stiffnessMatrices.nbDOFS=nbDOFS;
 
     // Fill tables for Stiffness, Mass and Damping elements
     if (systusModel.configuration.systusOutputMatrix=="file"){
@@ -1920,7 +1951,7 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 if (pairDOF.first != pairDOF.second){
                     systus_ascid_t tId2=0;
                     if (ss->hasStiffness()){
-                        systus_ascid_t seId= stiffnessMatrices.size()+1;
+                        systus_ascid_t seId= invariants.stiffnessMatrices.size()+1;
                         // Building the Systus Matrix
                         SystusMatrix aMatrix = SystusMatrix(seId, nbDOFS, 2);
                         int dofI = DOFToInt(pairDOF.first);
@@ -1930,12 +1961,12 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                         aMatrix.setValue(1, 2, dofI, dofJ, -ss->getStiffness());
                         aMatrix.setValue(2, 1, dofJ, dofI, -ss->getStiffness());
                         tId2+=SystusWriter::StiffnessAccessId;
-                        seIdByElementSet[elementSet->getId()]= seId;
-                        stiffnessMatrices.add(aMatrix);
+                        invariants.seIdByElementSet[elementSet->getId()]= seId;
+                        invariants.stiffnessMatrices.add(aMatrix);
 
                     }
                     if (ss->hasDamping()){
-                        systus_ascid_t seId= dampingMatrices.size()+1;
+                        systus_ascid_t seId= invariants.dampingMatrices.size()+1;
                         // Building the Systus Matrix
                         SystusMatrix aMatrix = SystusMatrix(seId, nbDOFS, 2);
                         //for (const auto np : dam->nodePairs()){
@@ -1946,10 +1977,10 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                         aMatrix.setValue(1, 2, dofI, dofJ, -ss->getDamping());
                         aMatrix.setValue(2, 1, dofJ, dofI, -ss->getDamping());
                         tId2+=SystusWriter::DampingAccessId*10000;
-                        seIdByElementSet[elementSet->getId()]= seId;
-                        dampingMatrices.add(aMatrix);
+                        invariants.seIdByElementSet[elementSet->getId()]= seId;
+                        invariants.dampingMatrices.add(aMatrix);
                     }
-                    tableByElementSet[elementSet->getId()]=-tId2;
+                    invariants.tableByElementSet[elementSet->getId()]=-tId2;
                 }
                 break;
             }
@@ -1962,7 +1993,7 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
             //   - Damping  : -XX0000
             case ElementSet::Type::DAMPING_MATRIX:{
                 shared_ptr<DampingMatrix> dam = dynamic_pointer_cast<DampingMatrix>(elementSet);
-                systus_ascid_t seId= dampingMatrices.size()+1;
+                systus_ascid_t seId= invariants.dampingMatrices.size()+1;
 
                 // Numbering the node internally to the element
                 map<int, int> positionToSytusNumber;
@@ -1974,27 +2005,26 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
 
                 // Building the Systus Matrix
                 SystusMatrix aMatrix = SystusMatrix(seId, nbDOFS, iSystus-1);
-                for (const auto np : dam->nodePairs()){
-                    int nI = positionToSytusNumber[np.first];
-                    int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = dam->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
-                        int dofI = DOFToInt(dof.first.first);
-                        int dofJ = DOFToInt(dof.first.second);
-                        aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
-                        aMatrix.setValue(nJ, nI, dofJ, dofI, dof.second);
-                    }
-                }
-
-                tableByElementSet[elementSet->getId()]=-SystusWriter::DampingAccessId*10000;
-                seIdByElementSet[elementSet->getId()]= seId;
-                dampingMatrices.add(aMatrix);
+                dam->getBlocks().forEachBlock([&](const DOFBlock& block) {
+                    int nI = positionToSytusNumber[block.rowNodePosition];
+                    int nJ = positionToSytusNumber[block.columnNodePosition];
+                    block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                        int dofI = DOFToInt(dof1);
+                        int dofJ = DOFToInt(dof2);
+                        aMatrix.setValue(nI, nJ, dofI, dofJ, value);
+                        aMatrix.setValue(nJ, nI, dofJ, dofI, value);
+                    });
+                });
+
+                invariants.tableByElementSet[elementSet->getId()]=-SystusWriter::DampingAccessId*10000;
+                invariants.seIdByElementSet[elementSet->getId()]= seId;
+                invariants.dampingMatrices.add(aMatrix);
                 break;
             }
 
             case ElementSet::Type::MASS_MATRIX:{
                 shared_ptr<MassMatrix> mm = dynamic_pointer_cast<MassMatrix>(elementSet);
-                systus_ascid_t seId= massMatrices.size()+1;
+                systus_ascid_t seId= invariants.massMatrices.size()+1;
 
                 // Numbering the node internally to the element
                 map<int, int> positionToSytusNumber;
@@ -2006,27 +2036,26 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
 
                 // Building the Systus Matrix
                 SystusMatrix aMatrix = SystusMatrix(seId, nbDOFS, iSystus-1);
-                for (const auto np : mm->nodePairs()){
-                    int nI = positionToSytusNumber[np.first];
-                    int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = mm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
-                        int dofI = DOFToInt(dof.first.first);
-                        int dofJ = DOFToInt(dof.first.second);
-                        aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
-                        aMatrix.setValue(nJ, nI, dofJ, dofI, dof.second);
-                    }
-                }
-
-                tableByElementSet[elementSet->getId()]=-SystusWriter::MassAccessId*100;
-                seIdByElementSet[elementSet->getId()]= seId;
-                massMatrices.add(aMatrix);
+                mm->getBlocks().forEachBlock([&](const DOFBlock& block) {
+                    int nI = positionToSytusNumber[block.rowNodePosition];
+                    int nJ = positionToSytusNumber[block.columnNodePosition];
+                    block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                        int dofI = DOFToInt(dof1);
+                        int dofJ = DOFToInt(dof2);
+                        aMatrix.setValue(nI, nJ, dofI, dofJ, value);
+                        aMatrix.setValue(nJ, nI, dofJ, dofI, value);
+                    });
+                });
+
+                invariants.tableByElementSet[elementSet->getId()]=-SystusWriter::MassAccessId*100;
+                invariants.seIdByElementSet[elementSet->getId()]= seId;
+                invariants.massMatrices.add(aMatrix);
                 break;
             }
 
             case ElementSet::Type::STIFFNESS_MATRIX:{
                 shared_ptr<StiffnessMatrix> sm = dynamic_pointer_cast<StiffnessMatrix>(elementSet);
-                systus_ascid_t seId= stiffnessMatrices.size()+1;
+                systus_ascid_t seId= invariants.stiffnessMatrices.size()+1;
 
                 // Numbering the node internally to the element
                 map<int, int> positionToSytusNumber;
@@ -2038,21 +2067,20 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
 
                 // Building the Systus Matrix
                 SystusMatrix aMatrix = SystusMatrix(seId, nbDOFS, iSystus-1);
-                for (const auto np : sm->nodePairs()){
-                    int nI = positionToSytusNumber[np.first];
-                    int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = sm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
-                        int dofI = DOFToInt(dof.first.first);
-                        int dofJ = DOFToInt(dof.first.second);
-                        aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
-                        aMatrix.setValue(nJ, nI, dofJ, dofI, dof.second);
-                    }
-                }
-
-                tableByElementSet[elementSet->getId()]=-SystusWriter::StiffnessAccessId;
-                seIdByElementSet[elementSet->getId()]= seId;
-                stiffnessMatrices.add(aMatrix);
+                sm->getBlocks().forEachBlock([&](const DOFBlock& block) {
+                    int nI = positionToSytusNumber[block.rowNodePosition];
+                    int nJ = positionToSytusNumber[block.columnNodePosition];
+                    block.forEachComponent([&](const DOF& dof1, const DOF& dof2, double value) {
+                        int dofI = DOFToInt(dof1);
+                        int dofJ = DOFToInt(dof2);
+                        aMatrix.setValue(nI, nJ, dofI, dofJ, value);
+                        aMatrix.setValue(nJ, nI, dofJ, dofI, value);
+                    });
+                });
+
+                invariants.tableByElementSet[elementSet->getId()]=-SystusWriter::StiffnessAccessId;
+                invariants.seIdByElementSet[elementSet->getId()]= seId;
+                invariants.stiffnessMatrices.add(aMatrix);
                 break;
             }
 
@@ -2071,85 +2099,83 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
 // Cleaning from previous analysis
 void SystusWriter::clear(){
 
-    // Clear loads
-    localLoadingIdByLoadsetIdByAnalysisId.clear();
-    localLoadingListName.clear();
+    // Subcases own their translation: only the shared one is cleared
+    invariants.reset();
+    filebyAccessId.clear();
 
-    // Clear constraints nodes
-    constraintByNodePosition.clear();
+}
 
-    // Clear vectors
-    vectors.clear();
-    localVectorIdByNodePosition.clear();
-    loadingVectorIdByLocalLoading.clear();
-    loadingVectorsIdByLocalLoadingByNodePosition.clear();
-    constraintVectorsIdByLocalLoadingByNodePosition.clear();
+void SystusWriter::translateInvariants(const SystusModel &systusModel){
 
-    // Clear lists
-    lists.clear();
-    loadingListIdByNodePosition.clear();
-    constraintListIdByNodePosition.clear();
+    auto translation = make_shared<SystusInvariants>();
 
-    // Clear tables
-    tables.clear();
-    tableByElementSet.clear();
-    tableByLoadcase.clear();
+    fillMatrices(systusModel, *translation);
 
-    // Clear matrices
-    seIdByElementSet.clear();
-    dampingMatrices.clear();
-    massMatrices.clear();
-    stiffnessMatrices.clear();
+    fillElementSetTables(systusModel, *translation);
 
-}
+    fillCoordinateSystemVectors(systusModel, *translation);
 
-void SystusWriter::translate(const SystusModel &systusModel, const int idSubcase){
+    // A single subcase streams its elements to its file: buffering them would only cost memory,
+    // unless they are hashed first in incremental mode
+    if (systusSubcases.size() > 1 || systusModel.configuration.incremental) {
+        fillElements(systusModel, *translation);
+    }
 
-    this->clear();
+    invariants = translation;
+}
 
-    fillMatrices(systusModel, idSubcase);
+void SystusWriter::translate(const SystusModel &systusModel, const int idSubcase, SystusSubcase& subcase){
 
-    fillLoads(systusModel, idSubcase);
+    // Node states are indexed by node position: the mesh is complete at this point
+    const int nodeCount = systusModel.model->mesh->countNodes();
+    subcase.constraintByNodePosition.assign(static_cast<size_t>(nodeCount), 0);
+    subcase.localVectorIdByNodePosition.assign(static_cast<size_t>(nodeCount), 0);
+    subcase.loadingListIdByNodePosition.assign(static_cast<size_t>(nodeCount), 0);
+    subcase.constraintListIdByNodePosition.assign(static_cast<size_t>(nodeCount), 0);
+    subcase.loadingVectorsIdByLocalLoadingByNodePosition.reset(nodeCount);
+    subcase.constraintVectorsIdByLocalLoadingByNodePosition.reset(nodeCount);
 
-    fillConstraintsNodes(systusModel, idSubcase);
+    fillLoads(systusModel, idSubcase, subcase);
 
-    fillVectors(systusModel, idSubcase);
+    fillConstraintsNodes(systusModel, idSubcase, subcase);
 
-    fillLists(systusModel, idSubcase);
+    fillVectors(systusModel, idSubcase, subcase);
 
-    fillTables(systusModel, idSubcase);
+    fillLists(systusModel, idSubcase, subcase);
+
+    fillTables(systusModel, idSubcase, subcase);
 }
 
 
 
 void SystusWriter::writeAsc(const SystusModel &systusModel, const vega::ConfigurationParameters &configuration,
-        const int idSubcase, ostream& out) {
+        const int idSubcase, SystusSubcase& subcase, ostream& out) {
 
-    writeHeader(systusModel, out);
+    writeHeader(systusModel, subcase, out);
 
-    writeInformations(systusModel, idSubcase, out);
+    writeInformations(systusModel, idSubcase, subcase, out);
 
-    writeNodes(systusModel, out);
+    writeNodes(systusModel, subcase, out);
 
-    writeElements(systusModel, idSubcase, out);
+    writeElements(systusModel, idSubcase, subcase, out);
 
-    writeGroups(systusModel, out);
+    writeGroups(systusModel, subcase, out);
 
-    writeMaterials(systusModel, configuration, idSubcase, out);
+    writeMaterials(systusModel, configuration, idSubcase, subcase, out);
 
     out << "BEGIN_MEDIA 0" << endl;
     out << "END_MEDIA" << endl;
 
-    writeLoads(out);
+    writeLoads(subcase, out);
 
-    writeLists(out);
+    writeLists(subcase, out);
 
-    writeVectors(out);
+    writeVectors(subcase, out);
 
     out << "BEGIN_RELEASES 0" << endl;
     out << "END_RELEASES" << endl;
 
-    writeTables(out);
+    writeTables(subcase, out);
 
     out << "BEGIN_TEMPERATURES 0 11" << endl;
     out << "END_TEMPERATURES" << endl;
@@ -2178,12 +2204,66 @@ void SystusWriter::writeAsc(const SystusModel &systusModel, const vega::Configur
     out << "END_AFFECTATIONS" << endl;
 }
 
-void SystusWriter::writeHeader(const SystusModel& systusModel, ostream& out) {
+uint64_t SystusWriter::hashAsc(const SystusModel &systusModel, const vega::ConfigurationParameters &configuration,
+        const int idSubcase, SystusSubcase& subcase) {
+    ContentHash hash;
+    hash.add(VEGA_VERSION_MAJOR).add(VEGA_VERSION_MINOR).add(VEGA_VERSION_PATCH).add(string(VEGA_VERSION_EXTRA));
+    hash.add(configuration.inputFile).add(idSubcase).add(static_cast<int>(systusSubOption));
+    ContentHashBuffer hashBuffer(hash);
+    ostream out(&hashBuffer);
+    out.precision(DBL_DIG);
+
+    writeHeader(systusModel, subcase, out);
+
+    // Same values as writeNodes()
+    for (const auto& node : systusModel.model->mesh->nodes) {
+        const size_t position = static_cast<size_t>(node.position);
+        systus_ascid_t iangl = 0;
+        if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
+            iangl = subcase.localVectorIdByNodePosition[position];
+        }
+        hash.add(node.id).add(static_cast<int>(subcase.constraintByNodePosition[position]));
+        hash.add(static_cast<long long>(iangl)).add(subcase.loadingListIdByNodePosition[position]);
+        hash.add(subcase.constraintListIdByNodePosition[position]);
+        hash.add(node.x).add(node.y).add(node.z);
+    }
+
+    // The element lines are buffered by translateInvariants(): hashing them does not format them again
+    writeElements(systusModel, idSubcase, subcase, out);
+
+    // Same values as writeGroups(), whose part ids only depend on the group names
+    for (const auto& cellGroup : systusModel.model->mesh->getCellGroups()) {
+        if (subcase.usefulCellGroups.find(cellGroup) != subcase.usefulCellGroups.end()){
+            hash.add(cellGroup->getName()).add(cellGroup->getComment());
+            hash.add(static_cast<long long>(cellGroup->getCellIds().size()));
+            for (int cellId : cellGroup->getCellIds())
+                hash.add(cellId);
+        }
+    }
+    for (const auto& nodeGroup : systusModel.model->mesh->getNodeGroups()) {
+        hash.add(nodeGroup->getName()).add(nodeGroup->getComment());
+        const auto& nodeIds = nodeGroup->getNodeIds();
+        hash.add(static_cast<long long>(nodeIds.size()));
+        for (int id : nodeIds)
+            hash.add(id);
+    }
+
+    writeMaterials(systusModel, configuration, idSubcase, subcase, out);
+    writeLoads(subcase, out);
+    writeLists(subcase, out);
+    writeVectors(subcase, out);
+    writeTables(subcase, out);
+    writeMasses(systusModel, out);
+    out.flush();
+    return hash.getValue();
+}
+
+void SystusWriter::writeHeader(const SystusModel& systusModel, const SystusSubcase& subcase, ostream& out) {
     out << "1VSD 0 121126 133214 121126 133214 " << endl;
     out << systusModel.getName().substr(0, 20) << endl; //should be less than 24
     out << " 100000 " << systusOption << " " << systusModel.model->mesh->countNodes() << " ";
     out << systusModel.model->mesh->countCells() << " ";
-    int kppr = static_cast<int>(localLoadingListName.size()) ; // KPPR: Number of loads
+    int kppr = static_cast<int>(subcase.localLoadingListName.size()) ; // KPPR: Number of loads
     out << kppr << " ";
 
     out << nbDOFS << " " ;                     // KP: Number of degrees of freedom per node
@@ -2192,7 +2272,7 @@ void SystusWriter::writeHeader(const SystusModel& systusModel, ostream& out) {
 
 }
 
-void SystusWriter::writeInformations(const SystusModel &systusModel, int idSubcase , ostream& out) {
+void SystusWriter::writeInformations(const SystusModel &systusModel, int idSubcase, const SystusSubcase& subcase, ostream& out) {
     out << "BEGIN_INFORMATIONS" << endl;
 
     //Subcase
@@ -2231,12 +2311,12 @@ void SystusWriter::writeInformations(const SystusModel &systusModel, int idSubca
     // LCODES : Most of these are not really needed, as Systus recomputes them after.
     // Nonetheless, it's cleaner this way.
     int lcode[40]={0};
-    lcode[0] = static_cast<int>(localLoadingListName.size()); // KPPR: Number of loads
+    lcode[0] = static_cast<int>(subcase.localLoadingListName.size()); // KPPR: Number of loads
     lcode[1] = systusModel.model->mesh->countNodes();     // NMAX: Number of nodes
     lcode[3] = systusModel.model->mesh->countCells();     // MMAXI: Number of elements
     lcode[5] = 0;                                         // JMAT: Number of material couples, will be computed in "nbmaterials" in the writeMaterials method
-    lcode[6] = static_cast<int>(lists.size());            // JREP: Number of lists
-    lcode[7] = static_cast<int>(vectors.size());          // JVEC: Number of vectors.
+    lcode[6] = static_cast<int>(subcase.lists.size());            // JREP: Number of lists
+    lcode[7] = static_cast<int>(subcase.vectors.size() + invariants->coordinateSystemVectors.size()); // JVEC: Number of vectors.
     lcode[10]= nbDOFS;                                    // KP: Number of dof per node
     lcode[11]= nbDOFS;                                    // KPMAX: Maximum Number of dof per node
     lcode[12]= nbDOFS*nbDOFS;                             // KPM2 = KPMAX*KPMAX;
@@ -2253,41 +2333,35 @@ void SystusWriter::writeInformations(const SystusModel &systusModel, int idSubca
     out << "END_INFORMATIONS" << endl;
 }
 
-void SystusWriter::writeNodes(const SystusModel& systusModel, ostream& out) {
+void SystusWriter::writeNodes(const SystusModel& systusModel, const SystusSubcase& subcase, ostream& out) {
     const shared_ptr<Mesh> mesh = systusModel.model->mesh;
 
     out << "BEGIN_NODES ";
     out << mesh->countNodes();
     out << " 3" << endl; // number of coordinates
 
+    OutputBuffer buffer(out);
     for (const auto& node : mesh->nodes) {
         int nid = node.id;
-        int iconst = 0;
-        auto it = constraintByNodePosition.find(node.position);
-        if (it != constraintByNodePosition.end())
-            iconst = int(it->second);
+        const size_t position = static_cast<size_t>(node.position);
+        int iconst = int(subcase.constraintByNodePosition[position]);
         int imeca = 0;
         systus_ascid_t iangl = 0;
         if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
-            iangl = localVectorIdByNodePosition[node.position];
-        }
-        int isol = 0;
-        auto it2 = loadingListIdByNodePosition.find(node.position);
-        if (it2 != loadingListIdByNodePosition.end())
-            isol = it2->second;
-        int idisp = 0;
-        it2 = constraintListIdByNodePosition.find(node.position);
-        if (it2 != constraintListIdByNodePosition.end())
-            idisp = it2->second;
-        out << nid << " " << iconst << " " << imeca << " " << iangl << " " << isol << " " << idisp
-                << " ";
-        out << node.x << " " << node.y << " " << node.z << endl;
+            iangl = subcase.localVectorIdByNodePosition[position];
+        }
+        int isol = subcase.loadingListIdByNodePosition[position];
+        int idisp = subcase.constraintListIdByNodePosition[position];
+        buffer << nid << ' ' << iconst << ' ' << imeca << ' ' << iangl << ' ' << isol << ' ' << idisp
+                << ' ';
+        buffer << node.x << ' ' << node.y << ' ' << node.z << '\n';
 
         // Small warning against "infinite" node.
         if (node.x < -1.0e+300){
             handleWritingWarning("Infinite node with Id: " + std::to_string(nid),"Nodes");
         }
     }
+    buffer.flush();
 
     out << "END_NODES" << endl;
 }
@@ -2368,156 +2442,189 @@ void SystusWriter::writeElementLocalReferentiel(const SystusModel& systusModel,
 
 
 
-void SystusWriter::writeElements(const SystusModel& systusModel, const int idSubcase, ostream& out) {
-    shared_ptr<Mesh> mesh = systusModel.model->mesh;
-    out << "BEGIN_ELEMENTS " << mesh->countCells() << endl;
-    for (const auto& elementSet : systusModel.model->elementSets) {
+bool SystusWriter::writeElementSetCells(const SystusModel& systusModel, const shared_ptr<ElementSet> elementSet, ostream& out) {
 
-        shared_ptr<CellGroup> cellGroup = elementSet->cellGroup;
-        cellGroup->isUseful=false;
-        int dim = 0;
-        int typecell=0;
+    shared_ptr<CellGroup> cellGroup = elementSet->cellGroup;
+    int dim = 0;
+    int typecell=0;
 
 
-        switch (elementSet->type) {
-        case ElementSet::Type::CIRCULAR_SECTION_BEAM:
-        case ElementSet::Type::GENERIC_SECTION_BEAM:
-        case ElementSet::Type::I_SECTION_BEAM:
-        case ElementSet::Type::RECTANGULAR_SECTION_BEAM: {
-            dim = 1;
-            break;
-        }
-        case ElementSet::Type::STRUCTURAL_SEGMENT:{
-            typecell=6;
-            // We treat only Stiffness matrixes for now, with 1602 and 0601 Elements
-            shared_ptr<StructuralSegment> se = dynamic_pointer_cast<StructuralSegment>(elementSet);
-            if ((se->hasMass()) or (se->hasDamping())){
-                handleWritingWarning(to_str(*elementSet) + " mass and damping are not supported and will be dismissed.", "Elements");
-            }
-            break;
+    switch (elementSet->type) {
+    case ElementSet::Type::CIRCULAR_SECTION_BEAM:
+    case ElementSet::Type::GENERIC_SECTION_BEAM:
+    case ElementSet::Type::I_SECTION_BEAM:
+    case ElementSet::Type::RECTANGULAR_SECTION_BEAM: {
+        dim = 1;
+        break;
+    }
+    case ElementSet::Type::STRUCTURAL_SEGMENT:{
+        typecell=6;
+        // We treat only Stiffness matrixes for now, with 1602 and 0601 Elements
+        shared_ptr<StructuralSegment> se = dynamic_pointer_cast<StructuralSegment>(elementSet);
+        if ((se->hasMass()) or (se->hasDamping())){
+            handleWritingWarning(to_str(*elementSet) + " mass and damping are not supported and will be dismissed.", "Elements");
         }
+        break;
+    }
 
-        case ElementSet::Type::SCALAR_SPRING:{
-            dim = 1;
-            shared_ptr<ScalarSpring> ss = dynamic_pointer_cast<ScalarSpring>(elementSet);
-            const std::vector<std::pair<DOF, DOF>> dofsSpring = ss->getDOFSSpring();
-            if (dofsSpring.size()!=1){
-                handleWritingWarning(to_str(*elementSet) + " spring directions after the first one will be dismissed.", "Elements");
-            }
-            const std::pair<DOF,DOF> pairDOF = dofsSpring[0];
-            // If we have the same DOF, we can use a Spring element 1602.
-            // Else, we need to use a tabulated element 1902 Type 0
-            if (pairDOF.first == pairDOF.second){
-                typecell=6;
-            }else{
-                typecell=9;
-            }
-            break;
-        }
-        case ElementSet::Type::SHELL: {
-            dim = 2;
-            typecell=4;
-            break;
+    case ElementSet::Type::SCALAR_SPRING:{
+        dim = 1;
+        shared_ptr<ScalarSpring> ss = dynamic_pointer_cast<ScalarSpring>(elementSet);
+        const std::vector<std::pair<DOF, DOF>> dofsSpring = ss->getDOFSSpring();
+        if (dofsSpring.size()!=1){
+            handleWritingWarning(to_str(*elementSet) + " spring directions after the first one will be dismissed.", "Elements");
         }
-        case ElementSet::Type::CONTINUUM: {
-            dim = 3;
-            break;
-        }
-        case ElementSet::Type::NODAL_MASS:{
-            continue;
+        const std::pair<DOF,DOF> pairDOF = dofsSpring[0];
+        // If we have the same DOF, we can use a Spring element 1602.
+        // Else, we need to use a tabulated element 1902 Type 0
+        if (pairDOF.first == pairDOF.second){
+            typecell=6;
+        }else{
+            typecell=9;
         }
-        case ElementSet::Type::DISCRETE_0D:
-        case ElementSet::Type::DISCRETE_1D:{
+        break;
+    }
+    case ElementSet::Type::SHELL: {
+        dim = 2;
+        typecell=4;
+        break;
+    }
+    case ElementSet::Type::CONTINUUM: {
+        dim = 3;
+        break;
+    }
+    case ElementSet::Type::NODAL_MASS:{
+        return false;
+    }
+    case ElementSet::Type::DISCRETE_0D:
+    case ElementSet::Type::DISCRETE_1D:{
+        return false;
+    }
+    case ElementSet::Type::STIFFNESS_MATRIX:
+    case ElementSet::Type::MASS_MATRIX:
+    case ElementSet::Type::DAMPING_MATRIX:{
+        dim= 3;
+        typecell = 9;
+        break;
+    }
+    case ElementSet::Type::RBAR:
+    case ElementSet::Type::RBE3:{
+        dim = 1;
+        typecell = 9;
+        break;
+    }
+
+    case ElementSet::Type::LMPC:{
+        // 19XX elements, only written for the subcases of their analysis
+        dim = 1;
+        typecell = 9;
+        break;
+    }
+
+    default: {
+        //TODO : throw WriterException("ElementSet type not supported");
+        cout << "Warning in Elements: " << *elementSet << " not supported" << endl;
+        dim= 3;
+        typecell = 0;
+    }
+    }
+    OutputBuffer buffer(out);
+    for (const Cell& cell : cellGroup->getCells()) {
+        auto systus2med_it = systus2medNodeConnectByCellType.find(cell.type.code);
+        if (systus2med_it == systus2medNodeConnectByCellType.end()) {
+            cout << "Warning in Elements: " << cell << " not supported in Systus" << endl;
             continue;
         }
-        case ElementSet::Type::STIFFNESS_MATRIX:
-        case ElementSet::Type::MASS_MATRIX:
-        case ElementSet::Type::DAMPING_MATRIX:{
-            dim= 3;
-            typecell = 9;
-            break;
-        }
-        case ElementSet::Type::RBAR:
-        case ElementSet::Type::RBE3:{
-            dim = 1;
-            typecell = 9;
-            break;
-        }
 
-        case ElementSet::Type::LMPC:{
-            // If the LMPC is not relevant to the current subcase, we skip it
-            shared_ptr<Lmpc> lmpc = dynamic_pointer_cast<Lmpc>(elementSet);
-            vector<int> analysisOfSubcase =  systusSubcases[idSubcase];
-            if (std::find(analysisOfSubcase.begin(), analysisOfSubcase.end(), lmpc->analysisId) == analysisOfSubcase.end()){
-                continue;
-            }
-            // Else, it'a a 19XX element
-            dim = 1;
-            typecell = 9;
-            break;
-        }
+        // Putting all nodes in the Systus order
+        const vector<int>& systus2medNodeConnect = systus2med_it->second;
+        const vector<int>& medConnect = cell.nodeIds;
+        vector<int> systusConnect;
+        systusConnect.reserve(cell.type.numNodes);
+        for (unsigned int i = 0; i < cell.type.numNodes; i++)
+            systusConnect.push_back(medConnect[systus2medNodeConnect[i]]);
 
-        default: {
-            //TODO : throw WriterException("ElementSet type not supported");
-            cout << "Warning in Elements: " << *elementSet << " not supported" << endl;
-            dim= 3;
-            typecell = 0;
+        if (elementSet->type==ElementSet::Type::STRUCTURAL_SEGMENT){
+            dim = (cell.nodeIds.size()==2) ? 1 : 0 ;
         }
+
+        buffer << cell.id << ' ' << dim << typecell;              // Dimension and type of cell;
+        buffer.zeroPadded(static_cast<long long>(cell.nodeIds.size()), 2); // Number of nodes in two caracters: 01, 02, 05, 10, etc.
+
+        if (cell.nodeIds.size()>20){
+            cerr<< "Warning in Elements: " << cell << " has " << cell.nodeIds.size() << " but SYSTUS only support up to 20 nodes by element."<<endl;
         }
-        cellGroup->isUseful=true;
-        for (const Cell& cell : cellGroup->getCells()) {
-            auto systus2med_it = systus2medNodeConnectByCellType.find(cell.type.code);
-            if (systus2med_it == systus2medNodeConnectByCellType.end()) {
-                cout << "Warning in Elements: " << cell << " not supported in Systus" << endl;
-                continue;
-            }
 
-            // Putting all nodes in the Systus order
-            vector<int> systus2medNodeConnect = systus2med_it->second;
-            vector<int> medConnect = cell.nodeIds;
-            vector<int> systusConnect;
-            for (unsigned int i = 0; i < cell.type.numNodes; i++)
-                systusConnect.push_back(medConnect[systus2medNodeConnect[i]]);
+        //TODO: We should write here the Material Id: we use the elementSet id which SHOULD be the same
+        buffer << ' ' << elementSet->getId(); // Material Id (it's an ugly fix)
+        buffer << " 0"; // Loading List:  index that describes solicitation list (not supported yet)
 
-            if (elementSet->type==ElementSet::Type::STRUCTURAL_SEGMENT){
-                dim = (cell.nodeIds.size()==2) ? 1 : 0 ;
-            }
+        // Local Orientation
+        if (cell.hasOrientation){
+            buffer.flush();
+            writeElementLocalReferentiel(systusModel, dim, typecell, systusConnect, cell.cid, out);
+        }else{
+            buffer << " 0";
+        }
 
-            out << cell.id << " " << dim << typecell;              // Dimension and type of cell;
-            out << setfill('0') << setw(2) << cell.nodeIds.size(); // Number of nodes in two caracters: 01, 02, 05, 10, etc.
+        // Writing Nodes
+        for (int node : systusConnect) {
+            buffer << ' ' << node;
+        }
+        buffer << '\n';
+    }
+    buffer.flush();
+    return true;
+}
 
-            if (cell.nodeIds.size()>20){
-                cerr<< "Warning in Elements: " << cell << " has " << cell.nodeIds.size() << " but SYSTUS only support up to 20 nodes by element."<<endl;
-            }
+void SystusWriter::fillElements(const SystusModel& systusModel, SystusInvariants& invariants) {
+    for (const auto& elementSet : systusModel.model->elementSets) {
+        ostringstream out;
+        out.precision(DBL_DIG);
+        if (writeElementSetCells(systusModel, elementSet, out)) {
+            invariants.elementsByElementSet[elementSet->getId()] = out.str();
+        }
+    }
+    invariants.elementsBuffered = true;
+}
 
-            //TODO: We should write here the Material Id: we use the elementSet id which SHOULD be the same
-            out << " " << elementSet->getId(); // Material Id (it's an ugly fix)
-            out << " 0"; // Loading List:  index that describes solicitation list (not supported yet)
+void SystusWriter::writeElements(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase, ostream& out) {
+    shared_ptr<Mesh> mesh = systusModel.model->mesh;
+    out << "BEGIN_ELEMENTS " << mesh->countCells() << endl;
+    const vector<int>& analysisOfSubcase = systusSubcases[idSubcase];
+    for (const auto& elementSet : systusModel.model->elementSets) {
 
-            // Local Orientation
-            if (cell.hasOrientation){
-                writeElementLocalReferentiel(systusModel, dim, typecell, systusConnect, cell.cid, out);
-            }else{
-                out << " 0";
-            }
+        shared_ptr<CellGroup> cellGroup = elementSet->cellGroup;
+        subcase.usefulCellGroups.erase(cellGroup);
+        const auto it = invariants->elementsByElementSet.find(elementSet->getId());
+        if (invariants->elementsBuffered && it == invariants->elementsByElementSet.end()){
+            continue;
+        }
 
-            // Writing Nodes
-            for (int node : systusConnect) {
-                out << " " << node;
+        // If the LMPC is not relevant to the current subcase, we skip it
+        if (elementSet->type == ElementSet::Type::LMPC){
+            shared_ptr<Lmpc> lmpc = dynamic_pointer_cast<Lmpc>(elementSet);
+            if (std::find(analysisOfSubcase.begin(), analysisOfSubcase.end(), lmpc->analysisId) == analysisOfSubcase.end()){
+                continue;
             }
-            out << endl;
         }
+        if (invariants->elementsBuffered){
+            out << it->second;
+        }else if (!writeElementSetCells(systusModel, elementSet, out)){
+            continue;
+        }
+        subcase.usefulCellGroups.insert(cellGroup);
     }
 
     out << "END_ELEMENTS" << endl;
 }
 
 // TODO: Add an option to only write the User groups, and not all vega-created groups.
-void SystusWriter::writeGroups(const SystusModel& systusModel, ostream& out) {
+void SystusWriter::writeGroups(const SystusModel& systusModel, SystusSubcase& subcase, ostream& out) {
     vector<shared_ptr<NodeGroup>> nodeGroups = systusModel.model->mesh->getNodeGroups();
     vector<shared_ptr<CellGroup>> cellGroups = systusModel.model->mesh->getCellGroups();
 
-    ostringstream osgr;
+    OutputBuffer osgr;
     int nbGroups=0;
 
     /* Write useful CellGroups, those corresponding to real cells and to this analysis
@@ -2527,26 +2634,26 @@ void SystusWriter::writeGroups(const SystusModel& systusModel, ostream& out) {
      */
     set<int> pids= {};
     for (const auto& cellGroup : cellGroups) {
-        if (cellGroup->isUseful){
+        if (subcase.usefulCellGroups.find(cellGroup) != subcase.usefulCellGroups.end()){
             nbGroups++;
-            osgr << nbGroups << " " << cellGroup->getName() << " 2 0 ";
-            osgr << "\"PART_ID "<< getPartId(cellGroup->getName(), pids) << "\"  \"\"  ";
-            osgr << "\"PART built in VEGA from "<< cellGroup->getComment() << "\"";
-            for (const auto& cell : cellGroup->getCells())
-                osgr << " " << cell.id;
-            osgr << endl;
+            osgr << nbGroups << ' ' << cellGroup->getName() << " 2 0 ";
+            osgr << "\"PART_ID " << getPartId(cellGroup->getName(), pids, subcase) << "\"  \"\"  ";
+            osgr << "\"PART built in VEGA from " << cellGroup->getComment() << '"';
+            for (int cellId : cellGroup->getCellIds())
+                osgr << ' ' << cellId;
+            osgr << '\n';
         }
     }
 
     // Write NodeGroups
     for (const auto& nodeGroup : nodeGroups) {
         nbGroups++;
-        osgr << nbGroups << " " << nodeGroup->getName() << " 1 0 ";
+        osgr << nbGroups << ' ' << nodeGroup->getName() << " 1 0 ";
         osgr << "\"No method\"  \"\"  ";
-        osgr << "\"Group built in VEGA from "<< nodeGroup->getComment() << "\"";
+        osgr << "\"Group built in VEGA from " << nodeGroup->getComment() << '"';
         for (int id : nodeGroup->getNodeIds())
-            osgr << " " << id;
-        osgr << endl;
+            osgr << ' ' << id;
+        osgr << '\n';
     }
 
     // Stream to output
@@ -2558,7 +2665,7 @@ void SystusWriter::writeGroups(const SystusModel& systusModel, ostream& out) {
 
 void SystusWriter::writeMaterials(const SystusModel& systusModel,
         const vega::ConfigurationParameters &configuration,
-        const int idSubcase, ostream& out) {
+        const int idSubcase, const SystusSubcase& subcase, ostream& out) {
 
     ostringstream ogmat;
     ogmat.precision(DBL_DIG);
@@ -2663,7 +2770,8 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
                                 writeMaterialField(SMF::E, rigidNature.getLagrangian(), nbElementsMaterial, omat);
                             }else{
                                 writeMaterialField(SMF::SHAPE, 9, nbElementsMaterial, omat);
-                                writeMaterialField(SMF::E, rigidNature.getRigidity(), nbElementsMaterial, omat);
+                                const auto rigidityIt = rigidityByElementSet.find(elementSet->getId());
+                                writeMaterialField(SMF::E, rigidityIt != rigidityByElementSet.end() ? rigidityIt->second : rigidNature.getRigidity(), nbElementsMaterial, omat);
                             }
                             break;
                         }
@@ -2687,8 +2795,8 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
                             if (std::find(analysisOfSubcase.begin(), analysisOfSubcase.end(), lmpc->analysisId) == analysisOfSubcase.end()){
                                 continue;
                             }
-                            auto it = tableByElementSet.find(elementSet->getId());
-                            if (it == tableByElementSet.end()){
+                            auto it = subcase.tableByElementSet.find(elementSet->getId());
+                            if (it == subcase.tableByElementSet.end()){
                                 handleWritingWarning(to_str(*elementSet) + " has no table.", "Rigid Material");
                                 break;
                             }
@@ -2698,7 +2806,8 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
                                 writeMaterialField(SMF::E, rigidNature.getLagrangian(), nbElementsMaterial, omat);
                             }else{
                                 writeMaterialField(SMF::SHAPE, 9, nbElementsMaterial, omat);
-                                writeMaterialField(SMF::E, rigidNature.getRigidity(), nbElementsMaterial, omat);
+                                const auto rigidityIt = rigidityByElementSet.find(elementSet->getId());
+                                writeMaterialField(SMF::E, rigidityIt != rigidityByElementSet.end() ? rigidityIt->second : rigidNature.getRigidity(), nbElementsMaterial, omat);
                             }
                             writeMaterialField(SMF::LEVEL, 0, nbElementsMaterial, omat);
                             break;
@@ -2757,15 +2866,15 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
                             handleWritingWarning(to_str(*elementSet)+" damping is not supported.","Material");
                         }
                     }else{
-                        auto it = tableByElementSet.find(elementSet->getId());
-                        if (it == tableByElementSet.end()){
+                        auto it = invariants->tableByElementSet.find(elementSet->getId());
+                        if (it == invariants->tableByElementSet.end()){
                             handleWritingWarning(to_str(*elementSet) + " has no table.", "Material");
                             break;
                         }
                         writeMaterialField(SMF::TABLE, int(it->second), nbElementsMaterial, omat);
                         if (systusModel.configuration.systusOutputMatrix=="file"){
-                            auto it2 = seIdByElementSet.find(elementSet->getId());
-                            if (it2 == seIdByElementSet.end()){
+                            auto it2 = invariants->seIdByElementSet.find(elementSet->getId());
+                            if (it2 == invariants->seIdByElementSet.end()){
                                 handleWritingWarning(to_str(*elementSet) + " has no reduction number.", "Material");
                                 break;
                             }
@@ -2779,15 +2888,15 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
                 case ElementSet::Type::STIFFNESS_MATRIX:
                 case ElementSet::Type::MASS_MATRIX:
                 case ElementSet::Type::DAMPING_MATRIX:{
-                    auto it = tableByElementSet.find(elementSet->getId());
-                    if (it == tableByElementSet.end()){
+                    auto it = invariants->tableByElementSet.find(elementSet->getId());
+                    if (it == invariants->tableByElementSet.end()){
                         handleWritingWarning(to_str(*elementSet)+" has no table.","Material");
                         break;
                     }
                     writeMaterialField(SMF::TABLE, int(it->second), nbElementsMaterial, omat);
                     if (systusModel.configuration.systusOutputMatrix=="file"){
-                        auto it2 = seIdByElementSet.find(elementSet->getId());
-                        if (it2 == seIdByElementSet.end()){
+                        auto it2 = invariants->seIdByElementSet.find(elementSet->getId());
+                        if (it2 == invariants->seIdByElementSet.end()){
                             handleWritingWarning(to_str(*elementSet)+" has no reduction number.","Material");
                             break;
                         }
@@ -2824,27 +2933,27 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
     out << "END_MATERIALS" << endl;
 }
 
-void SystusWriter::writeLoads(ostream& out) {
+void SystusWriter::writeLoads(SystusSubcase& subcase, ostream& out) {
     out << "BEGIN_LOADS ";
     // Number of written loads
-    out << localLoadingListName.size() << endl;
+    out << subcase.localLoadingListName.size() << endl;
     // Writing Loads
-    for (const auto& load : localLoadingListName) {
+    for (const auto& load : subcase.localLoadingListName) {
         out << load.first << " \""<<load.second<< "\"";
         out << " 0 ";
-        out << loadingVectorIdByLocalLoading[load.first];
+        out << subcase.loadingVectorIdByLocalLoading[load.first];
         out << " 0 0 0 0 0 7" << endl;
     }
     out << "END_LOADS" << endl;
 
 }
 
-void SystusWriter::writeLists(ostream& out) {
+void SystusWriter::writeLists(const SystusSubcase& subcase, ostream& out) {
 
     ostringstream olist;
     olist.precision(DBL_DIG);
     systus_ascid_t nbElements=0;
-    for (const auto& list : lists) {
+    for (const auto& list : subcase.lists) {
         olist << list.first;
         for (const auto d : list.second)
             olist << " " << d;
@@ -2853,51 +2962,56 @@ void SystusWriter::writeLists(ostream& out) {
     }
 
     out << "BEGIN_LISTS ";
-    out << lists.size() << " " << nbElements << endl;
+    out << subcase.lists.size() << " " << nbElements << endl;
     out << olist.str();
     out << "END_LISTS" << endl;
 }
 
-void SystusWriter::writeVectors(ostream& out) {
-    out << "BEGIN_VECTORS " << vectors.size() << endl;
-    for (const auto& vector : vectors) {
+void SystusWriter::writeVectors(const SystusSubcase& subcase, ostream& out) {
+    out << "BEGIN_VECTORS " << subcase.vectors.size() + invariants->coordinateSystemVectors.size() << endl;
+    for (const auto& vector : subcase.vectors) {
         out << vector.first;
         for (const auto& d : vector.second)
             out << " " << d;
         out << endl;
     }
+    systus_ascid_t vectorId = subcase.vectors.size()+1;
+    for (const auto& vector : invariants->coordinateSystemVectors) {
+        out << vectorId++;
+        for (const auto& d : vector)
+            out << " " << d;
+        out << endl;
+    }
     out << "END_VECTORS" << endl;
 }
 
 void SystusWriter::writeMasses(const SystusModel &systusModel, ostream& out) {
     // TODO : attention, la doc parle de dynamique. Prise en compte dans le poids en statique ???
-    vector<shared_ptr<ElementSet>> masses = systusModel.model->elementSets.filter(
-            ElementSet::Type::NODAL_MASS);
+    const auto& masses = systusModel.model->elementSets.filter<ElementSet::Type::NODAL_MASS>();
     out << "BEGIN_MASSES " << masses.size() << endl;
     if (masses.size() > 0) {
-        for (const auto& mass : masses) {
-            if (mass->cellGroup != nullptr) {
-                shared_ptr<NodalMass> nodalMass = dynamic_pointer_cast<NodalMass>(mass);
+        for (const NodalMass& nodalMass : masses) {
+            if (nodalMass.cellGroup != nullptr) {
                 //  VALUES NBR VAL(NBR) NODEi
                 //  NBR:            Number of values [INTEGER]
                 //  VAL(NBR):   Masses values [DOUBLE[NBR]]
                 //  NODEi:      List of NODES index [INTEGER[*]]
-                if (!is_zero(nodalMass->ixy) || !is_zero(nodalMass->iyz) || !is_zero(nodalMass->ixz)){
+                if (!is_zero(nodalMass.ixy) || !is_zero(nodalMass.iyz) || !is_zero(nodalMass.ixz)){
                     handleWritingError(
                             string("Asymetric masses are not (yet) implemented."));
                 }
-                if (!is_zero(nodalMass->ex) || !is_zero(nodalMass->ey) || !is_zero(nodalMass->ez)){
+                if (!is_zero(nodalMass.ex) || !is_zero(nodalMass.ey) || !is_zero(nodalMass.ez)){
                     handleWritingWarning("Offset not implemented and dismissed.");
                 }
-                if (!is_zero(nodalMass->ixx) || !is_zero(nodalMass->iyy) || !is_zero(nodalMass->izz)){
-                    out << "VALUES 6 " << nodalMass->getMass() << " " << nodalMass->getMass() << " "
-                            << nodalMass->getMass() << " " << nodalMass->ixx << " " << nodalMass->iyy
-                            << " " << nodalMass->izz;
+                if (!is_zero(nodalMass.ixx) || !is_zero(nodalMass.iyy) || !is_zero(nodalMass.izz)){
+                    out << "VALUES 6 " << nodalMass.getMass() << " " << nodalMass.getMass() << " "
+                            << nodalMass.getMass() << " " << nodalMass.ixx << " " << nodalMass.iyy
+                            << " " << nodalMass.izz;
                 }else{
-                    out << "VALUES 3 " << nodalMass->getMass() << " " << nodalMass->getMass() << " "
-                            << nodalMass->getMass();
+                    out << "VALUES 3 " << nodalMass.getMass() << " " << nodalMass.getMass() << " "
+                            << nodalMass.getMass();
                 }
-                for (const auto& cell : mass->cellGroup->getCells()) {
+                for (const auto& cell : nodalMass.cellGroup->getCells()) {
                     // NODEi
                     out << " " << cell.nodeIds[0];
                 }
@@ -2909,10 +3023,13 @@ void SystusWriter::writeMasses(const SystusModel &systusModel, ostream& out) {
 }
 
 
-void SystusWriter::writeTables(std::ostream& out){
+void SystusWriter::writeTables(const SystusSubcase& subcase, std::ostream& out){
 
-    out << "BEGIN_TABLES " << tables.size()<<endl;
-    for (const auto& table : tables){
+    out << "BEGIN_TABLES " << invariants->tables.size() + subcase.tables.size()<<endl;
+    for (const auto& table : invariants->tables){
+        out << table;
+    }
+    for (const auto& table : subcase.tables){
         out << table;
     }
     out << "END_TABLES" << endl;
@@ -2921,7 +3038,7 @@ void SystusWriter::writeTables(std::ostream& out){
 
 
 void SystusWriter::writeDat(const SystusModel& systusModel, const vega::ConfigurationParameters &configuration,
-        const int idSubcase, ostream& out) {
+        const int idSubcase, SystusSubcase& subcase, ostream& out) {
 
     // For TOPAZE, we comment a few lines.
     string comment="";
@@ -2949,8 +3066,11 @@ void SystusWriter::writeDat(const SystusModel& systusModel, const vega::Configur
                 out << "# ACCESS TO ELEMENTARY MATRIX FILES" << endl;
                 isFirst=false;
             }
-            out <<  "!filematrix ASC2BIN "<< it.second <<".ASC "<< it.second <<".TIT"<<endl;
-            out << "ASSIGN "<< it.first << " "<< it.second <<".TIT BINARY"<<endl;
+            // The ASC file is shared by all subcases, but each one converts it to its own binary
+            // file: subcases may be run concurrently.
+            const string binaryFile = it.second + "_SC" + to_string(idSubcase+1) + ".TIT";
+            out <<  "!filematrix ASC2BIN "<< it.second <<".ASC "<< binaryFile <<endl;
+            out << "ASSIGN "<< it.first << " "<< binaryFile <<" BINARY"<<endl;
         }
         if (!isFirst){
             out << endl;
@@ -3229,7 +3349,7 @@ void SystusWriter::writeDat(const SystusModel& systusModel, const vega::Configur
 
 
             // Participation part
-            int nbLoadcases=static_cast<int>(localLoadingListName.size());
+            int nbLoadcases=static_cast<int>(subcase.localLoadingListName.size());
             if (nbLoadcases!=1){
                 handleWritingWarning("Dynamic modal analysis only work with one loadcase.", "Analysis file");
                 nbLoadcases=1;
@@ -3250,9 +3370,9 @@ void SystusWriter::writeDat(const SystusModel& systusModel, const vega::Configur
             out << "# IF THERE IS NNN RIGID BODY MODES, ADD 'RIGID NNN' TO THE NEXT LINE."<<endl;
             out << "HARMONIC RESPONSE MODAL "<< nModes<< " FORCE "<< nbLoadcases <<endl;
             out << "DAMPING "<< oDamping.str() << endl;
-            if (tableByLoadcase.size()>0){
-                out <<"FUNCTION "<< tableByLoadcase[1] <<endl;
-                cout <<"FUNCTION "<< tableByLoadcase[0] <<endl;
+            if (subcase.tableByLoadcase.size()>0){
+                out <<"FUNCTION "<< subcase.tableByLoadcase[1] <<endl;
+                cout <<"FUNCTION "<< subcase.tableByLoadcase[0] <<endl;
             }
             out << "FREQUENCY " << oFrequency.str() << endl;
             out << "TRANSFER STATIONARY" << endl;
@@ -3428,54 +3548,54 @@ void SystusWriter::writeFrequencyAssertion(Assertion& assertion, ostream& out) {
 
 
 
-void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int idSubcase){
+void SystusWriter::writeMatrixFiles(const SystusModel& systusModel){
 
     /* Writing Damping Matrices */
-    if (dampingMatrices.size()>0){
+    if (invariants->dampingMatrices.size()>0){
         ofstream ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
-        string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_DAMGEN.ASC");
+        string matrixFile = systusModel.getOutputFileName("_DAMGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
 
         if (!ofsMatrixFile.is_open()) {
             string message = string("Can't open file ") + matrixFile + " for writing.";
             throw ios::failure(message);
         }
-        ofsMatrixFile << dampingMatrices<<endl;
+        ofsMatrixFile << invariants->dampingMatrices<<endl;
         ofsMatrixFile.close();
-        filebyAccessId[SystusWriter::DampingAccessId]= systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_DAMGEN";
+        filebyAccessId[SystusWriter::DampingAccessId]= systusModel.getName()+"_DAMGEN";
     }
 
     /* Writing Mass Matrices */
-    if (massMatrices.size()>0){
+    if (invariants->massMatrices.size()>0){
         ofstream ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
-        string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_MASGEN.ASC");
+        string matrixFile = systusModel.getOutputFileName("_MASGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
 
         if (!ofsMatrixFile.is_open()) {
             string message = string("Can't open file ") + matrixFile + " for writing.";
             throw ios::failure(message);
         }
-        ofsMatrixFile << massMatrices << endl;
+        ofsMatrixFile << invariants->massMatrices << endl;
         ofsMatrixFile.close();
-        filebyAccessId[SystusWriter::MassAccessId]= systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_MASGEN";
+        filebyAccessId[SystusWriter::MassAccessId]= systusModel.getName()+"_MASGEN";
     }
 
     /* Writing Stiffness Matrices */
-    if (stiffnessMatrices.size()>0){
+    if (invariants->stiffnessMatrices.size()>0){
         ofstream ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
-        string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_STIGEN.ASC");
+        string matrixFile = systusModel.getOutputFileName("_STIGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
 
         if (!ofsMatrixFile.is_open()) {
             string message = string("Can't open file ") + matrixFile + " for writing.";
             throw ios::failure(message);
         }
-        ofsMatrixFile << stiffnessMatrices <<endl;
+        ofsMatrixFile << invariants->stiffnessMatrices <<endl;
         ofsMatrixFile.close();
-        filebyAccessId[SystusWriter::StiffnessAccessId]=systusModel.getName()+"_SC" + to_string(idSubcase+1) + "_STIGEN";
+        filebyAccessId[SystusWriter::StiffnessAccessId]=systusModel.getName()+"_STIGEN";
     }
 }
 
@@ -16,11 +16,14 @@
 #include <memory>
 #include <string>
 #include <fstream>
+#include <mutex>
 #include <boost/filesystem.hpp>
 #include <boost/assign.hpp>
 #include "../Abstract/Model.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "../Abstract/OutputBuffer.h"
+#include "../Abstract/OutputManifest.h"
 #include "../Abstract/CoordinateSystem.h"
 #include "SystusModel.h"
 #include "SystusAsc.h"
@@ -87,6 +90,46 @@ SMF DOFtoSMF(DOF dof);
 
 static const int defaultNbDesiredRoots=100; /**< Default number of desired roots for a static analysis (chosen from experiment)**/
 
+/**
+ * Translation of the model shared by all the subcases: filled once by translateInvariants(),
+ * then only read by the subcases.
+ */
+struct SystusInvariants final {
+    SystusMatrices dampingMatrices;         /**< All needed damping matrices (element X9XX type 0). **/
+    SystusMatrices massMatrices;            /**< All needed mass matrices (element X9XX type 0). **/
+    SystusMatrices stiffnessMatrices;       /**< All needed rigidity matrices (element X9XX type 0). **/
+    std::map<int, systus_ascid_t> seIdByElementSet; /**< Number of the matrix associated to SE (element X9XX type 0). **/
+    std::vector<SystusTable> tables;        /**< Tables of the element sets, numbered before the tables of each subcase. **/
+    std::map<int, systus_ascid_t> tableByElementSet;
+    std::vector<std::vector<double>> coordinateSystemVectors;   /**< Vectors of the node coordinate systems, numbered after the vectors of each subcase. **/
+    std::vector<std::pair<int, size_t>> coordinateSystemVectorByNodePosition; /**< <nodePosition, index in coordinateSystemVectors> **/
+    bool elementsBuffered = false;          /**< With a single subcase, the elements are streamed to its file instead. **/
+    std::map<int, std::string> elementsByElementSet; /**< ASC lines of the cells of each element set, if buffered. **/
+};
+
+/**
+ * Translation of one subcase: its loads, constraints, vectors, lists and tables.
+ * Each subcase owns one, so that subcases can be translated concurrently.
+ */
+struct SystusSubcase final {
+    int auto_part_id = 99999999;             /**< Next available number for Systus Part ID **/
+    std::map<int, std::vector<systus_ascid_t> > lists;
+    std::map<systus_ascid_t, std::vector<double>> vectors;
+    std::map<int, std::map<int, int>> localLoadingIdByLoadsetIdByAnalysisId;
+    std::map<int, systus_ascid_t> loadingVectorIdByLocalLoading;
+    NodePositionMap<std::map<int, std::vector<systus_ascid_t>>> loadingVectorsIdByLocalLoadingByNodePosition;
+    NodePositionMap<std::map<int, std::vector<systus_ascid_t>>> constraintVectorsIdByLocalLoadingByNodePosition;
+    std::vector<systus_ascid_t> localVectorIdByNodePosition;  /**< vectorId by nodePosition for all Coordinate Systems Vectors, 0 if none. **/
+    std::vector<int> loadingListIdByNodePosition;             /**< 0 if none **/
+    std::map<int, std::string> localLoadingListName;
+    std::vector<int> constraintListIdByNodePosition;          /**< 0 if none **/
+    std::vector<char> constraintByNodePosition;
+    std::vector<SystusTable> tables;                          /**< Tables of the subcase, numbered after SystusInvariants::tables **/
+    std::map<int, systus_ascid_t> tableByElementSet;          /**< Tables of the LMPC of the subcase **/
+    std::map<int, systus_ascid_t> tableByLoadcase;
+    std::set<std::shared_ptr<CellGroup>> usefulCellGroups;    /**< Cell groups of the element sets written in the subcase. **/
+};
+
 class SystusWriter final: public Writer {
 
 private:
@@ -96,32 +139,17 @@ private:
     DOFS availableDOFS;
     int  nbDOFS;
     double maxYoungModulus = Globals::UNAVAILABLE_DOUBLE;
-    static int auto_part_id;                 /**< Next available number for Systus Part ID **/
     static const int DampingAccessId;        /**< Access Id for the Damping Matrices file (Element X9XX type 0)**/
     static const int MassAccessId;           /**< Access Id for the Mass Matrices file (Element X9XX type 0)**/
     static const int StiffnessAccessId;      /**< Access Id for the Stiffness Matrices file (Element X9XX type 0)**/
 
-    std::map<int, std::vector<systus_ascid_t> > lists;
-    std::map<systus_ascid_t, std::vector<double>> vectors;
     std::map<int, int> rotationNodeIdByTranslationNodeId; /**< nodeId, nodeId > :  map between the reference node and the reference rotation for 190X elements in 3D mode.**/
-    std::map<int, std::map<int, int>> localLoadingIdByLoadsetIdByAnalysisId;
-    std::map<int, systus_ascid_t> loadingVectorIdByLocalLoading;
-    std::map<int, std::map<int, std::vector<systus_ascid_t>>> loadingVectorsIdByLocalLoadingByNodePosition;
-    std::map<int, std::map<int, std::vector<systus_ascid_t>>> constraintVectorsIdByLocalLoadingByNodePosition;
-    std::map<int, systus_ascid_t> localVectorIdByNodePosition;  /**< nodePosition, vectorId> for all Coordinate Systems Vectors. **/
-    std::map<int, int> loadingListIdByNodePosition;
-    std::map<int, std::string> localLoadingListName;
-    std::map<int, int> constraintListIdByNodePosition;
-    std::map<int, char> constraintByNodePosition;
     std::vector< std::vector<int> > systusSubcases;   /**< Ids of loadcases composing the subcase **/
-    std::vector<SystusTable> tables;
-    SystusMatrices dampingMatrices;         /**< All needed damping matrices (element X9XX type 0). **/
-    SystusMatrices massMatrices ;           /**< All needed mass matrices (element X9XX type 0). **/
-    SystusMatrices stiffnessMatrices;       /**< All needed rigidity matrices (element X9XX type 0). **/
-    std::map<int, systus_ascid_t> tableByElementSet;
-    std::map<int, systus_ascid_t> tableByLoadcase;
-    std::map<int, systus_ascid_t> seIdByElementSet; /**< Number of the matrix associated to SE (element X9XX type 0). **/
+    std::map<int, double> rigidityByElementSet;     /**< Rigidity of RBAR and LMPC element sets, which may share their rigid material. **/
     std::map<int, std::string > filebyAccessId;        /**< Names of matrix files **/
+    std::shared_ptr<const SystusInvariants> invariants; /**< Translation shared by all subcases, see translateInvariants() **/
+    std::unique_ptr<OutputManifest> manifest;           /**< Hashes of the ASC files, in incremental mode only **/
+    std::mutex manifestMutex;                           /**< The subcases read and update the manifest concurrently **/
     /**
      * Renumbers the nodes
      * see Systus ref manual chapter 15 or chapter 13 2.7
@@ -293,9 +321,21 @@ private:
 
     /** Find an available Part Id for a Cell Group.
      * If possible, try to use the suffix (_NN) of the Group Name. **/
-    int getPartId(const std::string partName, std::set<int> & usedPartId);
+    int getPartId(const std::string partName, std::set<int> & usedPartId, SystusSubcase& subcase);
     static const std::unordered_map<CellType::Code, std::vector<int>, EnumClassHash> systus2medNodeConnectByCellType;
-    void writeAsc(const SystusModel&, const ConfigurationParameters&, const int idSubcase, std::ostream&);
+    void writeAsc(const SystusModel&, const ConfigurationParameters&, const int idSubcase, SystusSubcase&, std::ostream&);
+    /**
+     * Hash of the data writeAsc() writes, computed without formatting the nodes: the buffered element
+     * lines of the invariants, the groups, the tables and the other sections of the subcase.
+     * The date of the INFORMATIONS section is left out.
+     */
+    uint64_t hashAsc(const SystusModel&, const ConfigurationParameters&, const int idSubcase, SystusSubcase&);
+    /**
+     * Translate the subcase, then write its ASC and DAT files. In incremental mode, the ASC file is
+     * only written if the hash of its data changed.
+     * The subcase state is local and the invariant translation is only read: subcases can run concurrently.
+     */
+    void writeSubcase(const SystusModel&, const ConfigurationParameters&, const int idSubcase);
     void getSystusInformations(const SystusModel&, const ConfigurationParameters&);
 
     /**
@@ -304,25 +344,38 @@ private:
     void getSystusAutomaticOption(const SystusModel&, SystusOption & autoSystusOption, SystusSubOption & autoSystusSubOption);
 
     /**
-     * Clear all maps, vectors, lists filled during a previous translation.
+     * Clear the invariant translation and the matrix files of a previous writing.
      */
     void clear();
 
     /**
-     * Translate the model into a Systus compatible format.
-     * It fills all needed tables, vectors, lists, and so on.
+     * Translate the parts of the model which are the same for all subcases: matrices,
+     * element set tables, coordinate system vectors and, if there are several subcases or in
+     * incremental mode, elements.
      */
-    void translate(const SystusModel &systusModel, const int idSubcase);
-
-    void fillLoads(const SystusModel&, const int idSubcase);
-    void fillConstraintsNodes(const SystusModel& systusModel, const int idLoadcase);
-    void fillConstraintsVectors(const SystusModel& systusModel, const int idSubcase);
-    void fillCoordinatesVectors(const SystusModel& systusModel, const int idSubcase);
-    void fillLoadingsVectors(const SystusModel& systusModel, const int idSubcase);
-    void fillMatrices(const SystusModel& systusModel, const int idSubcase);
-    void fillTables(const SystusModel&, const int idSubcase);
-    void fillVectors(const SystusModel&, const int idSubcase);
-    void fillLists(const SystusModel&, const int idSubcase);
+    void translateInvariants(const SystusModel &systusModel);
+
+    /**
+     * Translate the subcase into a Systus compatible format, after translateInvariants().
+     * It fills the tables, vectors, lists, and so on, of its loads and constraints.
+     */
+    void translate(const SystusModel &systusModel, const int idSubcase, SystusSubcase& subcase);
+
+    void fillLoads(const SystusModel&, const int idSubcase, SystusSubcase&);
+    void fillConstraintsNodes(const SystusModel& systusModel, const int idLoadcase, SystusSubcase& subcase);
+    void fillConstraintsVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase);
+    void fillCoordinateSystemVectors(const SystusModel& systusModel, SystusInvariants& invariants);
+    void fillCoordinatesVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase);
+    /**
+     * Write the ASC lines of the cells of each element set, once for all subcases.
+     */
+    void fillElements(const SystusModel& systusModel, SystusInvariants& invariants);
+    void fillElementSetTables(const SystusModel&, SystusInvariants&);
+    void fillLoadingsVectors(const SystusModel& systusModel, const int idSubcase, SystusSubcase& subcase);
+    void fillMatrices(const SystusModel& systusModel, SystusInvariants& invariants);
+    void fillTables(const SystusModel&, const int idSubcase, SystusSubcase&);
+    void fillVectors(const SystusModel&, const int idSubcase, SystusSubcase&);
+    void fillLists(const SystusModel&, const int idSubcase, SystusSubcase&);
 
     /**
      *  Generate a rigidity for a a Rbar Element Set. The formulation we use is
@@ -346,19 +399,19 @@ private:
      *  Default result is "each analysis on its own subcase".
      */
     void generateSubcases(const SystusModel&, const ConfigurationParameters&);
-    void writeHeader(const SystusModel&, std::ostream&);
+    void writeHeader(const SystusModel&, const SystusSubcase&, std::ostream&);
 
     /**
      *  Write the informations field of the ASC file, including the long title
      *  and the codes of the model (See NCODE(20) in Systus code for more details).
      **/
-    void writeInformations(const SystusModel&, const int idSubcase, std::ostream&);
+    void writeInformations(const SystusModel&, const int idSubcase, const SystusSubcase&, std::ostream&);
 
     /**
      * Write the Nodes in ASC format.
      * If possible, nodes numbers copy the numbers of the input model.
      **/
-    void writeNodes(const SystusModel&, std::ostream&);
+    void writeNodes(const SystusModel&, const SystusSubcase&, std::ostream&);
 
     /**
      *  Compute the default referentiel for an element, as described in the
@@ -372,7 +425,12 @@ private:
      *  Depending of the type of element, some angles may be dismissed.
      **/
     void writeElementLocalReferentiel(const SystusModel& systusModel, const int dim, const int celltype, const std::vector<int> nodes, const int cpos, std::ostream& out);
-    void writeElements(const SystusModel&, const int idSubcase, std::ostream&);
+    /**
+     * Write the ASC lines of the cells of an element set.
+     * Return false if the element set has no cells in Systus.
+     */
+    bool writeElementSetCells(const SystusModel&, const std::shared_ptr<ElementSet>, std::ostream&);
+    void writeElements(const SystusModel&, const int idSubcase, SystusSubcase&, std::ostream&);
     /**
      * Write the Cells and Nodes groups in ASC format.
      *
@@ -389,7 +447,7 @@ private:
      * Nodes Groups follow the format:
      *  id NAME 1 0 "No methods"  ""  "Comment" node1 node2 ... nodeM
      */
-    void writeGroups(const SystusModel&, std::ostream&);
+    void writeGroups(const SystusModel&, SystusSubcase&, std::ostream&);
     /**
      * Writes a Material Field in the ASC Material lines.
      * Output verifies the syntax " number value" where the number is
@@ -404,20 +462,23 @@ private:
      * Value here is an integer.
      */
     void writeMaterialField(const SMF key, const int value, int& nbfields, std::ostream& out) const ;
-    void writeMaterials(const SystusModel&, const ConfigurationParameters&, const int, std::ostream&);
-    void writeLoads(std::ostream&);
-    void writeLists(std::ostream&);
+    void writeMaterials(const SystusModel&, const ConfigurationParameters&, const int, const SystusSubcase&, std::ostream&);
+    void writeLoads(SystusSubcase&, std::ostream&);
+    void writeLists(const SystusSubcase&, std::ostream&);
+    /**
+     * Writes the invariant tables, then the tables of the subcase, to the TABLE part of the ASC file.
+     */
+    void writeTables(const SystusSubcase&, std::ostream&);
     /**
-     * Writes the tables to the TABLE part of the ASC file.
+     * Writes the vectors of the subcase, then the coordinate system vectors, to the VECTORS part of the ASC file.
      */
-    void writeTables(std::ostream&);
-    void writeVectors(std::ostream&);
-    void writeDat(const SystusModel&, const ConfigurationParameters &, const int idSubcase, std::ostream&);
+    void writeVectors(const SystusSubcase&, std::ostream&);
+    void writeDat(const SystusModel&, const ConfigurationParameters &, const int idSubcase, SystusSubcase&, std::ostream&);
 
     void writeNodalDisplacementAssertion(Assertion& assertion, std::ostream& out);
     void writeNodalComplexDisplacementAssertion(Assertion& assertion, std::ostream& out);
     void writeFrequencyAssertion(Assertion& assertion, std::ostream& out);
-    void writeNodalForce(const SystusModel& systusModel, std::shared_ptr<NodalForce> nodalForce, const int idLoadCase, systus_ascid_t& vectorId);
+    void writeNodalForce(const SystusModel& systusModel, std::shared_ptr<NodalForce> nodalForce, const int idLoadCase, systus_ascid_t& vectorId, SystusSubcase& subcase);
 
     const std::string toString() const override {
         return std::string("SystusWriter");
@@ -427,8 +488,10 @@ private:
     /**
      * Write all matrix files to an ASC format. To be used by SYSTUS, these files must be converted to
      * a BINARY format (tool filematrix of the ESI Systus Package)
+     * Matrices do not depend on the subcase: the files are written once, and shared by all subcases.
+     * Each subcase converts them to its own binary files (see writeDat).
      */
-    void writeMatrixFiles(const SystusModel& systusModel, const int idSubcase);
+    void writeMatrixFiles(const SystusModel& systusModel);
 
 
 public:
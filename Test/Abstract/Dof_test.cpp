@@ -85,3 +85,42 @@ BOOST_AUTO_TEST_CASE( test_differentnodes ) {
 	BOOST_CHECK(is_equal(found, expected));
 	BOOST_CHECK(!matrix.isDiagonal());
 }
+
+BOOST_AUTO_TEST_CASE( test_block_matrix ) {
+	DOFBlockMatrix matrix(true);
+	matrix.addComponent(2, DOF::DX, 1, DOF::RY, 5.0);
+	matrix.addComponent(1, DOF::DY, 1, DOF::DX, 3.0);
+	matrix.addComponent(1, DOF::DY, 1, DOF::DX, 4.0);
+	BOOST_CHECK_EQUAL(2, matrix.size());
+	// symmetric components are stored in the upper part only
+	BOOST_CHECK(matrix.findBlock(2, 1) == nullptr);
+	const DOFBlock* block = matrix.findBlock(1, 2);
+	BOOST_REQUIRE(block != nullptr);
+	BOOST_CHECK(is_equal(block->findComponent(DOF::RY, DOF::DX), 5.0));
+	BOOST_CHECK(block->hasTranslations());
+	BOOST_CHECK(block->hasRotations());
+	// a later value replaces the previous one
+	BOOST_CHECK(is_equal(matrix.findBlock(1, 1)->findComponent(DOF::DX, DOF::DY), 4.0));
+	BOOST_CHECK(!matrix.findBlock(1, 1)->hasRotations());
+	int blockCount = 0;
+	matrix.forEachBlockOfNode(2, [&](const DOFBlock& nodeBlock) {
+		BOOST_CHECK_EQUAL(1, nodeBlock.rowNodePosition);
+		blockCount++;
+	});
+	BOOST_CHECK_EQUAL(1, blockCount);
+}
+
+BOOST_AUTO_TEST_CASE( test_block_matrix_partition ) {
+	// Nodes 1-4 and 2-3 are strongly coupled, 1-2 and 3-4 weakly
+	DOFBlockMatrix matrix(true);
+	matrix.addComponent(1, DOF::DX, 2, DOF::DX, 1.0);
+	matrix.addComponent(3, DOF::DX, 4, DOF::DX, 1.0);
+	for (const DOF& dof : { DOF::DX, DOF::DY, DOF::DZ }) {
+		matrix.addComponent(1, dof, 4, dof, 10.0);
+		matrix.addComponent(2, dof, 3, dof, 10.0);
+	}
+	const vector<vector<int>> partsByOrder = matrix.partitionNodesByOrder(2);
+	BOOST_CHECK(partsByOrder == vector<vector<int>>({ { 1, 2 }, { 4, 3 } }));
+	const vector<vector<int>> partsByCoupling = matrix.partitionNodesByCoupling(2);
+	BOOST_CHECK(partsByCoupling == vector<vector<int>>({ { 1, 4 }, { 2, 3 } }));
+}
@@ -5,8 +5,11 @@
 
 #define BOOST_TEST_MODULE mesh_test
 #include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include "build_properties.h"
 #include "../../Abstract/MeshComponents.h"
 #include "../../Abstract/Mesh.h"
+#include "../../Abstract/MeshStream.h"
 
 using namespace std;
 using namespace vega;
@@ -172,3 +175,140 @@ BOOST_AUTO_TEST_CASE( test_CellGroup2Families )
     BOOST_CHECK(famGMA1_GMA2_found);
 
 }
+
+BOOST_AUTO_TEST_CASE( test_reserved_dense_index )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    mesh.reserveNodes(3, 101, 103);
+    map<CellType::Code, int> cellCountByType = { { CellType::Code::SEG2_CODE, 2 } };
+    mesh.reserveCells(cellCountByType, 1, 2);
+    mesh.addNode(101, 0., 0., 0.);
+    mesh.addNode(103, 1., 0., 0.);
+    // Outside the reserved range
+    mesh.addNode(5000, 2., 0., 0.);
+    mesh.addCell(1, CellType::SEG2, { 101, 102 });
+    mesh.addCell(7, CellType::SEG2, { 103, 5000 });
+    BOOST_CHECK_EQUAL(mesh.countNodes(), 4);
+    BOOST_CHECK_EQUAL(mesh.countCells(), 2);
+    BOOST_CHECK_EQUAL(mesh.findNodeId(mesh.findNodePosition(103)), 103);
+    BOOST_CHECK_EQUAL(mesh.findNodeId(mesh.findNodePosition(5000)), 5000);
+    BOOST_CHECK(mesh.findNodePosition(104) == Node::UNAVAILABLE_NODE);
+    BOOST_CHECK(mesh.hasCell(7));
+    BOOST_CHECK(!mesh.hasCell(2));
+    BOOST_CHECK_EQUAL(mesh.findCell(mesh.findCellPosition(1)).id, 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_CellGroup_nodePositions )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    shared_ptr<CellGroup> group = mesh.createCellGroup("GMA1");
+    mesh.addCell(1, CellType::TRI3, {1,2,3});
+    mesh.addCell(2, CellType::SEG2, {3,4});
+    group->addCellId(1);
+    BOOST_CHECK_EQUAL(group->nodePositions().size(), 3);
+    // Adding a cell to the group must update the positions
+    group->addCellId(2);
+    BOOST_CHECK_EQUAL(group->nodePositions().size(), 4);
+    BOOST_CHECK(group->nodePositions().find(mesh.findNodePosition(4)) != group->nodePositions().end());
+    // Updating a cell of the mesh too
+    mesh.updateCell(2, CellType::SEG2, {3,5});
+    BOOST_CHECK(group->nodePositions().find(mesh.findNodePosition(4)) == group->nodePositions().end());
+    BOOST_CHECK(group->nodePositions().find(mesh.findNodePosition(5)) != group->nodePositions().end());
+}
+
+BOOST_AUTO_TEST_CASE( test_addCells )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    mesh.addNode(1, 0., 0., 0.);
+    mesh.addNode(2, 1., 0., 0.);
+    mesh.addNode(3, 2., 0., 0.);
+    const int p1 = mesh.findNodePosition(1);
+    const int p2 = mesh.findNodePosition(2);
+    const int p3 = mesh.findNodePosition(3);
+    const vector<int>& cellIds = mesh.addCells(CellType::SEG2, {p1, p2, p1, p3}, true);
+    BOOST_CHECK_EQUAL(cellIds.size(), 2);
+    BOOST_CHECK_EQUAL(mesh.countCells(CellType::SEG2), 2);
+    const Cell& cell = mesh.findCell(mesh.findCellPosition(cellIds[1]));
+    BOOST_CHECK_EQUAL(cell.nodeIds[0], 1);
+    BOOST_CHECK_EQUAL(cell.nodeIds[1], 3);
+    BOOST_CHECK_THROW(mesh.addCells(CellType::SEG2, {p1, p2, p3}), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( test_visitCells )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    mesh.addCell(7, CellType::SEG2, {10, 11});
+    mesh.addCell(3, CellType::TRI3, {10, 11, 12});
+    mesh.addCell(5, CellType::SEG2, {12, 13});
+    vector<int> visitedIds;
+    vector<int> visitedNodeIds;
+    mesh.visitCells({3, 5, 7}, [&](int cellId, const CellType& type, const vector<int>& nodeIds) {
+        BOOST_CHECK_EQUAL(type.numNodes, nodeIds.size());
+        visitedIds.push_back(cellId);
+        visitedNodeIds.insert(visitedNodeIds.end(), nodeIds.begin(), nodeIds.end());
+    });
+    const vector<int> expectedIds = {3, 5, 7};
+    BOOST_CHECK_EQUAL_COLLECTIONS(visitedIds.begin(), visitedIds.end(), expectedIds.begin(), expectedIds.end());
+    const vector<int> expectedNodeIds = {10, 11, 12, 12, 13, 10, 11};
+    BOOST_CHECK_EQUAL_COLLECTIONS(visitedNodeIds.begin(), visitedNodeIds.end(), expectedNodeIds.begin(),
+            expectedNodeIds.end());
+    BOOST_CHECK_THROW(mesh.visitCells({4}, [](int, const CellType&, const vector<int>&) {}), logic_error);
+}
+
+BOOST_AUTO_TEST_CASE( test_contentHash )
+{
+    Mesh mesh(LogLevel::INFO, "test");
+    mesh.addCell(1, CellType::TRI3, {1, 2, 3});
+    const uint64_t hash = mesh.contentHash();
+    BOOST_CHECK_EQUAL(mesh.contentHash(), hash);
+    // Groups are written in the MED file too
+    shared_ptr<CellGroup> group = mesh.createCellGroup("GMA1");
+    group->addCellId(1);
+    const uint64_t groupHash = mesh.contentHash();
+    BOOST_CHECK_NE(groupHash, hash);
+    mesh.addNode(4, 1., 0., 0.);
+    BOOST_CHECK_NE(mesh.contentHash(), groupHash);
+
+    // Same cells of each type and same group positions, but the group holds another cell type:
+    // the MED families differ
+    Mesh triFirst(LogLevel::INFO, "test");
+    triFirst.addCell(1, CellType::TRI3, {1, 2, 3});
+    triFirst.addCell(2, CellType::QUAD4, {1, 2, 3, 4});
+    triFirst.createCellGroup("GMA1")->addCellId(1);
+    Mesh quadFirst(LogLevel::INFO, "test");
+    quadFirst.addCell(1, CellType::QUAD4, {1, 2, 3, 4});
+    quadFirst.addCell(2, CellType::TRI3, {1, 2, 3});
+    quadFirst.createCellGroup("GMA1")->addCellId(1);
+    BOOST_CHECK_NE(triFirst.contentHash(), quadFirst.contentHash());
+}
+
+BOOST_AUTO_TEST_CASE( test_mesh_stream )
+{
+    const string medFileName = boost::filesystem::path(PROJECT_BINARY_DIR "/bin/mesh_stream.med").make_preferred().string();
+    Mesh mesh(LogLevel::INFO, "test");
+    shared_ptr<CellGroup> group = mesh.createCellGroup("GMA1");
+    const int cpPos = mesh.findOrReserveCoordinateSystem(5);
+    {
+        // Node 3 is announced twice
+        MeshStream meshStream(medFileName, "test", {3, 1, 2, 3, 4});
+        BOOST_CHECK_EQUAL(meshStream.countNodes(), 4);
+        meshStream.addNode(3, 0., 0., 0.);
+        // Skips node 1, left at the origin
+        meshStream.addNode(2, 1., 0., 0.);
+        BOOST_CHECK_THROW(meshStream.addNode(3, 1., 1., 0.), invalid_argument);
+        BOOST_CHECK_THROW(meshStream.addNode(5, 1., 1., 0.), invalid_argument);
+        meshStream.addNode(4, 1., 0., 0., cpPos);
+        meshStream.addCell(CellType::TRI3, {1, 2, 3}, group);
+        meshStream.addCell(CellType::SEG2, {3, 4}, nullptr);
+        BOOST_CHECK_THROW(meshStream.addCell(CellType::SEG2, {3, 5}, nullptr), invalid_argument);
+        BOOST_CHECK_EQUAL(meshStream.countCells(), 2);
+        BOOST_CHECK(boost::filesystem::exists(medFileName + ".203.tmp"));
+        // The local nodes are written in their coordinate system, built at close()
+        mesh.add(CartesianCoordinateSystem(mesh, VectorialValue(0., 0., 1.), VectorialValue::X,
+                VectorialValue::Y, CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, 5));
+        meshStream.close(mesh);
+    }
+    BOOST_CHECK(boost::filesystem::exists(medFileName));
+    BOOST_CHECK(!boost::filesystem::exists(medFileName + ".203.tmp"));
+    BOOST_CHECK(!boost::filesystem::exists(medFileName + ".102.tmp"));
+}
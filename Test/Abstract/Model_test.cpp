@@ -11,9 +11,12 @@
 #include "build_properties.h"
 #include "../../Abstract/ConfigurationParameters.h"
 #include "../../Abstract/Model.h"
+#include "../../Abstract/ModelPass.h"
 #include "Model_test.h"
+#include <algorithm>
 #include <cstddef>
 #include <new>
+#include <sstream>
 #include <string>
 #include <vector>
 #if defined VDEBUG && defined __GNUC__  && !defined(_WIN32)
@@ -26,6 +29,14 @@
 using namespace std;
 using namespace vega;
 
+// The writes of the passes are checked against their declarations whatever the build type
+struct CheckModelPassWrites {
+    CheckModelPassWrites() {
+        ModelPassManager::setWritesChecked(true);
+    }
+};
+BOOST_GLOBAL_FIXTURE(CheckModelPassWrites);
+
 // BOOST_AUTO_TEST_CASE( test_node_pass_valgrind ) {
 // //valgrind bug http://stackoverflow.com/questions/18776380
 // Node node2(1, 0.0, 0.0, 0.0, 10, false);
@@ -136,6 +147,10 @@ BOOST_AUTO_TEST_CASE( test_Elements ) {
 	BOOST_CHECK(model.validate());
 	const vector<shared_ptr<ElementSet>> beams = model.elementSets.filter(ElementSet::Type::RECTANGULAR_SECTION_BEAM);
 	BOOST_CHECK_EQUAL(static_cast<size_t>(1), beams.size());
+	const auto& rectangularBeams = model.elementSets.filter<ElementSet::Type::RECTANGULAR_SECTION_BEAM>();
+	BOOST_CHECK_EQUAL(static_cast<size_t>(1), rectangularBeams.size());
+	BOOST_CHECK_EQUAL(beams[0]->getId(), rectangularBeams[0].get().getId());
+	BOOST_CHECK_CLOSE(rectangularBeams[0].get().width, 100.0, 1e-10);
 
 //no virtual elements
 
@@ -223,10 +238,14 @@ shared_ptr<Model> createModelWith1HEXA8() {
      const Node& node53 = model->mesh->findNode(model->mesh->findNodePosition(53));
      BOOST_CHECK(node53.dofs == DOFS::ALL_DOFS);
 
-     BOOST_CHECK_EQUAL(2, model->constraintSets.size());
-     //auto cset = model->constraintSets.next();
-     //auto& spcs = cset->getConstraintsByType(Constraint::Type::SPC);
-     //BOOST_CHECK_EQUAL(5, spcs.size());
+     // Extra DOFS are blocked by one SPC for each combination of DOFS (RY+RZ on 51, RY on 53)
+     BOOST_CHECK_EQUAL(1, model->constraintSets.size());
+     auto cset = *model->constraintSets.begin();
+     const auto& spcs = cset->getConstraintsByType(Constraint::Type::SPC);
+     BOOST_CHECK_EQUAL(2, spcs.size());
+     for (const auto& spc : spcs) {
+         BOOST_CHECK_EQUAL(1, spc->nodePositions().size());
+     }
  }
 
 
@@ -302,7 +321,7 @@ BOOST_AUTO_TEST_CASE(test_Analysis) {
 		if (ls != nullptr)
 			cout << "Found loadset:" << *ls << endl;
 	}
-	BOOST_CHECK(!analysis.validate());
+	BOOST_CHECK(!analysis.validate(cout));
 	BOOST_CHECK(!model.validate());
 
 	set<shared_ptr<Loading>> loadings = model.getLoadingsByLoadSet(loadSet1);
@@ -364,6 +383,8 @@ BOOST_AUTO_TEST_CASE( combined_loadset1 ) {
 	NodalForce force2 = NodalForce(model, 1, 2.0);
 	model.add(force2);
 	model.addLoadingIntoLoadSet(force2, loadSet3);
+	BOOST_CHECK_EQUAL(loadSet1.getLoadingsByType<Loading::Type::NODAL_FORCE>().size(), static_cast<size_t>(2));
+	BOOST_CHECK(loadSet1.getLoadingsByType<Loading::Type::GRAVITY>().empty());
 	LoadSet combination(model, LoadSet::Type::LOAD, 10);
 	combination.embedded_loadsets.push_back(
 			pair<Reference<LoadSet>, double>(loadSet1.getReference(), 5.0));
@@ -477,7 +498,7 @@ BOOST_AUTO_TEST_CASE(test_ineffective_assertions_removed) {
 	model->add(analysis);
 	BOOST_CHECK_EQUAL(2, model->objectives.size());
 	model->finish();
-	BOOST_CHECK(analysis.validate());
+	BOOST_CHECK(analysis.validate(cout));
 	BOOST_CHECK(model->validate());
 	BOOST_CHECK_EQUAL(model->analyses.size(), 1);
 	BOOST_CHECK_EQUAL(model->objectives.size(), 1);
@@ -504,7 +525,7 @@ BOOST_AUTO_TEST_CASE(test_rbe3_assertions_not_removed) {
 	model.add(analysis);
 	BOOST_CHECK_EQUAL(2, model.objectives.size());
 	model.finish();
-	BOOST_CHECK(analysis.validate());
+	BOOST_CHECK(analysis.validate(cout));
 	BOOST_CHECK(model.validate());
 	BOOST_CHECK_EQUAL(model.analyses.size(), 1);
 	BOOST_CHECK_EQUAL(model.objectives.size(), 2);
@@ -512,6 +533,20 @@ BOOST_AUTO_TEST_CASE(test_rbe3_assertions_not_removed) {
 	BOOST_CHECK_EQUAL(assertions.size(), static_cast<size_t>(2));
 }
 
+BOOST_AUTO_TEST_CASE(test_spc_node_intervals) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	SinglePointConstraint spc(*model, DOFS::ALL_DOFS, 0.0);
+	IntervalList nodeIds;
+	nodeIds.addRange(50, 56, 2);
+	spc.addNodeIds(nodeIds);
+	spc.addNodeId(51);
+	BOOST_CHECK_EQUAL(spc.nodePositions().size(), static_cast<size_t>(5));
+	BOOST_CHECK_EQUAL(spc.nodePositions().count(model->mesh->findNodePosition(54)), static_cast<size_t>(1));
+	spc.removeNode(model->mesh->findNodePosition(54));
+	BOOST_CHECK_EQUAL(spc.nodePositions().size(), static_cast<size_t>(4));
+	BOOST_CHECK_EQUAL(spc.nodePositions().count(model->mesh->findNodePosition(54)), static_cast<size_t>(0));
+}
+
 BOOST_AUTO_TEST_CASE(test_spc_dof_remove) {
 	shared_ptr<Model> model = createModelWith1HEXA8();
 	LinearMecaStat analysis1(*model);
@@ -569,5 +604,154 @@ BOOST_AUTO_TEST_CASE( test_cdnoanalysis )
     BOOST_CHECK_EQUAL(model.analyses.size(), 0);
 
 }
+BOOST_AUTO_TEST_CASE( test_model_pass_manager )
+{
+    ModelPassManager passManager(LogLevel::INFO, false);
+    bool meshDone = false;
+    bool loadingsDone = false;
+    bool elementsAfterMesh = false;
+    bool disabledDone = false;
+    passManager.add(ModelPass("mesh", ModelPass::NONE, ModelPass::MESH, [&meshDone]() {
+        meshDone = true;
+    }));
+    passManager.add(ModelPass("disabled", ModelPass::NONE, ModelPass::ALL, [&disabledDone]() {
+        disabledDone = true;
+    }), false);
+    passManager.add(ModelPass("loadings", ModelPass::NONE, ModelPass::LOADINGS, [&loadingsDone]() {
+        loadingsDone = true;
+    }));
+    passManager.add(ModelPass("elements", ModelPass::MESH, ModelPass::ELEMENTS, [&meshDone, &elementsAfterMesh]() {
+        elementsAfterMesh = meshDone;
+    }));
+    // mesh and loadings are independent, elements reads what mesh writes
+    const auto stages = passManager.stages();
+    BOOST_REQUIRE_EQUAL(stages.size(), 2);
+    BOOST_CHECK_EQUAL(stages[0].size(), 2);
+    BOOST_CHECK_EQUAL(stages[1].size(), 1);
+    passManager.run();
+    BOOST_CHECK(meshDone);
+    BOOST_CHECK(loadingsDone);
+    BOOST_CHECK(elementsAfterMesh);
+    BOOST_CHECK(!disabledDone);
+    BOOST_REQUIRE_EQUAL(passManager.getDurations().size(), 3);
+    BOOST_CHECK_EQUAL(passManager.getDurations()[0].first, "mesh");
+    BOOST_CHECK_EQUAL(passManager.getDurations()[1].first, "loadings");
+    BOOST_CHECK_EQUAL(passManager.getDurations()[2].first, "elements");
+}
+
+BOOST_AUTO_TEST_CASE( test_model_pass_manager_writes )
+{
+    ModelPassManager passManager(LogLevel::INFO, false);
+    passManager.add(ModelPass("mesh", ModelPass::NONE, ModelPass::MESH, []() {
+        ModelPassManager::recordWrites(ModelPass::MESH);
+        ModelPassManager::out() << "mesh" << endl;
+    }));
+    passManager.add(ModelPass("loadings", ModelPass::NONE, ModelPass::LOADINGS, []() {
+        ModelPassManager::out() << "loadings" << endl;
+    }));
+    BOOST_CHECK_NO_THROW(passManager.run());
+    // Writes outside the declaration are rejected
+    ModelPassManager wrongPassManager(LogLevel::INFO, false);
+    wrongPassManager.add(ModelPass("loadings", ModelPass::NONE, ModelPass::LOADINGS, []() {
+        ModelPassManager::recordWrites(ModelPass::LOADINGS | ModelPass::CONSTRAINTS);
+    }));
+    BOOST_CHECK_THROW(wrongPassManager.run(), logic_error);
+    // Outside the passes, writes are not recorded and messages are not buffered
+    ModelPassManager::recordWrites(ModelPass::ALL);
+    BOOST_CHECK_EQUAL(&ModelPassManager::out(), &cout);
+}
+
+BOOST_AUTO_TEST_CASE( test_emulate_additional_mass_pass ) {
+    ModelConfiguration configuration;
+    configuration.emulateAdditionalMass = true;
+    Model model("inputfile", "10.3", SolverName::NASTRAN, configuration);
+    model.mesh->addNode(1, 0., 0., 0.);
+    model.mesh->addNode(2, 1., 0., 0.);
+    model.mesh->addNode(3, 0., 1., 0.);
+    model.mesh->addCell(1, CellType::TRI3, {1, 2, 3});
+    shared_ptr<CellGroup> cellGroup = model.mesh->createCellGroup("GM1");
+    cellGroup->addCellId(1);
+    Shell shell(model, 0.1, 2.0);
+    shell.assignCellGroup(cellGroup);
+    shell.assignMaterial(1);
+    model.add(shell);
+    model.getOrCreateMaterial(1)->addNature(ElasticNature(model, 1, 0));
+    // Its writes to the mesh, the elements and the materials are checked
+    BOOST_CHECK_NO_THROW(model.finish());
+    BOOST_CHECK_EQUAL(model.elementSets.size(), 2);
+    BOOST_CHECK(model.mesh->findGroup("VAM_1") != nullptr);
+    BOOST_CHECK_EQUAL(model.mesh->countCells(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( test_model_pass_manager_incremental ) {
+    ModelPassManager passManager(LogLevel::INFO, false);
+    int meshRuns = 0;
+    int elementsRuns = 0;
+    int loadingsRuns = 0;
+    passManager.add(ModelPass("mesh", ModelPass::NONE, ModelPass::MESH, [&meshRuns]() {
+        meshRuns++;
+    }));
+    passManager.add(ModelPass("elements", ModelPass::MESH, ModelPass::ELEMENTS, [&elementsRuns]() {
+        elementsRuns++;
+    }, true));
+    passManager.add(ModelPass("loadings", ModelPass::NONE, ModelPass::LOADINGS, [&loadingsRuns]() {
+        loadingsRuns++;
+    }, true));
+    passManager.run();
+    // a mesh change reruns elements, but the mesh pass can't be run twice
+    const auto skipped = passManager.runIncremental(ModelPass::MESH);
+    BOOST_CHECK_EQUAL(meshRuns, 1);
+    BOOST_CHECK_EQUAL(elementsRuns, 2);
+    BOOST_CHECK_EQUAL(loadingsRuns, 1);
+    BOOST_REQUIRE_EQUAL(skipped.size(), 1);
+    BOOST_CHECK_EQUAL(skipped[0], "mesh");
+    BOOST_CHECK(passManager.runIncremental(ModelPass::NONE).empty());
+    BOOST_CHECK_EQUAL(elementsRuns, 2);
+}
+
+BOOST_AUTO_TEST_CASE( test_incremental_finish ) {
+    ModelConfiguration configuration;
+    configuration.removeIneffectives = true;
+    Model model("inputfile", "10.3", SolverName::NASTRAN, configuration);
+    model.mesh->addNode(1, 0.0, 0.0, 0.0);
+    model.mesh->addNode(2, 1.0, 0.0, 0.0);
+    model.mesh->addCell(1, CellType::SEG2, {1, 2});
+    LoadSet loadSet1(model, LoadSet::Type::LOAD, 1);
+    model.add(loadSet1);
+    NodalForce force1(model, 1.0);
+    model.add(force1);
+    model.addLoadingIntoLoadSet(force1, loadSet1);
+    model.finish();
+    BOOST_CHECK_EQUAL(model.loadings.size(), 1);
+    // a null force added after finish is removed by the next finish
+    NodalForce force2(model, 0.0);
+    model.add(force2);
+    model.addLoadingIntoLoadSet(force2, loadSet1);
+    BOOST_CHECK_EQUAL(model.loadings.size(), 2);
+    model.finish();
+    BOOST_CHECK_EQUAL(model.loadings.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_validate_many_loadings ) {
+    Model model("inputfile", "10.3", SolverName::NASTRAN);
+    model.mesh->addNode(1, 0.0, 0.0, 0.0);
+    for (int i = 1; i <= 20000; i++) {
+        // one force out of a thousand refers to a missing coordinate system
+        NodalForce force(model, 1.0, 0, 0, 0, 0, 0, i, i % 1000 == 0 ? 42 : CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
+        force.addNodeId(1);
+        model.add(force);
+    }
+    ostringstream diagnostics;
+    BOOST_CHECK(!model.loadings.validate(diagnostics));
+    BOOST_CHECK_EQUAL(model.loadings.size(), 20000 - 20);
+    // each invalid force is reported once: its diagnostic, then the verdict
+    const string report = diagnostics.str();
+    BOOST_CHECK_EQUAL(count(report.begin(), report.end(), '\n'), 2 * 20);
+    BOOST_CHECK(report.find("Coordinate system id:42") < report.find(" is not valid"));
+    diagnostics.str("");
+    BOOST_CHECK(model.loadings.validate(diagnostics));
+    BOOST_CHECK(diagnostics.str().empty());
+}
+
 //____________________________________________________________________________//
 
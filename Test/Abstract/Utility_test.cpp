@@ -6,7 +6,12 @@
 #define BOOST_TEST_MODULE utility_tests
 #include "build_properties.h"
 #include "../../Abstract/Utility.h"
+#include "../../Abstract/OutputBuffer.h"
+#include "../../Abstract/OutputManifest.h"
+#include <fstream>
 #include <boost/test/unit_test.hpp>
+#include <limits>
+#include <sstream>
 
 using namespace std;
 using namespace vega;
@@ -15,3 +20,153 @@ BOOST_AUTO_TEST_CASE( test_backtrace ) {
 	stacktrace(); // Only to check if this works
 	BOOST_CHECK(true);
 }
+
+BOOST_AUTO_TEST_CASE( test_interval_list ) {
+	IntervalList intervals;
+	intervals.push_back(3);
+	intervals.addRange(4, 5000000);
+	intervals.addRange(10, 20, 4);
+	intervals.push_back(7);
+	// Contiguous values are merged into a single interval
+	BOOST_CHECK_EQUAL(intervals.getIntervals().size(), 3);
+	BOOST_CHECK_EQUAL(intervals.size(), 5000000 - 3 + 1 + 3 + 1);
+	BOOST_CHECK_EQUAL(intervals.front(), 3);
+	BOOST_CHECK_EQUAL(intervals.back(), 7);
+	intervals.pop_back();
+	// The end of the last interval is adjusted to the step
+	BOOST_CHECK_EQUAL(intervals.back(), 18);
+	vector<int> tail;
+	auto it = intervals.begin();
+	advance(it, 5000000 - 3 + 1);
+	tail.insert(tail.end(), it, intervals.end());
+	vector<int> expected = { 10, 14, 18 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(tail.begin(), tail.end(), expected.begin(), expected.end());
+	BOOST_CHECK_THROW(intervals.addRange(1, 2, 0), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( test_parallel_chunks ) {
+	const size_t count = 100000;
+	const vector<vector<size_t>> multiplesByChunk = parallelChunks<vector<size_t>>(count,
+			[](size_t begin, size_t end) {
+		vector<size_t> multiples;
+		for (size_t i = begin; i < end; i++) {
+			if (i % 7 == 0) {
+				multiples.push_back(i);
+			}
+		}
+		return multiples;
+	}, 1000);
+	// Chunks results come in order
+	vector<size_t> multiples;
+	for (const auto& chunkMultiples : multiplesByChunk) {
+		multiples.insert(multiples.end(), chunkMultiples.begin(), chunkMultiples.end());
+	}
+	BOOST_REQUIRE_EQUAL(multiples.size(), (count + 6) / 7);
+	for (size_t i = 0; i < multiples.size(); i++) {
+		BOOST_CHECK_EQUAL(multiples[i], 7 * i);
+	}
+	BOOST_CHECK_THROW(parallelChunks<int>(count, [](size_t begin, size_t) -> int {
+		if (begin == 0) {
+			throw invalid_argument("first chunk");
+		}
+		return 0;
+	}, 1000), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( test_symbol_table ) {
+	SymbolTable symbols;
+	const Symbol pshell = symbols.intern("PSHELL_123");
+	const Symbol rbe2 = symbols.intern("RBE2_9");
+	BOOST_CHECK(pshell == symbols.intern(string("PSHELL_") + "123"));
+	BOOST_CHECK(pshell != rbe2);
+	BOOST_CHECK_EQUAL(pshell.str(), "PSHELL_123");
+	BOOST_CHECK_EQUAL(symbols.size(), 2);
+	// Alphabetical order
+	BOOST_CHECK(pshell < rbe2);
+	BOOST_CHECK(!(rbe2 < pshell));
+	BOOST_CHECK(!(pshell < pshell));
+	// find does not intern
+	BOOST_CHECK(symbols.find("RBE2_9") == rbe2);
+	BOOST_CHECK(symbols.find("SPC1_45").empty());
+	BOOST_CHECK_EQUAL(symbols.size(), 2);
+	BOOST_CHECK(symbols.intern("") == Symbol());
+}
+
+BOOST_AUTO_TEST_CASE( test_output_buffer ) {
+	// Same text as the iostream operators, at the default and at the .comm precision
+	const vector<double> values = { 0.0, -0.0, 1.0, -42.0, 0.1, 1.0 / 3.0, 123456.0, 1234567.0,
+			1e15, -2.5e-7, 1e300, numeric_limits<double>::min() };
+	for (int precision : { 6, 15 }) {
+		ostringstream expected;
+		expected.precision(precision);
+		OutputBuffer buffer(expected);
+		for (double value : values) {
+			buffer << value << ' ';
+		}
+		const string text = buffer.str();
+		buffer.clear();
+		for (double value : values) {
+			expected << value << ' ';
+		}
+		BOOST_CHECK_EQUAL(text, expected.str());
+	}
+	OutputBuffer integers;
+	integers << 0 << ' ' << -17 << ' ' << numeric_limits<int>::min() << ' ' << 4000000000UL;
+	integers.field(-42, 6).field(7, 3).zeroPadded(5, 2).zeroPadded(10, 2);
+	BOOST_CHECK_EQUAL(integers.str(), "0 -17 -2147483648 4000000000   -42  70510");
+	// Nastran reals always have a decimal point, and give back the same double when they fit
+	OutputBuffer reals;
+	reals.nastranReal(0.0, 8).nastranReal(-3.0, 8).nastranReal(0.32, 8).nastranReal(1.15e7, 8);
+	BOOST_CHECK_EQUAL(reals.str(), "      0.     -3.    0.32  1.15e7");
+	reals.clear();
+	reals.nastranReal(1.0 / 3.0, 8).nastranReal(-5.43e-5, 8).nastranReal(123456789.0, 8);
+	BOOST_CHECK_EQUAL(reals.str(), ".3333333-5.43e-51.2346e8");
+	reals.clear();
+	reals.nastranReal(1.0 / 3.0, 16).nastranReal(2.1e11, 16);
+	BOOST_CHECK_EQUAL(reals.str(), ".333333333333333   210000000000.");
+	for (double value : { 1.0 / 3.0, 0.1 + 0.2, -1.23456789012345e-300, 1e22, 6.02214076e23 }) {
+		OutputBuffer free;
+		free.nastranReal(value, 0);
+		BOOST_CHECK_EQUAL(strtod(free.str().c_str(), nullptr), value);
+		BOOST_CHECK_LE(free.str().size(), 24);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_output_manifest ) {
+	// The hash only depends on the data, and its order
+	BOOST_CHECK_EQUAL(ContentHash().add(1).add(2.5).add(string("a")).getValue(),
+			ContentHash().add(1).add(2.5).add(string("a")).getValue());
+	BOOST_CHECK_NE(ContentHash().add(1).add(2).getValue(), ContentHash().add(2).add(1).getValue());
+	BOOST_CHECK_NE(ContentHash().add(string("ab")).add(string("c")).getValue(),
+			ContentHash().add(string("a")).add(string("bc")).getValue());
+	// A text written to a ContentHashBuffer is hashed as its characters
+	ContentHash streamHash;
+	ContentHashBuffer hashBuffer(streamHash);
+	ostream hashStream(&hashBuffer);
+	hashStream << "BEGIN_NODES " << 12 << '\n' << 0.5;
+	const string text("BEGIN_NODES 12\n0.5");
+	BOOST_CHECK_EQUAL(streamHash.getValue(), ContentHash().addCharacters(text.data(), text.size()).getValue());
+
+	const boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+			/ boost::filesystem::unique_path();
+	boost::filesystem::create_directories(directory);
+	const boost::filesystem::path file = directory / "mesh file.med";
+	ofstream(file.string()) << "mesh";
+	{
+		OutputManifest manifest(directory / "test.manifest");
+		BOOST_CHECK(!manifest.isUnchanged(file, 42));
+		manifest.update(file, 42);
+		manifest.save();
+	}
+	OutputManifest manifest(directory / "test.manifest");
+	BOOST_CHECK(manifest.isUnchanged(file, 42));
+	BOOST_CHECK(!manifest.isUnchanged(file, 43));
+	// A file modified since it was written must be written again
+	ofstream(file.string(), ios::app) << " modified";
+	BOOST_CHECK(!manifest.isUnchanged(file, 42));
+	// Only the hash and the size are compared: a file rewritten identically is unchanged
+	manifest.update(file, 42);
+	ofstream(file.string(), ios::trunc) << "mesh modified";
+	BOOST_CHECK(manifest.isUnchanged(file, 42));
+	boost::filesystem::remove_all(directory);
+}
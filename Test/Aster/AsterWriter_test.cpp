@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * AsterWriter_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#define BOOST_TEST_MODULE aster_writer_tests
+#include "../../Aster/AsterWriter.h"
+#include "build_properties.h"
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace vega;
+
+namespace {
+
+ConfigurationParameters listConfiguration(const string& outputPath, size_t maxInlineListSize) {
+	return ConfigurationParameters("plate", Solver(SolverName::CODE_ASTER), "", "plate", outputPath,
+			LogLevel::INFO, ConfigurationParameters::TranslationMode::BEST_EFFORT, fs::path(), 0.02, false,
+			"", "", "lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct", "order", false,
+			"short", false, false, maxInlineListSize);
+}
+
+/**
+ * 3x3 plate of QUAD4 shells, clamped on its 4 first nodes.
+ */
+shared_ptr<Model> createPlate(const ConfigurationParameters& configuration) {
+	shared_ptr<Model> model = make_shared<Model>("plate", "UNKNOWN", SolverName::NASTRAN,
+			configuration.getModelConfiguration());
+	const int side = 4;
+	for (int j = 0; j < side; j++) {
+		for (int i = 0; i < side; i++) {
+			model->mesh->addNode(j * side + i + 1, 0.01 * i, 0.01 * j, 0.0);
+		}
+	}
+	shared_ptr<CellGroup> shells = model->mesh->createCellGroup("SHELLS");
+	int cellId = 1;
+	for (int j = 0; j < side - 1; j++) {
+		for (int i = 0; i < side - 1; i++) {
+			const int first = j * side + i + 1;
+			model->mesh->addCell(cellId, CellType::QUAD4, {first, first + 1, first + side + 1, first + side});
+			shells->addCellId(cellId);
+			cellId++;
+		}
+	}
+	Shell shell(*model, 0.001);
+	shell.assignCellGroup(shells);
+	shell.assignMaterial(1);
+	model->add(shell);
+	model->getOrCreateMaterial(1)->addNature(ElasticNature(*model, 2.1e11, 0.3));
+
+	SinglePointConstraint spc(*model, DOFS::ALL_DOFS, 0.0);
+	for (int i = 0; i < side; i++) {
+		spc.addNodeId(i + 1);
+	}
+	model->add(spc);
+	ConstraintSet spcSet(*model, ConstraintSet::Type::SPC, 1);
+	model->add(spcSet);
+	model->addConstraintIntoConstraintSet(spc, spcSet);
+	LinearMecaStat analysis(*model);
+	analysis.add(spcSet);
+	model->add(analysis);
+	model->finish();
+	return model;
+}
+
+string readFile(const string& path) {
+	ifstream in(path);
+	ostringstream content;
+	content << in.rdbuf();
+	return content.str();
+}
+
+vector<string> listGroupNames(const Mesh& mesh) {
+	vector<string> names;
+	for (const auto& nodeGroup : mesh.getNodeGroups()) {
+		if (nodeGroup->getName().compare(0, 2, "LS") == 0) {
+			names.push_back(nodeGroup->getName());
+		}
+	}
+	return names;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_inline_list_threshold ) {
+	const string outputPath = fs::path(PROJECT_BINARY_DIR "/bin/aster_lists_inline").make_preferred().string();
+	fs::create_directories(outputPath);
+	const ConfigurationParameters configuration = listConfiguration(outputPath, 4);
+	shared_ptr<Model> model = createPlate(configuration);
+	aster::AsterWriter writer;
+	writer.writeModel(model, configuration);
+
+	// The 4 clamped nodes are not more than the threshold: they stay inline
+	const string comm = readFile((fs::path(outputPath) / "plate.comm").string());
+	BOOST_CHECK(comm.find("NOEUD=(") != string::npos);
+	BOOST_CHECK(comm.find("GROUP_NO='LS") == string::npos);
+	BOOST_CHECK(listGroupNames(*model->mesh).empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_list_groups_written_twice ) {
+	const string outputPath = fs::path(PROJECT_BINARY_DIR "/bin/aster_lists_groups").make_preferred().string();
+	fs::create_directories(outputPath);
+	const ConfigurationParameters configuration = listConfiguration(outputPath, 3);
+	shared_ptr<Model> model = createPlate(configuration);
+	aster::AsterWriter writer;
+	writer.writeModel(model, configuration);
+
+	const string commPath = (fs::path(outputPath) / "plate.comm").string();
+	const string comm = readFile(commPath);
+	BOOST_CHECK(comm.find("GROUP_NO='LS1'") != string::npos);
+	const vector<string> names = listGroupNames(*model->mesh);
+	BOOST_REQUIRE_EQUAL(names.size(), 1);
+	BOOST_CHECK_LE(names[0].size(), 8);
+	BOOST_CHECK_EQUAL(model->mesh->findGroup(names[0])->nodePositions().size(), 4);
+
+	// A second writing reuses the group of the first one
+	const size_t groupCount = model->mesh->getNodeGroups().size();
+	aster::AsterWriter secondWriter;
+	secondWriter.writeModel(model, configuration);
+	BOOST_CHECK_EQUAL(model->mesh->getNodeGroups().size(), groupCount);
+	BOOST_CHECK_EQUAL(readFile(commPath), comm);
+}
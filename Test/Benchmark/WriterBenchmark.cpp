@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * WriterBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ *
+ * Times the writing of a large shell mesh (20 million cells by default) to each output format,
+ * then the writing of its MED file alone, giving its size. With "med", only the MED file is
+ * written, which needs less memory.
+ * Usage: WriterBenchmark [cellCount] [outputPath] [analysisCount] [med]
+ */
+
+#include "../../Abstract/ConfigurationParameters.h"
+#include "../../Abstract/Model.h"
+#include "../../Aster/AsterWriter.h"
+#include "../../Nastran/NastranWriter.h"
+#include "../../Systus/SystusWriter.h"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace vega;
+
+namespace {
+
+/**
+ * Square plate of QUAD4 shells, clamped on one side. Each static analysis loads another node of
+ * the opposite side.
+ */
+shared_ptr<Model> createPlate(int side, int analysisCount, const ConfigurationParameters& configuration) {
+	shared_ptr<Model> model = make_shared<Model>("plate", "UNKNOWN", SolverName::NASTRAN,
+			configuration.getModelConfiguration());
+	for (int j = 0; j < side; j++) {
+		for (int i = 0; i < side; i++) {
+			model->mesh->addNode(j * side + i + 1, 0.01 * i, 0.01 * j, 0.0);
+		}
+	}
+	shared_ptr<CellGroup> shells = model->mesh->createCellGroup("SHELLS");
+	int cellId = 1;
+	for (int j = 0; j < side - 1; j++) {
+		for (int i = 0; i < side - 1; i++) {
+			const int first = j * side + i + 1;
+			model->mesh->addCell(cellId, CellType::QUAD4, {first, first + 1, first + side + 1, first + side});
+			shells->addCellId(cellId);
+			cellId++;
+		}
+	}
+	Shell shell(*model, 0.001);
+	shell.assignCellGroup(shells);
+	shell.assignMaterial(1);
+	model->add(shell);
+	model->getOrCreateMaterial(1)->addNature(ElasticNature(*model, 2.1e11, 0.3));
+
+	SinglePointConstraint spc(*model, DOFS::ALL_DOFS, 0.0);
+	for (int j = 0; j < side; j++) {
+		spc.addNodeId(j * side + 1);
+	}
+	model->add(spc);
+
+	for (int i = 0; i < analysisCount; i++) {
+		// Distinct constraint sets, so that Systus does not merge the analyses in one subcase
+		ConstraintSet spcSet(*model, ConstraintSet::Type::SPC, i + 1);
+		model->add(spcSet);
+		model->addConstraintIntoConstraintSet(spc, spcSet);
+
+		LoadSet loadSet(*model, LoadSet::Type::LOAD, i + 1);
+		NodalForce force(*model, 0.0, 0.0, -1000.0);
+		force.addNodeId(side * side - i % side);
+		model->add(force);
+		model->addLoadingIntoLoadSet(force, loadSet);
+
+		LinearMecaStat analysis(*model);
+		analysis.add(spcSet);
+		analysis.add(loadSet);
+		model->add(analysis);
+	}
+	return model;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	const long cellCount = argc > 1 ? stol(argv[1]) : 20000000L;
+	const string outputPath = argc > 2 ? argv[2] : ".";
+	const int analysisCount = argc > 3 ? stoi(argv[3]) : 1;
+	const bool medOnly = argc > 4 && string(argv[4]) == "med";
+	const int side = max(2, static_cast<int>(ceil(sqrt(static_cast<double>(cellCount)))) + 1);
+	const vector<pair<SolverName, shared_ptr<Writer>>> writers = {
+			{ SolverName::NASTRAN, make_shared<nastran::NastranWriter>() },
+			{ SolverName::SYSTUS, make_shared<systus::SystusWriter>() },
+			{ SolverName::CODE_ASTER, make_shared<aster::AsterWriter>() } };
+	for (const auto& solverWriter : writers) {
+		if (medOnly) {
+			break;
+		}
+		ConfigurationParameters configuration("plate", Solver(solverWriter.first), "", "plate", outputPath);
+		shared_ptr<Model> model = createPlate(side, analysisCount, configuration);
+		model->finish();
+		const auto start = chrono::steady_clock::now();
+		solverWriter.second->writeModel(model, configuration);
+		const auto end = chrono::steady_clock::now();
+		cout << Solver(solverWriter.first) << ": " << side * side << " nodes written in "
+				<< chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms" << endl;
+	}
+	{
+		ConfigurationParameters configuration("plate", Solver(SolverName::CODE_ASTER), "", "plate", outputPath);
+		shared_ptr<Model> model = createPlate(side, analysisCount, configuration);
+		model->finish();
+		const string medPath = (boost::filesystem::path(outputPath) / "plate_benchmark.med").string();
+		const auto start = chrono::steady_clock::now();
+		model->mesh->writeMED(*model, medPath.c_str());
+		const auto end = chrono::steady_clock::now();
+		cout << "MED: " << model->mesh->countCells() << " cells written in "
+				<< chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms, "
+				<< boost::filesystem::file_size(medPath) << " bytes" << endl;
+	}
+	return 0;
+}
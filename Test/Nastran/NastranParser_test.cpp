@@ -10,6 +10,7 @@
 
 #define BOOST_TEST_MODULE nastran_parser_tests
 #include "../../Nastran/NastranParser.h"
+#include "../../Nastran/NastranWriter.h"
 #include "build_properties.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
@@ -80,6 +81,29 @@ BOOST_AUTO_TEST_CASE( test_include ) {
 	//expected 1 material elastic
 }
 
+BOOST_AUTO_TEST_CASE( test_prescan_bulk_statistics ) {
+	string testLocation = fs::path(
+	PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/prescan.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	nastran::NastranParser::BulkStatistics statistics;
+	parser.prescanBULKSection(testLocation, statistics, false);
+	// Short, long, free and tab separated cards, half of the GRIDs being included
+	BOOST_CHECK_EQUAL(statistics.gridCount, 8);
+	BOOST_CHECK_EQUAL(statistics.minGridId, 1);
+	BOOST_CHECK_EQUAL(statistics.maxGridId, 8);
+	BOOST_CHECK_EQUAL(statistics.elementCount, 5);
+	BOOST_CHECK_EQUAL(statistics.minElementId, 10);
+	BOOST_CHECK_EQUAL(statistics.maxElementId, 20);
+	BOOST_CHECK_EQUAL(statistics.countByElementKeyword["CQUAD4"], 1);
+	BOOST_CHECK_EQUAL(statistics.countByElementKeyword["CTRIA3"], 3);
+	BOOST_CHECK_EQUAL(statistics.countByElementKeyword["CHEXA"], 1);
+	BOOST_CHECK_EQUAL(statistics.countByElementKeyword.size(), 3);
+	BOOST_CHECK_EQUAL(statistics.cellCountByType[CellType::Code::TRI3_CODE], 3);
+	BOOST_CHECK_EQUAL(statistics.cellCountByType[CellType::Code::HEXA8_CODE], 1);
+	// One THRU in the SPC1 of the main file, one in the SET3 of the included one
+	BOOST_CHECK_EQUAL(statistics.thruCount, 2);
+}
+
 BOOST_AUTO_TEST_CASE(test_comments_in_the_end) {
 	//a short version of Optistruct test, that fails in windows
 	string testLocation = fs::path(
@@ -118,3 +142,247 @@ BOOST_AUTO_TEST_CASE(nastran_github_issue15) {
 }
 
 //____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE(test_deferred_dmig) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/dmig.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, SolverName::CODE_ASTER, "", ""));
+		BOOST_CHECK_EQUAL(model->mesh->countNodes(), 2);
+		// Only KAAX is used: KOTHER cards are never decoded
+		BOOST_CHECK_EQUAL(model->elementSets.size(), 1);
+		shared_ptr<MatrixElement> matrix = dynamic_pointer_cast<MatrixElement>(*model->elementSets.begin());
+		BOOST_REQUIRE(matrix != nullptr);
+		BOOST_CHECK_EQUAL(matrix->nodePositions().size(), 2);
+		const DOFBlock* submatrix = matrix->getBlocks().findBlock(model->mesh->findNodePosition(1),
+				model->mesh->findNodePosition(1));
+		BOOST_REQUIRE(submatrix != nullptr);
+		BOOST_CHECK_CLOSE(submatrix->findComponent(DOF::DX, DOF::DX), 100., 1e-9);
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_deferred_mesh_at_least) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/dmig.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		// The used DMIG cards are parsed after the BULK section, read back from a single stream
+		const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, SolverName::CODE_ASTER, "", "", ".", LogLevel::INFO,
+					ConfigurationParameters::TranslationMode::MESH_AT_LEAST));
+		BOOST_CHECK_EQUAL(model->mesh->countNodes(), 2);
+		BOOST_CHECK_EQUAL(model->elementSets.size(), 1);
+		shared_ptr<MatrixElement> matrix = dynamic_pointer_cast<MatrixElement>(*model->elementSets.begin());
+		BOOST_REQUIRE(matrix != nullptr);
+		const DOFBlock* submatrix = matrix->getBlocks().findBlock(model->mesh->findNodePosition(2),
+				model->mesh->findNodePosition(2));
+		BOOST_REQUIRE(submatrix != nullptr);
+		BOOST_CHECK_CLOSE(submatrix->findComponent(DOF::DX, DOF::DX), 100., 1e-9);
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_mesh_at_least_error_keeps_cards) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/mesh_at_least.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, SolverName::CODE_ASTER, "", "", ".", LogLevel::INFO,
+					ConfigurationParameters::TranslationMode::MESH_AT_LEAST));
+		BOOST_CHECK_EQUAL(parser.diagnostics.count(ParsingDiagnostic::Severity::ERROR, "FOOBAR"), 1);
+		// The materials and the matrix, before and after the unknown card, are all parsed
+		BOOST_CHECK_EQUAL(model->mesh->countNodes(), 2);
+		BOOST_CHECK_EQUAL(model->materials.size(), 2);
+		BOOST_CHECK_EQUAL(model->elementSets.size(), 1);
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_mesh_only) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/mesh_at_least.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, Solver(SolverName::CODE_ASTER), "", "", ".",
+					LogLevel::INFO, ConfigurationParameters::TranslationMode::BEST_EFFORT, fs::path(), 0.02,
+					false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct",
+					"order", false, "short", false, false, 1000, false, true));
+		// Only the GRIDs are decoded: the matrix named by the case control stays empty
+		BOOST_CHECK_EQUAL(model->mesh->countNodes(), 2);
+		BOOST_CHECK_EQUAL(model->materials.size(), 0);
+		BOOST_REQUIRE_EQUAL(model->elementSets.size(), 1);
+		shared_ptr<MatrixElement> matrix = dynamic_pointer_cast<MatrixElement>(*model->elementSets.begin());
+		BOOST_REQUIRE(matrix != nullptr);
+		BOOST_CHECK(matrix->nodePositions().empty());
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_stream_mesh) {
+	const string outputPath = fs::path(PROJECT_BINARY_DIR "/bin").make_preferred().string();
+	auto meshOnlyConfiguration = [&outputPath](const string& testLocation) {
+		return ConfigurationParameters(testLocation, Solver(SolverName::CODE_ASTER), "", "", outputPath,
+				LogLevel::INFO, ConfigurationParameters::TranslationMode::BEST_EFFORT, fs::path(), 0.02,
+				false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct",
+				"order", false, "short", false, false, 1000, false, true);
+	};
+	nastran::NastranParser parser;
+	const string medFileName = (fs::path(outputPath) / "prescan_stream.med").string();
+	fs::remove(medFileName);
+	BOOST_CHECK(parser.streamMesh(meshOnlyConfiguration(
+			PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/prescan.dat"), medFileName));
+	BOOST_CHECK(fs::exists(medFileName));
+	BOOST_CHECK(parser.diagnostics.empty());
+	// CBUSH cards need the whole mesh to build their orientation
+	const string bushMedFileName = (fs::path(outputPath) / "bush_stream.med").string();
+	fs::remove(bushMedFileName);
+	BOOST_CHECK(!parser.streamMesh(meshOnlyConfiguration(
+			PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/bush.dat"), bushMedFileName));
+	BOOST_CHECK(!fs::exists(bushMedFileName));
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_finish_edited_model) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/nastran/alneos/test4a/test4a.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	// Removes the SPC1 on node 1, moves node 3 and adds an SPC on a new group holding it
+	auto edit = [](Model& model) {
+		const int nodePosition1 = model.mesh->findNodePosition(1);
+		vector<Reference<Constraint>> removed;
+		for (const auto& constraint : model.constraints) {
+			if (constraint->type == Constraint::Type::SPC and constraint->nodePositions().count(nodePosition1) > 0) {
+				removed.push_back(Reference<Constraint>(*constraint));
+			}
+		}
+		BOOST_REQUIRE_EQUAL(removed.size(), 1);
+		model.remove(removed[0]);
+		model.mesh->addNode(3, 1.0, 1.0, 0.5);
+		shared_ptr<NodeGroup> group = model.mesh->createNodeGroup("EDITED");
+		group->addNodeId(3);
+		SinglePointConstraint spc(model, DOFS::TRANSLATIONS, 0, group);
+		model.add(spc);
+		model.addConstraintIntoConstraintSet(spc, model.commonConstraintSet);
+	};
+	try {
+		const ConfigurationParameters configuration(testLocation, SolverName::CODE_ASTER, "", "");
+		const shared_ptr<Model> incremental = parser.parse(configuration);
+		incremental->finish();
+		edit(*incremental);
+		incremental->finish();
+		const shared_ptr<Model> full = parser.parse(configuration);
+		edit(*full);
+		full->finish();
+
+		BOOST_CHECK_EQUAL(incremental->constraints.size(), full->constraints.size());
+		BOOST_CHECK_EQUAL(incremental->loadings.size(), full->loadings.size());
+		BOOST_CHECK_EQUAL(incremental->mesh->countNodes(), full->mesh->countNodes());
+		BOOST_CHECK_EQUAL(incremental->mesh->countCells(), full->mesh->countCells());
+		const Node node3 = incremental->mesh->findNode(incremental->mesh->findNodePosition(3));
+		BOOST_CHECK_CLOSE(node3.z, 0.5, 1e-9);
+		BOOST_REQUIRE_EQUAL(incremental->analyses.size(), full->analyses.size());
+		auto fullAnalysis = full->analyses.begin();
+		for (const auto& analysis : incremental->analyses) {
+			map<int, char> boundaryDOFSById;
+			for (const auto& entry : analysis->getBoundaryDOFSByNodePosition()) {
+				boundaryDOFSById[incremental->mesh->findNodeId(entry.first)] = entry.second;
+			}
+			map<int, char> fullBoundaryDOFSById;
+			for (const auto& entry : (*fullAnalysis)->getBoundaryDOFSByNodePosition()) {
+				fullBoundaryDOFSById[full->mesh->findNodeId(entry.first)] = entry.second;
+			}
+			BOOST_CHECK(boundaryDOFSById == fullBoundaryDOFSById);
+			// The removed SPC1 no longer blocks node 1, the new SPC blocks node 3
+			BOOST_CHECK(boundaryDOFSById.find(1) == boundaryDOFSById.end());
+			BOOST_CHECK(boundaryDOFSById.find(3) != boundaryDOFSById.end());
+			++fullAnalysis;
+		}
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_write_read_formats) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/nastran/alneos/test4a/test4a.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, SolverName::NASTRAN, "", ""));
+		model->finish();
+		// Each layout of the fields must be read back as the model written
+		for (const string format : { "short", "large", "free" }) {
+			const string outputPath = fs::path(PROJECT_BINARY_DIR "/bin/formats_" + format).make_preferred().string();
+			fs::create_directories(outputPath);
+			const ConfigurationParameters configuration(testLocation, SolverName::NASTRAN, "", "vega",
+					outputPath, LogLevel::INFO, ConfigurationParameters::TranslationMode::BEST_EFFORT, "", 0.02,
+					false, "", "", "lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct", "order",
+					false, format);
+			nastran::NastranWriter writer;
+			const string datPath = writer.writeModel(model, configuration);
+			const shared_ptr<Model> written = parser.parse(
+				ConfigurationParameters(datPath, SolverName::NASTRAN, "", ""));
+			BOOST_TEST_CHECKPOINT("Format " + format);
+			BOOST_CHECK_EQUAL(written->mesh->countNodes(), model->mesh->countNodes());
+			BOOST_CHECK_EQUAL(written->mesh->countCells(), model->mesh->countCells());
+			// The writer only knows the SPC1 among the constraints of this model
+			BOOST_CHECK_EQUAL(written->constraints.size(), 3);
+			for (int nodeId = 1; nodeId <= 9; nodeId++) {
+				const Node node = model->mesh->findNode(model->mesh->findNodePosition(nodeId));
+				const Node writtenNode = written->mesh->findNode(written->mesh->findNodePosition(nodeId));
+				BOOST_CHECK_SMALL(writtenNode.x - node.x, 1e-12);
+				BOOST_CHECK_SMALL(writtenNode.y - node.y, 1e-12);
+				BOOST_CHECK_SMALL(writtenNode.z - node.z, 1e-12);
+			}
+			BOOST_REQUIRE_EQUAL(written->materials.size(), 1);
+			const auto elastic = dynamic_pointer_cast<ElasticNature>(
+					(*written->materials.begin())->findNature(Nature::NatureType::NATURE_ELASTIC));
+			BOOST_REQUIRE(elastic != nullptr);
+			BOOST_CHECK_CLOSE(elastic->getE(), 210000., 1e-9);
+			BOOST_CHECK_CLOSE(elastic->getNu(), 0.3, 1e-9);
+			BOOST_CHECK_CLOSE(elastic->getRho(), 7.85e-9, 1e-9);
+			// G is computed, only the digits fitting in the field are written
+			BOOST_CHECK_CLOSE(elastic->getG(), 210000. / 2.6, format == "free" ? 1e-9 : 1e-5);
+		}
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Write and parse threw exception ") + e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_diagnostics_best_effort) {
+	string testLocation = fs::path(
+		PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/diagnostics.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	try {
+		const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, SolverName::CODE_ASTER, "", ""));
+		// Faulty cards are dismissed, the others are parsed
+		BOOST_CHECK_EQUAL(model->mesh->countNodes(), 3);
+		BOOST_CHECK_EQUAL(parser.diagnostics.count(ParsingDiagnostic::Severity::ERROR), 3);
+		BOOST_CHECK_EQUAL(parser.diagnostics.count(ParsingDiagnostic::Severity::ERROR, "FOOBAR"), 2);
+		BOOST_CHECK_EQUAL(parser.diagnostics.count(ParsingDiagnostic::Severity::ERROR, "GRID"), 1);
+		for (const auto& diagnostic : parser.diagnostics.getDiagnostics()) {
+			if (diagnostic.keyword == "GRID") {
+				BOOST_CHECK_EQUAL(diagnostic.lineNumber, 9);
+				BOOST_CHECK_EQUAL(diagnostic.field, 3);
+			}
+		}
+	} catch (exception& e) {
+		cout << e.what() << endl;
+		BOOST_FAIL(string("Parse threw exception ") + e.what());
+	}
+}
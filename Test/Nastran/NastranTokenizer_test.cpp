@@ -317,7 +317,7 @@ BOOST_AUTO_TEST_CASE(nastran_THRU_symbol) {
     BOOST_CHECK(tokenizer.isNextInt());
     BOOST_CHECK_EQUAL(246, tokenizer.nextInt());
     BOOST_CHECK(tokenizer.isNextInt());
-    list<int> ids = tokenizer.nextInts();
+    IntervalList ids = tokenizer.nextInts();
     BOOST_CHECK_EQUAL(6, ids.size());
     BOOST_CHECK_EQUAL(2, ids.front());
     BOOST_CHECK_EQUAL(7, ids.back());
@@ -338,7 +338,7 @@ BOOST_AUTO_TEST_CASE(nastran_THRU_symbol_back) {
     BOOST_CHECK(tokenizer.isNextInt());
     BOOST_CHECK_EQUAL(246, tokenizer.nextInt());
     BOOST_CHECK(tokenizer.isNextInt());
-    list<int> ids = tokenizer.nextInts();
+    IntervalList ids = tokenizer.nextInts();
     BOOST_CHECK_EQUAL(6, ids.size());
     BOOST_CHECK_EQUAL(2, ids.front());
     BOOST_CHECK_EQUAL(7, ids.back());
@@ -360,7 +360,7 @@ BOOST_AUTO_TEST_CASE(nastran_THRU_BY_symbol) {
     BOOST_CHECK(tokenizer.isNextInt());
     BOOST_CHECK_EQUAL(246, tokenizer.nextInt());
     BOOST_CHECK(tokenizer.isNextInt());
-    list<int> ids = tokenizer.nextInts();
+    IntervalList ids = tokenizer.nextInts();
     BOOST_CHECK_EQUAL(4, ids.size());
     BOOST_CHECK_EQUAL(2, ids.front());
     BOOST_CHECK_EQUAL(7, ids.back());